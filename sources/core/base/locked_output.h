@@ -0,0 +1,32 @@
+#pragma once
+
+#include <mutex>
+#include <ostream>
+
+namespace hg {
+
+/** `LockedOutput` holds the lock shared by all instances until the end of the full expression, so lines printed from
+    worker threads don't interleave. All output that may happen on worker threads must go through it.
+
+    LockedOutput(std::cerr) << "[RESOURCE] Failed to read \"" << name << "\"." << std::endl; */
+class LockedOutput final {
+public:
+    explicit LockedOutput(std::ostream& stream);
+    LockedOutput(const LockedOutput& another) = delete;
+    LockedOutput& operator=(const LockedOutput& another) = delete;
+
+    template <typename T>
+    LockedOutput& operator<<(const T& value) {
+        m_stream << value;
+        return *this;
+    }
+
+    /** Allow manipulators like `std::endl`. */
+    LockedOutput& operator<<(std::ostream& (*manipulator)(std::ostream&));
+
+private:
+    std::lock_guard<std::mutex> m_guard;
+    std::ostream& m_stream;
+};
+
+} // namespace hg
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hg {
+
+/** `MemoryMappedFile` maps a whole file into memory for reading. Pages are loaded by the operating system on first
+    access, so opening a file is cheap regardless of its size. */
+class MemoryMappedFile final {
+public:
+    MemoryMappedFile() = default;
+    MemoryMappedFile(const MemoryMappedFile& another) = delete;
+    MemoryMappedFile(MemoryMappedFile&& another);
+    MemoryMappedFile& operator=(const MemoryMappedFile& another) = delete;
+    MemoryMappedFile& operator=(MemoryMappedFile&& another);
+    ~MemoryMappedFile();
+
+    /** Map the specified file. Return false if the file doesn't exist, is empty or can't be mapped. */
+    bool open(const std::string& path);
+
+    /** Unmap the file. */
+    void close();
+
+    const uint8_t* get_data() const;
+    size_t get_size() const;
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+} // namespace hg
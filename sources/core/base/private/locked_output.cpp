@@ -0,0 +1,25 @@
+#include "core/base/locked_output.h"
+
+namespace hg {
+
+namespace locked_output_details {
+
+/** Function local static allows printing during static initialization. */
+std::mutex& get_output_mutex() {
+    static std::mutex output_mutex;
+    return output_mutex;
+}
+
+} // namespace locked_output_details
+
+LockedOutput::LockedOutput(std::ostream& stream)
+        : m_guard(locked_output_details::get_output_mutex())
+        , m_stream(stream) {
+}
+
+LockedOutput& LockedOutput::operator<<(std::ostream& (*manipulator)(std::ostream&)) {
+    m_stream << manipulator;
+    return *this;
+}
+
+} // namespace hg
@@ -0,0 +1,113 @@
+#include "core/base/memory_mapped_file.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hg {
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& another)
+        : m_data(std::exchange(another.m_data, nullptr))
+        , m_size(std::exchange(another.m_size, 0)) {
+}
+
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& another) {
+    if (this != &another) {
+        close();
+
+        m_data = std::exchange(another.m_data, nullptr);
+        m_size = std::exchange(another.m_size, 0);
+    }
+    return *this;
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    close();
+}
+
+bool MemoryMappedFile::open(const std::string& path) {
+    close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return false;
+    }
+
+    // The view keeps the mapping alive.
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == nullptr) {
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(data);
+    m_size = static_cast<size_t>(file_size.QuadPart);
+#else
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file == -1) {
+        return false;
+    }
+
+    struct stat file_stat {};
+    if (fstat(file, &file_stat) != 0 || file_stat.st_size == 0) {
+        ::close(file);
+        return false;
+    }
+
+    // The mapping stays valid after the file is closed.
+    void* data = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(data);
+    m_size = static_cast<size_t>(file_stat.st_size);
+#endif
+
+    return true;
+}
+
+void MemoryMappedFile::close() {
+    if (m_data != nullptr) {
+#if defined(_WIN32)
+        UnmapViewOfFile(m_data);
+#else
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
+
+const uint8_t* MemoryMappedFile::get_data() const {
+    return m_data;
+}
+
+size_t MemoryMappedFile::get_size() const {
+    return m_size;
+}
+
+} // namespace hg
@@ -0,0 +1,60 @@
+#include "core/base/worker_pool.h"
+
+#include <cassert>
+
+namespace hg {
+
+WorkerPool::WorkerPool(size_t num_threads) {
+    assert(num_threads > 0);
+
+    for (size_t i = 0; i < num_threads; i++) {
+        m_threads.emplace_back(&WorkerPool::worker_thread, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_is_stopped = true;
+    }
+    m_condition.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+size_t WorkerPool::get_num_threads() const {
+    return m_threads.size();
+}
+
+void WorkerPool::push_task(std::function<void()>&& task) {
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_queue.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+void WorkerPool::worker_thread() {
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_is_stopped || !m_queue.empty(); });
+
+            // Remaining tasks are finished before stopping, so nobody waits for a future that is never set.
+            if (m_queue.empty()) {
+                return;
+            }
+
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        task();
+    }
+}
+
+} // namespace hg
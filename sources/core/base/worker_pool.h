@@ -0,0 +1,51 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace hg {
+
+/** `WorkerPool` runs tasks on a fixed set of persistent threads in order they're pushed. Threads are created once, so
+    pushing a task on a hot path doesn't create a thread like `std::async` does. */
+class WorkerPool final {
+public:
+    explicit WorkerPool(size_t num_threads);
+    WorkerPool(const WorkerPool& another) = delete;
+    WorkerPool& operator=(const WorkerPool& another) = delete;
+
+    /** Tasks that are already pushed are finished first. */
+    ~WorkerPool();
+
+    /** Push the specified task and return the future of its result. A task may wait for tasks it pushes only when
+        there's a free thread left for each of them. */
+    template <typename T>
+    std::future<std::invoke_result_t<T>> push(T&& task) {
+        auto packaged_task = std::make_shared<std::packaged_task<std::invoke_result_t<T>()>>(std::forward<T>(task));
+        std::future<std::invoke_result_t<T>> result = packaged_task->get_future();
+        push_task([packaged_task]() { (*packaged_task)(); });
+        return result;
+    }
+
+    size_t get_num_threads() const;
+
+private:
+    void push_task(std::function<void()>&& task);
+    void worker_thread();
+
+    std::deque<std::function<void()>> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    std::vector<std::thread> m_threads;
+    bool m_is_stopped = false;
+};
+
+} // namespace hg
@@ -91,6 +91,11 @@ private:
         bool(*has)(const entt::registry* registry, entt::entity entity);
         entt::meta_handle(*get)(const entt::registry* registry, entt::entity entity);
         entt::meta_handle(*get_or_assign)(entt::registry* registry, entt::entity entity);
+        void(*reserve)(entt::registry* registry, size_t capacity);
+        void(*assign_default_range)(entt::registry* registry, const entt::entity* first, const entt::entity* last);
+        size_t(*size)(const entt::registry* registry);
+        const entt::entity*(*data)(const entt::registry* registry);
+        entt::meta_handle(*raw)(const entt::registry* registry, size_t index);
     };
 
     static std::unordered_map<entt::meta_type, ComponentDescriptor> descriptors;
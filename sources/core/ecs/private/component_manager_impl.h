@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/ecs/component_manager.h"
+#include "core/meta/serialization_plan.h"
 
 namespace hg {
 
@@ -110,7 +111,44 @@ void ComponentManager::register_component() {
         descriptor.get_or_assign = nullptr;
     }
 
+    descriptor.reserve = [](entt::registry* registry, size_t capacity) {
+        registry->reserve<T>(capacity);
+    };
+
+    if constexpr (std::is_default_constructible_v<T>) {
+        descriptor.assign_default_range = [](entt::registry* registry, const entt::entity* first, const entt::entity* last) {
+            registry->reserve<T>(registry->size<T>() + (last - first));
+            for (const entt::entity* entity = first; entity != last; entity++) {
+                registry->assign<T>(*entity);
+            }
+        };
+    } else {
+        descriptor.assign_default_range = nullptr;
+    }
+
+    descriptor.size = [](const entt::registry* registry) -> size_t {
+        return registry->size<T>();
+    };
+
+    descriptor.data = [](const entt::registry* registry) -> const entt::entity* {
+        return registry->data<T>();
+    };
+
+    descriptor.raw = [](const entt::registry* registry, size_t index) -> entt::meta_handle {
+        if constexpr (std::is_empty_v<T>) {
+            static T instance;
+            return entt::meta_handle(instance);
+        } else {
+            return entt::meta_handle(const_cast<entt::registry*>(registry)->raw<T>()[index]);
+        }
+    };
+
     descriptors.emplace(entt::resolve<T>(), descriptor);
+
+    // Plans are built on registration, so they're never built concurrently later.
+    if (is_editable(entt::resolve<T>())) {
+        SerializationPlan::get(entt::resolve<T>());
+    }
 }
 
 template <typename T>
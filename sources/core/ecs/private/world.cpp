@@ -86,6 +86,12 @@ entt::meta_handle World::assign_default(entt::entity entity, entt::meta_type com
     return ComponentManager::descriptors[component_type].assign_default(this, entity);
 }
 
+void World::assign_default(const entt::entity* first, const entt::entity* last, entt::meta_type component_type) {
+    assert(ComponentManager::is_registered(component_type));
+    assert(ComponentManager::is_default_constructible(component_type));
+    ComponentManager::descriptors[component_type].assign_default_range(this, first, last);
+}
+
 entt::meta_handle World::assign_copy(entt::entity entity, entt::meta_handle component) {
     assert(ComponentManager::is_registered(component.type()));
     assert(ComponentManager::is_copy_constructible(component.type()));
@@ -145,6 +151,16 @@ entt::meta_handle World::get_or_assign(entt::entity entity, entt::meta_type comp
     return ComponentManager::descriptors[component_type].get_or_assign(this, entity);
 }
 
+void World::reserve(entt::meta_type component_type, size_t capacity) {
+    assert(ComponentManager::is_registered(component_type));
+    ComponentManager::descriptors[component_type].reserve(this, capacity);
+}
+
+size_t World::size(entt::meta_type component_type) const {
+    assert(ComponentManager::is_registered(component_type));
+    return ComponentManager::descriptors[component_type].size(this);
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 void World::clear_tags() {
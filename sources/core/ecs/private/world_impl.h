@@ -74,6 +74,18 @@ void World::each_editable_component(entt::entity entity, T callback) const {
     });
 }
 
+template <typename T>
+void World::each_component(entt::meta_type component_type, T callback) const {
+    assert(ComponentManager::is_registered(component_type));
+
+    const ComponentManager::ComponentDescriptor& descriptor = ComponentManager::descriptors[component_type];
+
+    const entt::entity* entities = descriptor.data(this);
+    for (size_t i = 0, size = descriptor.size(this); i < size; i++) {
+        callback(entities[i], descriptor.raw(this, i));
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 template <typename... Tags>
@@ -82,6 +82,10 @@ public:
     /** Perform `entt::registry::assign` on earlier registered component. Component must be default-constructible. */
     entt::meta_handle assign_default(entt::entity entity, entt::meta_type component_type);
 
+    /** Perform `entt::registry::assign` on each entity of the specified range. Storage is reserved once for the whole
+        range. Component must be default-constructible. */
+    void assign_default(const entt::entity* first, const entt::entity* last, entt::meta_type component_type);
+
     /** Perform `entt::registry::assign` on earlier registered component. Component must be copy-constructible. */
     entt::meta_handle assign_copy(entt::entity entity, entt::meta_handle component);
 
@@ -112,6 +116,12 @@ public:
     /** Perform `entt::registry::get_or_assign` on earlier registered component. Default constructor is used. */
     entt::meta_handle get_or_assign(entt::entity entity, entt::meta_type component_type);
 
+    /** Perform `entt::registry::reserve` on earlier registered component. */
+    void reserve(entt::meta_type component_type, size_t capacity);
+
+    /** Perform `entt::registry::size` on earlier registered component. */
+    size_t size(entt::meta_type component_type) const;
+
     /** Iterate over all registered components of specified `entity`.
 
         world.each_registered_component(entity, [](const entt::meta_handle component_handle) {
@@ -128,11 +138,22 @@ public:
     template <typename T>
     void each_editable_component(entt::entity entity, T callback) const;
 
-    /** Allow using entt versions of `assign`, `remove`, `has`, `get` and `get_or_assign` methods. */
+    /** Iterate over all components of specified type in storage order. Unlike views, this doesn't require compile time
+        type and visits components sequentially.
+
+        world.each_component(component_type, [](const entt::entity entity, const entt::meta_handle component_handle) {
+            // Your code goes here
+        }); */
+    template <typename T>
+    void each_component(entt::meta_type component_type, T callback) const;
+
+    /** Allow using entt versions of `assign`, `remove`, `has`, `get`, `get_or_assign`, `reserve` and `size` methods. */
     using entt::registry::remove;
     using entt::registry::has;
     using entt::registry::get;
     using entt::registry::get_or_assign;
+    using entt::registry::reserve;
+    using entt::registry::size;
 
     /// TAGS /////////////////////////////////////////////////////////////////
 
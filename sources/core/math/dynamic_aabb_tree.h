@@ -0,0 +1,91 @@
+#pragma once
+
+#include "core/math/ray.h"
+
+#include <cstdint>
+#include <functional>
+#include <glm/mat4x4.hpp>
+#include <limits>
+#include <vector>
+
+namespace hg {
+
+/** `DynamicAABBTree` is a bounding volume hierarchy that supports incremental insertion, removal and update of boxes.
+    Leaf boxes are fattened, so small movements don't require tree restructuring. The tree is kept balanced with
+    rotations, so queries stay logarithmic regardless of insertion order.
+
+    Each inserted box is identified by a proxy, which is returned from `insert` and is stable until `remove`. Each box
+    also has an arbitrary user value, for example entity identifier, which is what queries return. */
+class DynamicAABBTree final {
+public:
+    static constexpr uint32_t NULL_PROXY = std::numeric_limits<uint32_t>::max();
+
+    /** `RaycastCallback` receives a user value and ray entry distance of its fat box. It returns a new max distance,
+        which allows to skip boxes that are known to be further than an already found intersection. */
+    using RaycastCallback = std::function<float(uint32_t value, float distance)>;
+
+    /** Insert a box with the specified bounds and the given user value. Return proxy of the inserted box. */
+    uint32_t insert(const glm::vec3& min, const glm::vec3& max, uint32_t value);
+
+    /** Remove box with the specified proxy. */
+    void remove(uint32_t proxy);
+
+    /** Update bounds of the specified proxy. Return true if the box had to be reinserted, i.e. it moved out of its
+        fat box, or shrunk significantly. */
+    bool update(uint32_t proxy, const glm::vec3& min, const glm::vec3& max);
+
+    /** Remove all the boxes. */
+    void clear();
+
+    /** Return user value of the specified proxy. */
+    uint32_t get_value(uint32_t proxy) const;
+
+    /** Return fat bounds of the specified proxy. */
+    void get_bounds(uint32_t proxy, glm::vec3& min, glm::vec3& max) const;
+
+    /** Return number of boxes in the tree. */
+    size_t size() const;
+
+    /** Append values of all boxes that overlap with the specified box to `result`. */
+    void query_box(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& result) const;
+
+    /** Append values of all boxes that overlap with the specified sphere to `result`. */
+    void query_sphere(const glm::vec3& center, float radius, std::vector<uint32_t>& result) const;
+
+    /** Append values of all boxes that are at least partially inside of the frustum specified by `view_projection`
+        matrix to `result`. */
+    void query_frustum(const glm::mat4& view_projection, std::vector<uint32_t>& result) const;
+
+    /** Call `callback` for each box that is intersected by the specified `ray` closer than `max_distance`. Closer
+        subtrees are visited first. */
+    void raycast(const Ray& ray, float max_distance, const RaycastCallback& callback) const;
+
+private:
+    /** Bounds are stored as four floats to allow aligned SIMD loads. Free nodes reuse `parent` as the next free node. */
+    struct alignas(16) Node final {
+        float min[4];
+        float max[4];
+        uint32_t parent;
+        uint32_t left;
+        uint32_t right;
+        int32_t height;
+        uint32_t value;
+    };
+
+    uint32_t allocate_node();
+    void free_node(uint32_t node);
+
+    void insert_leaf(uint32_t leaf);
+    void remove_leaf(uint32_t leaf);
+    void refit(uint32_t node);
+    uint32_t balance(uint32_t node);
+
+    void collect_leaves(uint32_t node, std::vector<uint32_t>& result) const;
+
+    std::vector<Node> m_nodes;
+    uint32_t m_root = NULL_PROXY;
+    uint32_t m_free_list = NULL_PROXY;
+    size_t m_size = 0;
+};
+
+} // namespace hg
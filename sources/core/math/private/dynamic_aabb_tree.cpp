@@ -0,0 +1,628 @@
+#include "core/math/dynamic_aabb_tree.h"
+
+#include <algorithm>
+#include <bx/simd_t.h>
+#include <cassert>
+#include <cmath>
+
+namespace hg {
+
+namespace dynamic_aabb_tree_details {
+
+/** Leaf boxes are extended by this value in all directions, so small movements don't cause reinsertion. */
+static const float FAT_MARGIN = 0.1f;
+
+/** Leaf is reinserted when its fat box is this much larger than needed on any side, e.g. after scaling down. */
+static const float MAX_FAT_MARGIN = FAT_MARGIN * 4.f;
+
+static const size_t MAX_STACK_SIZE = 256;
+
+static float get_area(const bx::simd128_t min, const bx::simd128_t max) {
+    const bx::simd128_t size = bx::simd_sub(max, min);
+    const float x = bx::simd_x(size);
+    const float y = bx::simd_y(size);
+    const float z = bx::simd_z(size);
+    return 2.f * (x * y + y * z + z * x);
+}
+
+static bool is_disjoint(const bx::simd128_t min_a, const bx::simd128_t max_a, const bx::simd128_t min_b, const bx::simd128_t max_b) {
+    return bx::simd_test_any_xyz(bx::simd_or(bx::simd_cmpgt(min_a, max_b), bx::simd_cmplt(max_a, min_b)));
+}
+
+/** `FrustumPlanes` stores 6 frustum planes (padded to 8) in SoA layout, so a box is tested against 4 planes at once. */
+struct FrustumPlanes final {
+    bx::simd128_t normal_x[2];
+    bx::simd128_t normal_y[2];
+    bx::simd128_t normal_z[2];
+    bx::simd128_t abs_normal_x[2];
+    bx::simd128_t abs_normal_y[2];
+    bx::simd128_t abs_normal_z[2];
+    bx::simd128_t distance[2];
+};
+
+enum class FrustumTest {
+    OUTSIDE,
+    INTERSECTS,
+    INSIDE,
+};
+
+static FrustumPlanes get_frustum_planes(const glm::mat4& view_projection) {
+    // Gribb-Hartmann plane extraction. Near plane assumes [-1, 1] clip space depth, which is conservative for [0, 1].
+    const glm::vec4 row0(view_projection[0][0], view_projection[1][0], view_projection[2][0], view_projection[3][0]);
+    const glm::vec4 row1(view_projection[0][1], view_projection[1][1], view_projection[2][1], view_projection[3][1]);
+    const glm::vec4 row2(view_projection[0][2], view_projection[1][2], view_projection[2][2], view_projection[3][2]);
+    const glm::vec4 row3(view_projection[0][3], view_projection[1][3], view_projection[2][3], view_projection[3][3]);
+
+    // The last two planes duplicate the first one, which doesn't affect the result.
+    const glm::vec4 planes[8] = {
+            row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2, row3 + row0, row3 + row0
+    };
+
+    FrustumPlanes result;
+    for (size_t i = 0; i < 2; i++) {
+        const glm::vec4* const batch = planes + i * 4;
+        result.normal_x[i] = bx::simd_ld(batch[0].x, batch[1].x, batch[2].x, batch[3].x);
+        result.normal_y[i] = bx::simd_ld(batch[0].y, batch[1].y, batch[2].y, batch[3].y);
+        result.normal_z[i] = bx::simd_ld(batch[0].z, batch[1].z, batch[2].z, batch[3].z);
+        result.abs_normal_x[i] = bx::simd_abs(result.normal_x[i]);
+        result.abs_normal_y[i] = bx::simd_abs(result.normal_y[i]);
+        result.abs_normal_z[i] = bx::simd_abs(result.normal_z[i]);
+        result.distance[i] = bx::simd_ld(batch[0].w, batch[1].w, batch[2].w, batch[3].w);
+    }
+    return result;
+}
+
+static FrustumTest test_frustum(const FrustumPlanes& planes, const float* min, const float* max) {
+    const bx::simd128_t half = bx::simd_splat(0.5f);
+    const bx::simd128_t box_min = bx::simd_ld(min);
+    const bx::simd128_t box_max = bx::simd_ld(max);
+    const bx::simd128_t center = bx::simd_mul(bx::simd_add(box_min, box_max), half);
+    const bx::simd128_t extent = bx::simd_mul(bx::simd_sub(box_max, box_min), half);
+
+    const bx::simd128_t center_x = bx::simd_splat(bx::simd_x(center));
+    const bx::simd128_t center_y = bx::simd_splat(bx::simd_y(center));
+    const bx::simd128_t center_z = bx::simd_splat(bx::simd_z(center));
+    const bx::simd128_t extent_x = bx::simd_splat(bx::simd_x(extent));
+    const bx::simd128_t extent_y = bx::simd_splat(bx::simd_y(extent));
+    const bx::simd128_t extent_z = bx::simd_splat(bx::simd_z(extent));
+
+    const bx::simd128_t zero = bx::simd_zero();
+
+    bool is_inside = true;
+    for (size_t i = 0; i < 2; i++) {
+        const bx::simd128_t distance = bx::simd_madd(planes.normal_x[i], center_x,
+                                                     bx::simd_madd(planes.normal_y[i], center_y,
+                                                                   bx::simd_madd(planes.normal_z[i], center_z, planes.distance[i])));
+        const bx::simd128_t radius = bx::simd_madd(planes.abs_normal_x[i], extent_x,
+                                                   bx::simd_madd(planes.abs_normal_y[i], extent_y,
+                                                                 bx::simd_mul(planes.abs_normal_z[i], extent_z)));
+
+        if (bx::simd_test_any_xyzw(bx::simd_cmplt(bx::simd_add(distance, radius), zero))) {
+            return FrustumTest::OUTSIDE;
+        }
+        if (bx::simd_test_any_xyzw(bx::simd_cmplt(bx::simd_sub(distance, radius), zero))) {
+            is_inside = false;
+        }
+    }
+    return is_inside ? FrustumTest::INSIDE : FrustumTest::INTERSECTS;
+}
+
+} // namespace dynamic_aabb_tree_details
+
+uint32_t DynamicAABBTree::insert(const glm::vec3& min, const glm::vec3& max, uint32_t value) {
+    using namespace dynamic_aabb_tree_details;
+
+    const uint32_t proxy = allocate_node();
+
+    Node& node = m_nodes[proxy];
+    node.min[0] = min.x - FAT_MARGIN;
+    node.min[1] = min.y - FAT_MARGIN;
+    node.min[2] = min.z - FAT_MARGIN;
+    node.min[3] = 0.f;
+    node.max[0] = max.x + FAT_MARGIN;
+    node.max[1] = max.y + FAT_MARGIN;
+    node.max[2] = max.z + FAT_MARGIN;
+    node.max[3] = 0.f;
+    node.height = 0;
+    node.value = value;
+
+    insert_leaf(proxy);
+    m_size++;
+
+    return proxy;
+}
+
+void DynamicAABBTree::remove(uint32_t proxy) {
+    assert(proxy < m_nodes.size());
+    assert(m_nodes[proxy].height == 0);
+
+    remove_leaf(proxy);
+    free_node(proxy);
+
+    assert(m_size > 0);
+    m_size--;
+}
+
+bool DynamicAABBTree::update(uint32_t proxy, const glm::vec3& min, const glm::vec3& max) {
+    using namespace dynamic_aabb_tree_details;
+
+    assert(proxy < m_nodes.size());
+    assert(m_nodes[proxy].height == 0);
+
+    Node& node = m_nodes[proxy];
+
+    bool is_inside = true;
+    bool is_too_fat = false;
+    for (glm::length_t i = 0; i < 3; i++) {
+        is_inside &= node.min[i] <= min[i] && node.max[i] >= max[i];
+        is_too_fat |= min[i] - node.min[i] > MAX_FAT_MARGIN || node.max[i] - max[i] > MAX_FAT_MARGIN;
+    }
+
+    if (is_inside && !is_too_fat) {
+        return false;
+    }
+
+    remove_leaf(proxy);
+
+    for (glm::length_t i = 0; i < 3; i++) {
+        node.min[i] = min[i] - FAT_MARGIN;
+        node.max[i] = max[i] + FAT_MARGIN;
+    }
+
+    insert_leaf(proxy);
+
+    return true;
+}
+
+void DynamicAABBTree::clear() {
+    m_nodes.clear();
+    m_root = NULL_PROXY;
+    m_free_list = NULL_PROXY;
+    m_size = 0;
+}
+
+uint32_t DynamicAABBTree::get_value(uint32_t proxy) const {
+    assert(proxy < m_nodes.size());
+    assert(m_nodes[proxy].height == 0);
+
+    return m_nodes[proxy].value;
+}
+
+void DynamicAABBTree::get_bounds(uint32_t proxy, glm::vec3& min, glm::vec3& max) const {
+    assert(proxy < m_nodes.size());
+
+    const Node& node = m_nodes[proxy];
+    min = glm::vec3(node.min[0], node.min[1], node.min[2]);
+    max = glm::vec3(node.max[0], node.max[1], node.max[2]);
+}
+
+size_t DynamicAABBTree::size() const {
+    return m_size;
+}
+
+void DynamicAABBTree::query_box(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& result) const {
+    using namespace dynamic_aabb_tree_details;
+
+    if (m_root == NULL_PROXY) {
+        return;
+    }
+
+    const bx::simd128_t query_min = bx::simd_ld(min.x, min.y, min.z, 0.f);
+    const bx::simd128_t query_max = bx::simd_ld(max.x, max.y, max.z, 0.f);
+
+    uint32_t stack[MAX_STACK_SIZE];
+    size_t stack_size = 0;
+    stack[stack_size++] = m_root;
+
+    while (stack_size > 0) {
+        const Node& node = m_nodes[stack[--stack_size]];
+        if (!is_disjoint(query_min, query_max, bx::simd_ld(node.min), bx::simd_ld(node.max))) {
+            if (node.height == 0) {
+                result.push_back(node.value);
+            } else {
+                assert(stack_size + 2 <= MAX_STACK_SIZE);
+                stack[stack_size++] = node.left;
+                stack[stack_size++] = node.right;
+            }
+        }
+    }
+}
+
+void DynamicAABBTree::query_sphere(const glm::vec3& center, float radius, std::vector<uint32_t>& result) const {
+    using namespace dynamic_aabb_tree_details;
+
+    if (m_root == NULL_PROXY) {
+        return;
+    }
+
+    const bx::simd128_t sphere_center = bx::simd_ld(center.x, center.y, center.z, 0.f);
+    const float squared_radius = radius * radius;
+
+    uint32_t stack[MAX_STACK_SIZE];
+    size_t stack_size = 0;
+    stack[stack_size++] = m_root;
+
+    while (stack_size > 0) {
+        const Node& node = m_nodes[stack[--stack_size]];
+
+        const bx::simd128_t closest_point = bx::simd_clamp(sphere_center, bx::simd_ld(node.min), bx::simd_ld(node.max));
+        const bx::simd128_t delta = bx::simd_sub(sphere_center, closest_point);
+        if (bx::simd_x(bx::simd_dot3(delta, delta)) <= squared_radius) {
+            if (node.height == 0) {
+                result.push_back(node.value);
+            } else {
+                assert(stack_size + 2 <= MAX_STACK_SIZE);
+                stack[stack_size++] = node.left;
+                stack[stack_size++] = node.right;
+            }
+        }
+    }
+}
+
+void DynamicAABBTree::query_frustum(const glm::mat4& view_projection, std::vector<uint32_t>& result) const {
+    using namespace dynamic_aabb_tree_details;
+
+    if (m_root == NULL_PROXY) {
+        return;
+    }
+
+    const FrustumPlanes planes = get_frustum_planes(view_projection);
+
+    uint32_t stack[MAX_STACK_SIZE];
+    size_t stack_size = 0;
+    stack[stack_size++] = m_root;
+
+    while (stack_size > 0) {
+        const uint32_t node_index = stack[--stack_size];
+        const Node& node = m_nodes[node_index];
+
+        const FrustumTest test = test_frustum(planes, node.min, node.max);
+        if (test == FrustumTest::INSIDE) {
+            // The whole subtree is inside, no need to test its nodes.
+            collect_leaves(node_index, result);
+        } else if (test == FrustumTest::INTERSECTS) {
+            if (node.height == 0) {
+                result.push_back(node.value);
+            } else {
+                assert(stack_size + 2 <= MAX_STACK_SIZE);
+                stack[stack_size++] = node.left;
+                stack[stack_size++] = node.right;
+            }
+        }
+    }
+}
+
+void DynamicAABBTree::raycast(const Ray& ray, float max_distance, const RaycastCallback& callback) const {
+    using namespace dynamic_aabb_tree_details;
+
+    if (m_root == NULL_PROXY) {
+        return;
+    }
+
+    // Avoid infinities for axis-parallel rays, otherwise zero times infinity gives NaN on box boundaries.
+    auto get_inverse = [](float value) {
+        return std::abs(value) > 1e-20f ? 1.f / value : std::copysign(1e20f, value);
+    };
+
+    const bx::simd128_t origin = bx::simd_ld(ray.origin.x, ray.origin.y, ray.origin.z, 0.f);
+    const bx::simd128_t inverse_direction = bx::simd_ld(get_inverse(ray.direction.x), get_inverse(ray.direction.y), get_inverse(ray.direction.z), 0.f);
+
+    auto intersect = [&](const Node& node, float& distance) {
+        const bx::simd128_t slab_a = bx::simd_mul(bx::simd_sub(bx::simd_ld(node.min), origin), inverse_direction);
+        const bx::simd128_t slab_b = bx::simd_mul(bx::simd_sub(bx::simd_ld(node.max), origin), inverse_direction);
+        const bx::simd128_t slab_near = bx::simd_min(slab_a, slab_b);
+        const bx::simd128_t slab_far = bx::simd_max(slab_a, slab_b);
+
+        const float near_distance = std::max(std::max(bx::simd_x(slab_near), bx::simd_y(slab_near)), std::max(bx::simd_z(slab_near), 0.f));
+        const float far_distance = std::min(std::min(bx::simd_x(slab_far), bx::simd_y(slab_far)), std::min(bx::simd_z(slab_far), max_distance));
+
+        distance = near_distance;
+        return near_distance <= far_distance;
+    };
+
+    struct StackEntry final {
+        uint32_t node;
+        float distance;
+    };
+
+    float root_distance;
+    if (!intersect(m_nodes[m_root], root_distance)) {
+        return;
+    }
+
+    StackEntry stack[MAX_STACK_SIZE];
+    size_t stack_size = 0;
+    stack[stack_size++] = StackEntry{ m_root, root_distance };
+
+    while (stack_size > 0) {
+        const StackEntry entry = stack[--stack_size];
+        if (entry.distance >= max_distance) {
+            continue;
+        }
+
+        const Node& node = m_nodes[entry.node];
+        if (node.height == 0) {
+            max_distance = std::min(max_distance, callback(node.value, entry.distance));
+        } else {
+            float left_distance, right_distance;
+            const bool left_hit = intersect(m_nodes[node.left], left_distance);
+            const bool right_hit = intersect(m_nodes[node.right], right_distance);
+
+            assert(stack_size + 2 <= MAX_STACK_SIZE);
+
+            // Push the further child first, so the closer one is processed first.
+            if (left_hit && right_hit) {
+                if (left_distance < right_distance) {
+                    stack[stack_size++] = StackEntry{ node.right, right_distance };
+                    stack[stack_size++] = StackEntry{ node.left, left_distance };
+                } else {
+                    stack[stack_size++] = StackEntry{ node.left, left_distance };
+                    stack[stack_size++] = StackEntry{ node.right, right_distance };
+                }
+            } else if (left_hit) {
+                stack[stack_size++] = StackEntry{ node.left, left_distance };
+            } else if (right_hit) {
+                stack[stack_size++] = StackEntry{ node.right, right_distance };
+            }
+        }
+    }
+}
+
+uint32_t DynamicAABBTree::allocate_node() {
+    uint32_t result;
+    if (m_free_list != NULL_PROXY) {
+        result = m_free_list;
+        m_free_list = m_nodes[result].parent;
+    } else {
+        result = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+
+    Node& node = m_nodes[result];
+    node.parent = NULL_PROXY;
+    node.left = NULL_PROXY;
+    node.right = NULL_PROXY;
+    node.height = 0;
+    node.value = 0;
+
+    return result;
+}
+
+void DynamicAABBTree::free_node(uint32_t node) {
+    assert(node < m_nodes.size());
+
+    m_nodes[node].parent = m_free_list;
+    m_nodes[node].height = -1;
+    m_free_list = node;
+}
+
+void DynamicAABBTree::insert_leaf(uint32_t leaf) {
+    using namespace dynamic_aabb_tree_details;
+
+    if (m_root == NULL_PROXY) {
+        m_root = leaf;
+        m_nodes[leaf].parent = NULL_PROXY;
+        return;
+    }
+
+    const bx::simd128_t leaf_min = bx::simd_ld(m_nodes[leaf].min);
+    const bx::simd128_t leaf_max = bx::simd_ld(m_nodes[leaf].max);
+
+    // Find the best sibling using surface area heuristic.
+    uint32_t sibling = m_root;
+    while (m_nodes[sibling].height > 0) {
+        const Node& node = m_nodes[sibling];
+
+        const float area = get_area(bx::simd_ld(node.min), bx::simd_ld(node.max));
+        const float combined_area = get_area(bx::simd_min(leaf_min, bx::simd_ld(node.min)), bx::simd_max(leaf_max, bx::simd_ld(node.max)));
+
+        // Cost of creating a new parent for this node and the new leaf.
+        const float cost = 2.f * combined_area;
+
+        // Minimum cost of pushing the leaf further down the tree.
+        const float inheritance_cost = 2.f * (combined_area - area);
+
+        auto get_descend_cost = [&](uint32_t child) {
+            const Node& child_node = m_nodes[child];
+            const float child_combined_area = get_area(bx::simd_min(leaf_min, bx::simd_ld(child_node.min)), bx::simd_max(leaf_max, bx::simd_ld(child_node.max)));
+            if (child_node.height == 0) {
+                return child_combined_area + inheritance_cost;
+            }
+            return child_combined_area - get_area(bx::simd_ld(child_node.min), bx::simd_ld(child_node.max)) + inheritance_cost;
+        };
+
+        const float left_cost = get_descend_cost(node.left);
+        const float right_cost = get_descend_cost(node.right);
+
+        if (cost < left_cost && cost < right_cost) {
+            break;
+        }
+
+        sibling = left_cost < right_cost ? node.left : node.right;
+    }
+
+    const uint32_t old_parent = m_nodes[sibling].parent;
+    const uint32_t new_parent = allocate_node();
+
+    // `allocate_node` may reallocate nodes, so don't keep references across this call.
+    Node& parent_node = m_nodes[new_parent];
+    parent_node.parent = old_parent;
+    parent_node.height = m_nodes[sibling].height + 1;
+    parent_node.left = sibling;
+    parent_node.right = leaf;
+    bx::simd_st(parent_node.min, bx::simd_min(leaf_min, bx::simd_ld(m_nodes[sibling].min)));
+    bx::simd_st(parent_node.max, bx::simd_max(leaf_max, bx::simd_ld(m_nodes[sibling].max)));
+
+    if (old_parent != NULL_PROXY) {
+        if (m_nodes[old_parent].left == sibling) {
+            m_nodes[old_parent].left = new_parent;
+        } else {
+            m_nodes[old_parent].right = new_parent;
+        }
+    } else {
+        m_root = new_parent;
+    }
+
+    m_nodes[sibling].parent = new_parent;
+    m_nodes[leaf].parent = new_parent;
+
+    refit(m_nodes[leaf].parent);
+}
+
+void DynamicAABBTree::remove_leaf(uint32_t leaf) {
+    if (leaf == m_root) {
+        m_root = NULL_PROXY;
+        return;
+    }
+
+    const uint32_t parent = m_nodes[leaf].parent;
+    const uint32_t grand_parent = m_nodes[parent].parent;
+    const uint32_t sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+    if (grand_parent != NULL_PROXY) {
+        if (m_nodes[grand_parent].left == parent) {
+            m_nodes[grand_parent].left = sibling;
+        } else {
+            m_nodes[grand_parent].right = sibling;
+        }
+        m_nodes[sibling].parent = grand_parent;
+        free_node(parent);
+
+        refit(grand_parent);
+    } else {
+        m_root = sibling;
+        m_nodes[sibling].parent = NULL_PROXY;
+        free_node(parent);
+    }
+}
+
+void DynamicAABBTree::refit(uint32_t node) {
+    while (node != NULL_PROXY) {
+        node = balance(node);
+
+        Node& current = m_nodes[node];
+        const Node& left = m_nodes[current.left];
+        const Node& right = m_nodes[current.right];
+
+        current.height = 1 + std::max(left.height, right.height);
+        bx::simd_st(current.min, bx::simd_min(bx::simd_ld(left.min), bx::simd_ld(right.min)));
+        bx::simd_st(current.max, bx::simd_max(bx::simd_ld(left.max), bx::simd_ld(right.max)));
+
+        node = current.parent;
+    }
+}
+
+uint32_t DynamicAABBTree::balance(uint32_t a) {
+    // Perform a left or right rotation if node `a` is imbalanced. Return the new root of the subtree.
+    Node& node_a = m_nodes[a];
+    if (node_a.height < 2) {
+        return a;
+    }
+
+    const uint32_t b = node_a.left;
+    const uint32_t c = node_a.right;
+    Node& node_b = m_nodes[b];
+    Node& node_c = m_nodes[c];
+
+    auto set_union = [](Node& target, const Node& first, const Node& second) {
+        bx::simd_st(target.min, bx::simd_min(bx::simd_ld(first.min), bx::simd_ld(second.min)));
+        bx::simd_st(target.max, bx::simd_max(bx::simd_ld(first.max), bx::simd_ld(second.max)));
+        target.height = 1 + std::max(first.height, second.height);
+    };
+
+    auto replace_child = [&](uint32_t parent, uint32_t old_child, uint32_t new_child) {
+        if (parent != NULL_PROXY) {
+            if (m_nodes[parent].left == old_child) {
+                m_nodes[parent].left = new_child;
+            } else {
+                assert(m_nodes[parent].right == old_child);
+                m_nodes[parent].right = new_child;
+            }
+        } else {
+            m_root = new_child;
+        }
+    };
+
+    const int32_t imbalance = node_c.height - node_b.height;
+
+    if (imbalance > 1) {
+        // Rotate `c` up.
+        const uint32_t f = node_c.left;
+        const uint32_t g = node_c.right;
+        Node& node_f = m_nodes[f];
+        Node& node_g = m_nodes[g];
+
+        node_c.left = a;
+        node_c.parent = node_a.parent;
+        node_a.parent = c;
+        replace_child(node_c.parent, a, c);
+
+        if (node_f.height > node_g.height) {
+            node_c.right = f;
+            node_a.right = g;
+            node_g.parent = a;
+            set_union(node_a, node_b, node_g);
+            set_union(node_c, node_a, node_f);
+        } else {
+            node_c.right = g;
+            node_a.right = f;
+            node_f.parent = a;
+            set_union(node_a, node_b, node_f);
+            set_union(node_c, node_a, node_g);
+        }
+
+        return c;
+    }
+
+    if (imbalance < -1) {
+        // Rotate `b` up.
+        const uint32_t d = node_b.left;
+        const uint32_t e = node_b.right;
+        Node& node_d = m_nodes[d];
+        Node& node_e = m_nodes[e];
+
+        node_b.left = a;
+        node_b.parent = node_a.parent;
+        node_a.parent = b;
+        replace_child(node_b.parent, a, b);
+
+        if (node_d.height > node_e.height) {
+            node_b.right = d;
+            node_a.left = e;
+            node_e.parent = a;
+            set_union(node_a, node_c, node_e);
+            set_union(node_b, node_a, node_d);
+        } else {
+            node_b.right = e;
+            node_a.left = d;
+            node_d.parent = a;
+            set_union(node_a, node_c, node_d);
+            set_union(node_b, node_a, node_e);
+        }
+
+        return b;
+    }
+
+    return a;
+}
+
+void DynamicAABBTree::collect_leaves(uint32_t node, std::vector<uint32_t>& result) const {
+    using namespace dynamic_aabb_tree_details;
+
+    uint32_t stack[MAX_STACK_SIZE];
+    size_t stack_size = 0;
+    stack[stack_size++] = node;
+
+    while (stack_size > 0) {
+        const Node& current = m_nodes[stack[--stack_size]];
+        if (current.height == 0) {
+            result.push_back(current.value);
+        } else {
+            assert(stack_size + 2 <= MAX_STACK_SIZE);
+            stack[stack_size++] = current.left;
+            stack[stack_size++] = current.right;
+        }
+    }
+}
+
+} // namespace hg
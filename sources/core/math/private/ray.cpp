@@ -0,0 +1,75 @@
+#include "core/math/ray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/geometric.hpp>
+#include <limits>
+
+namespace hg {
+
+bool intersect_ray_aabb(const Ray& ray, const glm::vec3& min, const glm::vec3& max, float max_distance, float& distance) {
+    float near_distance = 0.f;
+    float far_distance = max_distance;
+
+    for (glm::length_t axis = 0; axis < 3; axis++) {
+        if (std::abs(ray.direction[axis]) < std::numeric_limits<float>::epsilon()) {
+            // Ray is parallel to the slab, so it either always inside or always outside of it.
+            if (ray.origin[axis] < min[axis] || ray.origin[axis] > max[axis]) {
+                return false;
+            }
+        } else {
+            const float inverse_direction = 1.f / ray.direction[axis];
+
+            float slab_near = (min[axis] - ray.origin[axis]) * inverse_direction;
+            float slab_far = (max[axis] - ray.origin[axis]) * inverse_direction;
+            if (slab_near > slab_far) {
+                std::swap(slab_near, slab_far);
+            }
+
+            near_distance = std::max(near_distance, slab_near);
+            far_distance = std::min(far_distance, slab_far);
+            if (near_distance > far_distance) {
+                return false;
+            }
+        }
+    }
+
+    distance = near_distance;
+    return true;
+}
+
+bool intersect_ray_triangle(const Ray& ray, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, float max_distance, float& distance) {
+    // Möller–Trumbore intersection algorithm.
+    const glm::vec3 edge_ab = b - a;
+    const glm::vec3 edge_ac = c - a;
+
+    const glm::vec3 p = glm::cross(ray.direction, edge_ac);
+    const float determinant = glm::dot(edge_ab, p);
+    if (std::abs(determinant) < std::numeric_limits<float>::epsilon()) {
+        return false;
+    }
+
+    const float inverse_determinant = 1.f / determinant;
+
+    const glm::vec3 t = ray.origin - a;
+    const float u = glm::dot(t, p) * inverse_determinant;
+    if (u < 0.f || u > 1.f) {
+        return false;
+    }
+
+    const glm::vec3 q = glm::cross(t, edge_ab);
+    const float v = glm::dot(ray.direction, q) * inverse_determinant;
+    if (v < 0.f || u + v > 1.f) {
+        return false;
+    }
+
+    const float result = glm::dot(edge_ac, q) * inverse_determinant;
+    if (result < 0.f || result >= max_distance) {
+        return false;
+    }
+
+    distance = result;
+    return true;
+}
+
+} // namespace hg
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+
+namespace hg {
+
+/** `Ray` is a half-line specified by its origin and direction. Direction is not required to be normalized, in which
+    case all the distances are measured in direction lengths. This allows to transform a ray to another space with
+    an affine transform without recomputing the distances. */
+struct Ray final {
+    glm::vec3 origin;
+    glm::vec3 direction;
+};
+
+/** Return whether the specified `ray` intersects the given box closer than `max_distance`. In case it does, store entry
+    distance in `distance`. Entry distance is zero when the ray starts inside of the box. */
+bool intersect_ray_aabb(const Ray& ray, const glm::vec3& min, const glm::vec3& max, float max_distance, float& distance);
+
+/** Return whether the specified `ray` intersects the given triangle closer than `max_distance`. In case it does, store
+    intersection distance in `distance`. Both triangle sides are taken into account. */
+bool intersect_ray_triangle(const Ray& ray, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, float max_distance, float& distance);
+
+} // namespace hg
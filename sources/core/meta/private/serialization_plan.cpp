@@ -0,0 +1,154 @@
+#include "core/meta/serialization_plan.h"
+
+#include <cassert>
+#include <entt/core/hashed_string.hpp>
+#include <entt/meta/factory.hpp>
+#include <memory>
+#include <mutex>
+
+namespace hg {
+
+namespace serialization_plan_details {
+
+/** Plans are looked up from loader threads, while plans of non-component types may still be built on first use.
+    The mutex is recursive, because building a plan gets plans of its structure properties. */
+struct PlanRegistry final {
+    std::recursive_mutex mutex;
+    std::unordered_map<entt::meta_type, std::unique_ptr<SerializationPlan>> plans;
+    std::unordered_map<std::string, const SerializationPlan*> named_plans;
+};
+
+/** Function local static allows building plans during static initialization. */
+PlanRegistry& get_plan_registry() {
+    static PlanRegistry plan_registry;
+    return plan_registry;
+}
+
+bool is_ignored(const entt::meta_prop ignore_property) {
+    return ignore_property && ignore_property.value().type() == entt::resolve<bool>() && ignore_property.value().cast<bool>();
+}
+
+const char* get_name(const entt::meta_prop name_property) {
+    if (name_property && name_property.value().type() == entt::resolve<const char*>()) {
+        return name_property.value().cast<const char*>();
+    }
+    return nullptr;
+}
+
+bool get_scalar_kind(const entt::meta_type type, SerializationPlan::Kind& result) {
+    if (type == entt::resolve<int32_t>()) {
+        result = SerializationPlan::Kind::INT;
+    } else if (type == entt::resolve<uint32_t>()) {
+        result = SerializationPlan::Kind::UINT;
+    } else if (type == entt::resolve<float>()) {
+        result = SerializationPlan::Kind::FLOAT;
+    } else if (type == entt::resolve<bool>()) {
+        result = SerializationPlan::Kind::BOOL;
+    } else if (type == entt::resolve<std::string>()) {
+        result = SerializationPlan::Kind::STRING;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace serialization_plan_details
+
+const SerializationPlan& SerializationPlan::get(const entt::meta_type type) {
+    using namespace serialization_plan_details;
+
+    assert(type);
+
+    PlanRegistry& plan_registry = get_plan_registry();
+    std::lock_guard<std::recursive_mutex> guard(plan_registry.mutex);
+
+    if (auto result = plan_registry.plans.find(type); result != plan_registry.plans.end()) {
+        return *result->second;
+    }
+
+    // The plan is registered before it's built, so recursive structures don't recurse infinitely.
+    SerializationPlan& plan = *plan_registry.plans.emplace(type, std::unique_ptr<SerializationPlan>(new SerializationPlan())).first->second;
+    plan.build(type);
+
+    if (!plan.m_name.empty()) {
+        plan_registry.named_plans.emplace(plan.m_name, &plan);
+    }
+
+    return plan;
+}
+
+const SerializationPlan* SerializationPlan::find(const std::string& name) {
+    using namespace serialization_plan_details;
+
+    PlanRegistry& plan_registry = get_plan_registry();
+    std::lock_guard<std::recursive_mutex> guard(plan_registry.mutex);
+
+    if (auto result = plan_registry.named_plans.find(name); result != plan_registry.named_plans.end()) {
+        return result->second;
+    }
+    return nullptr;
+}
+
+const SerializationPlan::Property* SerializationPlan::find_property(const std::string& name) const {
+    if (auto result = m_property_indices.find(name); result != m_property_indices.end()) {
+        return &m_properties[result->second];
+    }
+    return nullptr;
+}
+
+entt::meta_type SerializationPlan::get_type() const {
+    return m_type;
+}
+
+const std::string& SerializationPlan::get_name() const {
+    return m_name;
+}
+
+const std::vector<SerializationPlan::Property>& SerializationPlan::get_properties() const {
+    return m_properties;
+}
+
+void SerializationPlan::build(const entt::meta_type type) {
+    using namespace serialization_plan_details;
+
+    m_type = type;
+
+    if (const char* name = serialization_plan_details::get_name(type.prop("name"_hs)); name != nullptr) {
+        m_name = name;
+    }
+
+    type.data([&](const entt::meta_data data) {
+        assert(data);
+
+        const entt::meta_type property_type = data.type();
+        if (!property_type || is_ignored(property_type.prop("ignore"_hs)) || is_ignored(data.prop("ignore"_hs))) {
+            return;
+        }
+
+        const char* name = serialization_plan_details::get_name(data.prop("name"_hs));
+        if (name == nullptr) {
+            return;
+        }
+
+        assert(*name != '\0');
+
+        Property property;
+        property.name = name;
+        property.data = data;
+        property.plan = nullptr;
+
+        if (!get_scalar_kind(property_type, property.kind)) {
+            if (!property_type.is_class()) {
+                return;
+            }
+
+            property.kind = Kind::STRUCTURE;
+            property.plan = &get(property_type);
+        }
+
+        m_property_indices.emplace(property.name, m_properties.size());
+        m_properties.push_back(std::move(property));
+    });
+}
+
+} // namespace hg
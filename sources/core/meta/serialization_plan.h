@@ -0,0 +1,63 @@
+#pragma once
+
+#include <entt/meta/meta.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hg {
+
+/** `SerializationPlan` lists serializable properties of a structure type. A property is serializable when it has
+    a name, it's not ignored and its type is either a scalar or a structure. Plans are built from reflection once per
+    type, so serialization runs straight through the plan without looking up meta properties, comparing meta types
+    or resolving names. Plans of registered components are built on registration. Plans may be requested from any
+    thread, the plan registry is guarded by a mutex. */
+class SerializationPlan final {
+public:
+    enum class Kind : uint8_t {
+        INT,
+        UINT,
+        FLOAT,
+        BOOL,
+        STRING,
+        STRUCTURE,
+    };
+
+    struct Property final {
+        std::string name;
+
+        /** Meta data provides getter and setter of the property. */
+        entt::meta_data data;
+
+        Kind kind;
+
+        /** Plan of the property type when `kind` is `STRUCTURE`, nullptr otherwise. */
+        const SerializationPlan* plan;
+    };
+
+    /** Return plan of the specified structure type. The plan is built on first use. */
+    static const SerializationPlan& get(entt::meta_type type);
+
+    /** Return plan of the structure type with the specified reflected name or nullptr if such type doesn't have
+        a plan yet. */
+    static const SerializationPlan* find(const std::string& name);
+
+    /** Return property with the specified name or nullptr if such property is not serializable. */
+    const Property* find_property(const std::string& name) const;
+
+    entt::meta_type get_type() const;
+    const std::string& get_name() const;
+    const std::vector<Property>& get_properties() const;
+
+private:
+    SerializationPlan() = default;
+
+    void build(entt::meta_type type);
+
+    entt::meta_type m_type;
+    std::string m_name;
+    std::vector<Property> m_properties;
+    std::unordered_map<std::string, size_t> m_property_indices;
+};
+
+} // namespace hg
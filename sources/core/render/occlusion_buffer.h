@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <limits>
+#include <vector>
+
+namespace hg {
+
+/** `OcclusionBuffer` is a low resolution software depth buffer. Occluders are rasterized into it, then screen space
+    bounds of other objects are tested against it. Rows are processed four texels at a time with SIMD.
+
+    Depth is normalized device coordinate depth, smaller values are closer to the viewer. Triangles that cross the near
+    plane are not rasterized, so occluders very close to the camera don't occlude anything. */
+class OcclusionBuffer final {
+public:
+    /** Width is rounded up to a multiple of four. */
+    OcclusionBuffer(uint32_t width, uint32_t height);
+
+    uint32_t get_width() const;
+    uint32_t get_height() const;
+
+    /** Reset all texels to the far plane. */
+    void clear();
+
+    /** Rasterize a solid box with the specified local bounds. `transform` maps local space to clip space. Only rows in
+        [`first_row`, `last_row`) are written, so different row ranges can be rasterized on different threads. */
+    void rasterize_box(const glm::mat4& transform, const glm::vec3& min, const glm::vec3& max,
+                       uint32_t first_row = 0, uint32_t last_row = std::numeric_limits<uint32_t>::max());
+
+    /** Return false if the specified world space box is definitely occluded or outside of the screen. `view_projection`
+        maps world space to clip space. This method doesn't modify the buffer and may be called from multiple threads. */
+    bool test_box(const glm::mat4& view_projection, const glm::vec3& min, const glm::vec3& max) const;
+
+private:
+    struct alignas(16) Block final {
+        float depth[4];
+    };
+
+    void rasterize_triangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, uint32_t first_row, uint32_t last_row);
+
+    uint32_t m_width;
+    uint32_t m_height;
+    std::vector<Block> m_blocks;
+};
+
+} // namespace hg
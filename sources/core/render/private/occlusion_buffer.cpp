@@ -0,0 +1,240 @@
+#include "core/render/occlusion_buffer.h"
+
+#include <algorithm>
+#include <bx/simd_t.h>
+#include <cassert>
+#include <cmath>
+
+namespace hg {
+
+namespace occlusion_buffer_details {
+
+/** Vertices with smaller clip space W are considered to be behind the near plane. */
+static const float MIN_W = 1e-4f;
+
+static const float FAR_DEPTH = 1.f;
+
+/** Box triangles, vertex indices match bits of the corner index (x is bit 0, y is bit 1, z is bit 2). */
+static const uint8_t BOX_INDICES[] = {
+        0, 2, 1, 1, 2, 3,
+        4, 5, 6, 5, 7, 6,
+        0, 1, 4, 1, 5, 4,
+        2, 6, 3, 3, 6, 7,
+        0, 4, 2, 2, 4, 6,
+        1, 3, 5, 3, 7, 5,
+};
+
+static glm::vec4 get_corner(const glm::vec3& min, const glm::vec3& max, size_t index) {
+    return glm::vec4((index & 1) != 0 ? max.x : min.x,
+                     (index & 2) != 0 ? max.y : min.y,
+                     (index & 4) != 0 ? max.z : min.z,
+                     1.f);
+}
+
+} // namespace occlusion_buffer_details
+
+OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height)
+        : m_width((width + 3) & ~3U)
+        , m_height(height)
+        , m_blocks(static_cast<size_t>(m_width / 4) * height) {
+    assert(width > 0 && height > 0);
+
+    clear();
+}
+
+uint32_t OcclusionBuffer::get_width() const {
+    return m_width;
+}
+
+uint32_t OcclusionBuffer::get_height() const {
+    return m_height;
+}
+
+void OcclusionBuffer::clear() {
+    using namespace occlusion_buffer_details;
+
+    const bx::simd128_t far_depth = bx::simd_splat(FAR_DEPTH);
+    for (Block& block : m_blocks) {
+        bx::simd_st(block.depth, far_depth);
+    }
+}
+
+void OcclusionBuffer::rasterize_box(const glm::mat4& transform, const glm::vec3& min, const glm::vec3& max, uint32_t first_row, uint32_t last_row) {
+    using namespace occlusion_buffer_details;
+
+    last_row = std::min(last_row, m_height);
+    if (first_row >= last_row) {
+        return;
+    }
+
+    glm::vec3 screen_corners[8];
+    for (size_t i = 0; i < 8; i++) {
+        const glm::vec4 clip_corner = transform * get_corner(min, max, i);
+        if (clip_corner.w < MIN_W) {
+            // Clipping is not implemented, skipping the whole occluder is conservative.
+            return;
+        }
+
+        const float inverse_w = 1.f / clip_corner.w;
+        screen_corners[i] = glm::vec3((clip_corner.x * inverse_w * 0.5f + 0.5f) * m_width,
+                                      (clip_corner.y * inverse_w * 0.5f + 0.5f) * m_height,
+                                      clip_corner.z * inverse_w);
+    }
+
+    for (size_t i = 0; i < std::size(BOX_INDICES); i += 3) {
+        rasterize_triangle(screen_corners[BOX_INDICES[i]], screen_corners[BOX_INDICES[i + 1]], screen_corners[BOX_INDICES[i + 2]], first_row, last_row);
+    }
+}
+
+bool OcclusionBuffer::test_box(const glm::mat4& view_projection, const glm::vec3& min, const glm::vec3& max) const {
+    using namespace occlusion_buffer_details;
+
+    glm::vec2 screen_min(std::numeric_limits<float>::max());
+    glm::vec2 screen_max(-std::numeric_limits<float>::max());
+    float nearest_depth = std::numeric_limits<float>::max();
+
+    for (size_t i = 0; i < 8; i++) {
+        const glm::vec4 clip_corner = view_projection * get_corner(min, max, i);
+        if (clip_corner.w < MIN_W) {
+            // Box crosses the near plane, so it's likely very close to the camera.
+            return true;
+        }
+
+        const float inverse_w = 1.f / clip_corner.w;
+        const glm::vec2 screen_corner((clip_corner.x * inverse_w * 0.5f + 0.5f) * m_width,
+                                      (clip_corner.y * inverse_w * 0.5f + 0.5f) * m_height);
+
+        screen_min = glm::min(screen_min, screen_corner);
+        screen_max = glm::max(screen_max, screen_corner);
+        nearest_depth = std::min(nearest_depth, clip_corner.z * inverse_w);
+    }
+
+    const auto first_column = static_cast<int32_t>(std::max(std::floor(screen_min.x), 0.f));
+    const auto last_column = static_cast<int32_t>(std::min(std::ceil(screen_max.x), static_cast<float>(m_width)));
+    const auto first_row = static_cast<int32_t>(std::max(std::floor(screen_min.y), 0.f));
+    const auto last_row = static_cast<int32_t>(std::min(std::ceil(screen_max.y), static_cast<float>(m_height)));
+
+    if (first_column >= last_column || first_row >= last_row) {
+        return false;
+    }
+
+    const bx::simd128_t depth = bx::simd_splat(nearest_depth);
+    const bx::simd128_t column_min = bx::simd_splat(static_cast<float>(first_column));
+    const bx::simd128_t column_max = bx::simd_splat(static_cast<float>(last_column));
+    const bx::simd128_t column_offset = bx::simd_ld(0.f, 1.f, 2.f, 3.f);
+
+    const uint32_t blocks_per_row = m_width / 4;
+    const auto first_block = static_cast<uint32_t>(first_column) / 4;
+    const auto last_block = (static_cast<uint32_t>(last_column) + 3) / 4;
+
+    for (auto row = static_cast<uint32_t>(first_row); row < static_cast<uint32_t>(last_row); row++) {
+        const Block* const blocks = m_blocks.data() + static_cast<size_t>(row) * blocks_per_row;
+        for (uint32_t block = first_block; block < last_block; block++) {
+            const bx::simd128_t column = bx::simd_add(bx::simd_splat(static_cast<float>(block * 4)), column_offset);
+            const bx::simd128_t column_mask = bx::simd_and(bx::simd_cmpge(column, column_min), bx::simd_cmplt(column, column_max));
+            const bx::simd128_t visible_mask = bx::simd_cmple(depth, bx::simd_ld(blocks[block].depth));
+            if (bx::simd_test_any_xyzw(bx::simd_and(column_mask, visible_mask))) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void OcclusionBuffer::rasterize_triangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, uint32_t first_row, uint32_t last_row) {
+    // Edge function of edge `from` -> `to` is `dx * x + dy * y + offset`, it's positive on one side of the edge.
+    auto get_edge = [](const glm::vec3& from, const glm::vec3& to, float& dx, float& dy, float& offset) {
+        dx = from.y - to.y;
+        dy = to.x - from.x;
+        offset = from.x * to.y - from.y * to.x;
+    };
+
+    float edge_dx[3], edge_dy[3], edge_offset[3];
+    get_edge(b, c, edge_dx[0], edge_dy[0], edge_offset[0]);
+    get_edge(c, a, edge_dx[1], edge_dy[1], edge_offset[1]);
+    get_edge(a, b, edge_dx[2], edge_dy[2], edge_offset[2]);
+
+    float area = edge_dx[2] * c.x + edge_dy[2] * c.y + edge_offset[2];
+    if (std::abs(area) < 1e-6f) {
+        return;
+    }
+
+    // Both front and back faces are rasterized, so flip the edges of back faces to keep inside positive.
+    if (area < 0.f) {
+        for (size_t i = 0; i < 3; i++) {
+            edge_dx[i] = -edge_dx[i];
+            edge_dy[i] = -edge_dy[i];
+            edge_offset[i] = -edge_offset[i];
+        }
+        area = -area;
+    }
+
+    // Depth is affine in screen space: depth = (e0 * a.z + e1 * b.z + e2 * c.z) / area.
+    const float inverse_area = 1.f / area;
+    const float depth_dx = (edge_dx[0] * a.z + edge_dx[1] * b.z + edge_dx[2] * c.z) * inverse_area;
+    const float depth_dy = (edge_dy[0] * a.z + edge_dy[1] * b.z + edge_dy[2] * c.z) * inverse_area;
+    const float depth_offset = (edge_offset[0] * a.z + edge_offset[1] * b.z + edge_offset[2] * c.z) * inverse_area;
+
+    const float min_x = std::min(std::min(a.x, b.x), c.x);
+    const float max_x = std::max(std::max(a.x, b.x), c.x);
+    const float min_y = std::min(std::min(a.y, b.y), c.y);
+    const float max_y = std::max(std::max(a.y, b.y), c.y);
+
+    const auto first_column = static_cast<int32_t>(std::max(std::floor(min_x), 0.f));
+    const auto last_column = static_cast<int32_t>(std::min(std::ceil(max_x), static_cast<float>(m_width)));
+    const auto first_triangle_row = static_cast<int32_t>(std::max(std::floor(min_y), static_cast<float>(first_row)));
+    const auto last_triangle_row = static_cast<int32_t>(std::min(std::ceil(max_y), static_cast<float>(last_row)));
+
+    if (first_column >= last_column || first_triangle_row >= last_triangle_row) {
+        return;
+    }
+
+    const bx::simd128_t zero = bx::simd_zero();
+    const bx::simd128_t column_offset = bx::simd_ld(0.5f, 1.5f, 2.5f, 3.5f);
+
+    bx::simd128_t simd_edge_dx[3];
+    bx::simd128_t simd_edge_dy[3];
+    bx::simd128_t simd_edge_offset[3];
+    for (size_t i = 0; i < 3; i++) {
+        simd_edge_dx[i] = bx::simd_splat(edge_dx[i]);
+        simd_edge_dy[i] = bx::simd_splat(edge_dy[i]);
+        simd_edge_offset[i] = bx::simd_splat(edge_offset[i]);
+    }
+
+    const bx::simd128_t simd_depth_dx = bx::simd_splat(depth_dx);
+    const bx::simd128_t simd_depth_dy = bx::simd_splat(depth_dy);
+    const bx::simd128_t simd_depth_offset = bx::simd_splat(depth_offset);
+
+    const uint32_t blocks_per_row = m_width / 4;
+    const auto first_block = static_cast<uint32_t>(first_column) / 4;
+    const auto last_block = (static_cast<uint32_t>(last_column) + 3) / 4;
+
+    for (auto row = static_cast<uint32_t>(first_triangle_row); row < static_cast<uint32_t>(last_triangle_row); row++) {
+        const bx::simd128_t y = bx::simd_splat(row + 0.5f);
+
+        bx::simd128_t row_edge[3];
+        for (size_t i = 0; i < 3; i++) {
+            row_edge[i] = bx::simd_madd(simd_edge_dy[i], y, simd_edge_offset[i]);
+        }
+        const bx::simd128_t row_depth = bx::simd_madd(simd_depth_dy, y, simd_depth_offset);
+
+        Block* const blocks = m_blocks.data() + static_cast<size_t>(row) * blocks_per_row;
+        for (uint32_t block = first_block; block < last_block; block++) {
+            const bx::simd128_t x = bx::simd_add(bx::simd_splat(static_cast<float>(block * 4)), column_offset);
+
+            const bx::simd128_t edge0 = bx::simd_madd(simd_edge_dx[0], x, row_edge[0]);
+            const bx::simd128_t edge1 = bx::simd_madd(simd_edge_dx[1], x, row_edge[1]);
+            const bx::simd128_t edge2 = bx::simd_madd(simd_edge_dx[2], x, row_edge[2]);
+            const bx::simd128_t inside_mask = bx::simd_and(bx::simd_cmpge(edge0, zero), bx::simd_and(bx::simd_cmpge(edge1, zero), bx::simd_cmpge(edge2, zero)));
+
+            if (bx::simd_test_any_xyzw(inside_mask)) {
+                const bx::simd128_t depth = bx::simd_madd(simd_depth_dx, x, row_depth);
+                const bx::simd128_t old_depth = bx::simd_ld(blocks[block].depth);
+                bx::simd_st(blocks[block].depth, bx::simd_selb(inside_mask, bx::simd_min(depth, old_depth), old_depth));
+            }
+        }
+    }
+}
+
+} // namespace hg
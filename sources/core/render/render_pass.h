@@ -16,7 +16,6 @@ enum RenderPass : bgfx::ViewId {
     DEBUG_DRAW_OFFSCREEN_PASS,
     DEBUG_DRAW_ONSCREEN_PASS,
     IMGUI_PASS,
-    PICKING_PASS,
     PICKING_BLIT_PASS,
 };
 
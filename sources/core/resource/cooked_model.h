@@ -0,0 +1,34 @@
+#pragma once
+
+#include "core/resource/model.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hg {
+
+/** Cooked model is a binary image of a `Model` that is ready to be uploaded to GPU: optimized and quantized vertex
+    buffers, 16-bit or 32-bit index buffers of each level of detail, the node table in preorder and the bounds. All
+    buffers are aligned, so the image can be memory mapped and handed to bgfx without any copies. Geometry is stored
+    once, the CPU copy of a primitive is decoded from its GPU buffers. */
+
+/** Cook the specified model. Primitives must contain CPU `vertices` and `indices` only, GPU buffers are ignored.
+    Vertex cache, overdraw and vertex fetch optimizations and level of detail generation happen here. `source_size`
+    and `source_time` identify the source file the model was imported from, see `is_cooked_model_up_to_date`. */
+std::vector<uint8_t> cook_model(const Model& model, uint64_t source_size, int64_t source_time);
+
+/** Return true if the specified image is a cooked model of the current version that was cooked from the source file
+    of the specified size and modification time. */
+bool is_cooked_model_up_to_date(const uint8_t* data, size_t size, uint64_t source_size, int64_t source_time);
+
+/** Decode the node hierarchy and the CPU copy of the geometry from the specified cooked model image without creating
+    GPU buffers, so it may be called from any thread. Return false if the image is corrupted. Meshes of a partially
+    decoded model must be destroyed by the caller. */
+bool decode_cooked_model(Model& result, const uint8_t* data, size_t size);
+
+/** Create GPU buffers of a model decoded by `decode_cooked_model` from the same image. GPU buffers reference the image
+    directly, so `owner` must own the image and it's kept alive until bgfx releases the last buffer. */
+void upload_cooked_model(Model& model, const uint8_t* data, const std::shared_ptr<const void>& owner);
+
+} // namespace hg
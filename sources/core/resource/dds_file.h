@@ -0,0 +1,39 @@
+#pragma once
+
+#include "core/resource/texture.h"
+
+#include <bgfx/bgfx.h>
+#include <string>
+#include <vector>
+
+namespace hg {
+
+/** `DdsFile` describes the mip chain of a 2D texture file without reading the image data, so that any part of the
+    chain can be read later. Mips are stored from the most detailed one, so mips from `first_mip` to the last one are
+    a contiguous range of the file. */
+class DdsFile final {
+public:
+    /** Read header of the specified file. Return false if the file can't be read or it's not a single 2D texture. */
+    bool open(const std::string& file_path);
+
+    /** Return size of mips from `first_mip` to the last one in bytes. */
+    uint32_t get_size(uint8_t first_mip) const;
+
+    /** Read mips from `first_mip` to the last one. Return an empty vector on failure. Thread safe. */
+    std::vector<uint8_t> read(uint8_t first_mip) const;
+
+    /** Create a texture from mips starting at `first_mip` previously read by `read`. */
+    Texture create(uint8_t first_mip, std::vector<uint8_t>&& data) const;
+
+    std::string path;
+    bgfx::TextureFormat::Enum format = bgfx::TextureFormat::Unknown;
+    uint16_t width   = 0;
+    uint16_t height  = 0;
+    uint8_t num_mips = 0;
+
+    /** Offset of each mip in the file and its size in bytes. */
+    std::vector<uint32_t> mip_offsets;
+    std::vector<uint32_t> mip_sizes;
+};
+
+} // namespace hg
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "core/resource/model.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace hg {
+
+/** Return indices of a simplified version of the specified triangle mesh with at most `target_num_indices` indices.
+    Edges are collapsed in order of quadric error. Vertices are never moved, so the result references the same vertex
+    buffer. Border and UV seam vertices are never removed. Collapses with error larger than `max_error`, measured in mesh
+    units, are not performed, so the result may have more indices than requested. */
+std::vector<uint32_t> simplify_mesh(const std::vector<Model::BasicModelVertex>& vertices, const std::vector<uint32_t>& indices,
+                                    size_t target_num_indices, float max_error);
+
+/** Reorder triangles for post-transform vertex cache locality using Tom Forsyth's linear-speed vertex cache
+    optimization. Vertices are not modified. */
+void optimize_vertex_cache(std::vector<uint32_t>& indices, size_t num_vertices);
+
+/** Reorder clusters of triangles so that the ones facing outwards from the mesh center are drawn first, which reduces
+    overdraw from any direction. Must be called after `optimize_vertex_cache`. Clusters are split only where average
+    cache miss ratio gets at most `threshold` times worse, so 1.05 keeps vertex cache efficiency within 5%. */
+void optimize_overdraw(const std::vector<Model::BasicModelVertex>& vertices, std::vector<uint32_t>& indices, float threshold);
+
+/** Reorder vertices in order of their first use by `indices` for vertex fetch locality, `indices` are remapped.
+    Vertices not referenced by `indices` are removed. */
+void optimize_vertex_fetch(std::vector<Model::BasicModelVertex>& vertices, std::vector<uint32_t>& indices);
+
+} // namespace hg
@@ -3,6 +3,7 @@
 #include <bgfx/bgfx.h>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 #include <limits>
 #include <memory>
 #include <string>
@@ -31,8 +32,36 @@ public:
         float v;
     };
 
+    /** `CompactModelVertex` is the GPU representation of `BasicModelVertex`, 20 bytes instead of 48. Position is
+        quantized to 16-bit snorm relative to the primitive bounds, see `Primitive::position_offset`. Position w
+        holds the tangent sign. Normal and tangent are octahedron encoded into 16-bit snorm pairs that share the
+        normal attribute. Texture coordinates are half floats. */
+    struct CompactModelVertex {
+        static const bgfx::VertexDecl DECLARATION;
+
+        int16_t x;
+        int16_t y;
+        int16_t z;
+        int16_t tangent_w;
+        int16_t normal_x;
+        int16_t normal_y;
+        int16_t tangent_x;
+        int16_t tangent_y;
+        uint16_t u;
+        uint16_t v;
+    };
+
+    /** `Lod` is a simplified index buffer of a primitive. It references the primitive's vertex buffer. */
+    struct Lod {
+        bgfx::IndexBufferHandle index_buffer = BGFX_INVALID_HANDLE;
+        size_t num_indices = 0;
+    };
+
     /** `Primitive` is a container for geometry data. All `Primitive` must be destroyed before `RenderFetchSystem`
-        destructor. */
+        destructor. Besides GPU buffers, `Primitive` keeps a CPU copy of its vertices and indices for CPU-side
+        queries like ray picking. `lods` contain progressively simplified versions of the primitive, the first level
+        of detail is the primitive itself. Vertex buffer contains `CompactModelVertex`, its positions are decoded
+        in vertex shaders as `position * position_scale + position_offset`. */
     struct Primitive {
         Primitive() = default;
         Primitive(const Primitive& another) = delete;
@@ -45,6 +74,14 @@ public:
         bgfx::VertexBufferHandle vertex_buffer = BGFX_INVALID_HANDLE;
         size_t num_vertices = 0;
         size_t num_indices  = 0;
+
+        glm::vec4 position_offset = glm::vec4(0.f);
+        glm::vec4 position_scale  = glm::vec4(1.f);
+
+        std::vector<BasicModelVertex> vertices;
+        std::vector<uint32_t> indices;
+
+        std::vector<Lod> lods;
     };
 
     /** `Mesh` is a container for geometry primitives. */
@@ -0,0 +1,487 @@
+#include "core/resource/cooked_model.h"
+#include "core/resource/mesh_optimizer.h"
+#include "core/resource/vertex_quantization.h"
+
+#include <algorithm>
+#include <bgfx/bgfx.h>
+#include <cstring>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <limits>
+#include <type_traits>
+
+namespace hg {
+
+namespace cooked_model_details {
+
+/** "HGMD" in little endian. */
+static const uint32_t MAGIC = 0x444D4748;
+
+/** Must be increased whenever the layout or the cooking algorithm changes, so stale cache files are cooked again. */
+static const uint32_t VERSION = 2;
+
+/** All tables and buffers are aligned to this value within the image. */
+static const uint64_t ALIGNMENT = 16;
+
+/** Primitives with fewer indices are not simplified. */
+static const size_t MIN_LOD_INDICES = 3 * 256;
+
+/** Maximum simplification error of each level of detail relative to the primitive size. */
+static const float LOD_ERRORS[] = { 0.005f, 0.01f, 0.02f };
+
+/** Level of detail is discarded when it has more than this fraction of the previous level indices. */
+static const float MIN_LOD_REDUCTION = 0.8f;
+
+/** Overdraw optimization may make vertex cache efficiency up to 5% worse. */
+static const float OVERDRAW_THRESHOLD = 1.05f;
+
+struct Header final {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t source_size;
+    int64_t source_time;
+    uint32_t num_nodes;
+    uint32_t num_primitives;
+    uint32_t num_lods;
+    uint32_t reserved;
+    uint64_t nodes_offset;
+    uint64_t primitives_offset;
+    uint64_t lods_offset;
+    float bounds[6];
+};
+
+/** Nodes are stored in preorder, children of a node immediately follow it. */
+struct NodeRecord final {
+    uint64_t name_offset;
+    uint32_t name_size;
+    uint32_t num_children;
+    float translation[3];
+    float rotation[4];
+    float scale[3];
+    uint32_t has_mesh;
+    uint32_t first_primitive;
+    uint32_t num_primitives;
+};
+
+/** Geometry is stored once in GPU format, the CPU copy is decoded from the same buffers. */
+struct PrimitiveRecord final {
+    float position_offset[4];
+    float position_scale[4];
+    uint64_t vertex_buffer_offset;
+    uint64_t index_buffer_offset;
+    uint32_t num_vertices;
+    uint32_t num_indices;
+    uint32_t is_index32;
+    uint32_t first_lod;
+    uint32_t num_lods;
+    uint32_t reserved;
+};
+
+struct LodRecord final {
+    uint64_t index_buffer_offset;
+    uint32_t num_indices;
+    uint32_t reserved;
+};
+
+static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<NodeRecord> &&
+              std::is_trivially_copyable_v<PrimitiveRecord> && std::is_trivially_copyable_v<LodRecord>,
+              "Cooked model records must be trivially copyable.");
+
+uint64_t align(uint64_t value) {
+    return (value + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+/** Tables are written after all buffers are cooked, so buffer offsets are relative to the data section first. */
+struct Writer final {
+    uint64_t write(const void* source, size_t size) {
+        const uint64_t offset = align(data.size());
+        data.resize(static_cast<size_t>(offset) + size);
+        if (size > 0) {
+            std::memcpy(data.data() + offset, source, size);
+        }
+        return offset;
+    }
+
+    uint64_t write_indices(const std::vector<uint32_t>& indices, bool is_index32) {
+        if (is_index32) {
+            return write(indices.data(), indices.size() * sizeof(uint32_t));
+        }
+
+        std::vector<uint16_t> indices16(indices.size());
+        for (size_t i = 0; i < indices.size(); i++) {
+            indices16[i] = uint16_t(indices[i]);
+        }
+        return write(indices16.data(), indices16.size() * sizeof(uint16_t));
+    }
+
+    std::vector<NodeRecord> nodes;
+    std::vector<PrimitiveRecord> primitives;
+    std::vector<LodRecord> lods;
+    std::vector<uint8_t> data;
+};
+
+void cook_primitive(Writer& writer, const Model::Primitive& primitive) {
+    std::vector<Model::BasicModelVertex> vertices = primitive.vertices;
+    std::vector<uint32_t> indices = primitive.indices;
+
+    optimize_vertex_cache(indices, vertices.size());
+    optimize_overdraw(vertices, indices, OVERDRAW_THRESHOLD);
+    optimize_vertex_fetch(vertices, indices);
+
+    const size_t num_vertices = vertices.size();
+    const bool is_index32 = num_vertices > std::numeric_limits<uint16_t>::max();
+
+    glm::vec4 position_offset;
+    glm::vec4 position_scale;
+    const std::vector<Model::CompactModelVertex> compact_vertices = quantize_vertices(vertices, position_offset, position_scale);
+
+    PrimitiveRecord record {};
+    for (glm::length_t i = 0; i < 4; i++) {
+        record.position_offset[i] = position_offset[i];
+        record.position_scale[i] = position_scale[i];
+    }
+    record.vertex_buffer_offset = writer.write(compact_vertices.data(), compact_vertices.size() * sizeof(Model::CompactModelVertex));
+    record.index_buffer_offset = writer.write_indices(indices, is_index32);
+    record.num_vertices = static_cast<uint32_t>(num_vertices);
+    record.num_indices = static_cast<uint32_t>(indices.size());
+    record.is_index32 = is_index32 ? 1 : 0;
+    record.first_lod = static_cast<uint32_t>(writer.lods.size());
+
+    if (indices.size() >= MIN_LOD_INDICES) {
+        glm::vec3 min(std::numeric_limits<float>::max());
+        glm::vec3 max(-std::numeric_limits<float>::max());
+        for (const Model::BasicModelVertex& vertex : vertices) {
+            min = glm::min(min, glm::vec3(vertex.x, vertex.y, vertex.z));
+            max = glm::max(max, glm::vec3(vertex.x, vertex.y, vertex.z));
+        }
+
+        const float size = glm::length(max - min);
+
+        // Each level is simplified from the previous one, so the error is accumulated along the chain.
+        std::vector<uint32_t> lod_indices = indices;
+        for (const float lod_error : LOD_ERRORS) {
+            std::vector<uint32_t> simplified_indices = simplify_mesh(vertices, lod_indices, lod_indices.size() / 6 * 3, size * lod_error);
+            if (simplified_indices.empty() || simplified_indices.size() > lod_indices.size() * MIN_LOD_REDUCTION) {
+                break;
+            }
+
+            lod_indices = std::move(simplified_indices);
+
+            // Vertices are shared with the full detail primitive, so only the triangle order is optimized.
+            optimize_vertex_cache(lod_indices, num_vertices);
+            optimize_overdraw(vertices, lod_indices, OVERDRAW_THRESHOLD);
+
+            LodRecord& lod = writer.lods.emplace_back();
+            lod.index_buffer_offset = writer.write_indices(lod_indices, is_index32);
+            lod.num_indices = static_cast<uint32_t>(lod_indices.size());
+            lod.reserved = 0;
+        }
+    }
+
+    record.num_lods = static_cast<uint32_t>(writer.lods.size()) - record.first_lod;
+    writer.primitives.push_back(record);
+}
+
+void cook_node(Writer& writer, const Model::Node& node) {
+    NodeRecord record {};
+    record.name_offset = writer.write(node.name.data(), node.name.size());
+    record.name_size = static_cast<uint32_t>(node.name.size());
+    record.num_children = static_cast<uint32_t>(node.children.size());
+    for (glm::length_t i = 0; i < 3; i++) {
+        record.translation[i] = node.translation[i];
+        record.scale[i] = node.scale[i];
+    }
+    record.rotation[0] = node.rotation.w;
+    record.rotation[1] = node.rotation.x;
+    record.rotation[2] = node.rotation.y;
+    record.rotation[3] = node.rotation.z;
+    record.has_mesh = node.mesh != nullptr ? 1 : 0;
+    record.first_primitive = static_cast<uint32_t>(writer.primitives.size());
+
+    if (node.mesh != nullptr) {
+        for (const Model::Primitive& primitive : node.mesh->primitives) {
+            cook_primitive(writer, primitive);
+        }
+    }
+
+    record.num_primitives = static_cast<uint32_t>(writer.primitives.size()) - record.first_primitive;
+    writer.nodes.push_back(record);
+
+    for (const Model::Node& child : node.children) {
+        cook_node(writer, child);
+    }
+}
+
+static void release_owner(void* /*data*/, void* user_data) {
+    delete static_cast<std::shared_ptr<const void>*>(user_data);
+}
+
+/** Decodes a cooked model image. All offsets and sizes are checked against the image before they're used. */
+struct Reader final {
+    bool is_range_valid(uint64_t offset, uint64_t range_size) const {
+        return offset % ALIGNMENT == 0 && offset <= size && range_size <= size - offset;
+    }
+
+    bool read_primitive(Model::Primitive& result, const PrimitiveRecord& record) const {
+        const uint64_t index_size = record.is_index32 != 0 ? sizeof(uint32_t) : sizeof(uint16_t);
+        if (!is_range_valid(record.vertex_buffer_offset, uint64_t(record.num_vertices) * sizeof(Model::CompactModelVertex)) ||
+            !is_range_valid(record.index_buffer_offset, uint64_t(record.num_indices) * index_size) ||
+            uint64_t(record.first_lod) + record.num_lods > header.num_lods) {
+            return false;
+        }
+
+        result.num_vertices = record.num_vertices;
+        result.num_indices = record.num_indices;
+        result.position_offset = glm::vec4(record.position_offset[0], record.position_offset[1], record.position_offset[2], record.position_offset[3]);
+        result.position_scale = glm::vec4(record.position_scale[0], record.position_scale[1], record.position_scale[2], record.position_scale[3]);
+
+        const auto* const vertices = reinterpret_cast<const Model::CompactModelVertex*>(data + record.vertex_buffer_offset);
+        result.vertices = dequantize_vertices(vertices, record.num_vertices, result.position_offset, result.position_scale);
+
+        result.indices.resize(record.num_indices);
+        if (record.is_index32 != 0) {
+            if (record.num_indices > 0) {
+                std::memcpy(result.indices.data(), data + record.index_buffer_offset, result.indices.size() * sizeof(uint32_t));
+            }
+        } else {
+            const auto* const indices = reinterpret_cast<const uint16_t*>(data + record.index_buffer_offset);
+            std::copy(indices, indices + record.num_indices, result.indices.begin());
+        }
+
+        // CPU-side queries index vertices directly, so a corrupted index must not get through.
+        for (const uint32_t index : result.indices) {
+            if (index >= record.num_vertices) {
+                return false;
+            }
+        }
+
+        for (uint32_t i = 0; i < record.num_lods; i++) {
+            const LodRecord& lod_record = lods[record.first_lod + i];
+            if (!is_range_valid(lod_record.index_buffer_offset, uint64_t(lod_record.num_indices) * index_size)) {
+                return false;
+            }
+
+            result.lods.emplace_back().num_indices = lod_record.num_indices;
+        }
+
+        return true;
+    }
+
+    bool read_node(Model::Node& result) {
+        // The node must be safe to destroy whenever reading fails.
+        result.mesh = nullptr;
+
+        if (node_index >= header.num_nodes) {
+            return false;
+        }
+
+        // Primitives are uploaded in the order they're read, so they must follow the node order.
+        const NodeRecord& record = nodes[node_index++];
+        if (!is_range_valid(record.name_offset, record.name_size) || record.first_primitive != primitive_index ||
+            uint64_t(record.first_primitive) + record.num_primitives > header.num_primitives) {
+            return false;
+        }
+
+        result.name.assign(reinterpret_cast<const char*>(data + record.name_offset), record.name_size);
+        result.translation = glm::vec3(record.translation[0], record.translation[1], record.translation[2]);
+        result.rotation = glm::quat(record.rotation[0], record.rotation[1], record.rotation[2], record.rotation[3]);
+        result.scale = glm::vec3(record.scale[0], record.scale[1], record.scale[2]);
+
+        primitive_index += record.num_primitives;
+
+        if (record.has_mesh != 0) {
+            result.mesh = new Model::Mesh();
+            result.mesh->primitives.reserve(record.num_primitives);
+            for (uint32_t i = 0; i < record.num_primitives; i++) {
+                if (!read_primitive(result.mesh->primitives.emplace_back(), primitives[record.first_primitive + i])) {
+                    return false;
+                }
+            }
+        } else if (record.num_primitives != 0) {
+            return false;
+        }
+
+        result.children.reserve(record.num_children);
+        for (uint32_t i = 0; i < record.num_children; i++) {
+            if (!read_node(result.children.emplace_back())) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    const uint8_t* data;
+    uint64_t size;
+
+    Header header {};
+    const NodeRecord* nodes = nullptr;
+    const PrimitiveRecord* primitives = nullptr;
+    const LodRecord* lods = nullptr;
+    uint32_t node_index = 0;
+    uint32_t primitive_index = 0;
+};
+
+/** Creates GPU buffers of a model decoded by `Reader`. The image is already validated, so nothing is checked here. */
+struct Uploader final {
+    const bgfx::Memory* make_reference(uint64_t offset, uint64_t range_size) const {
+        return bgfx::makeRef(data + offset, static_cast<uint32_t>(range_size), release_owner, new std::shared_ptr<const void>(owner));
+    }
+
+    void upload_primitive(Model::Primitive& result, const PrimitiveRecord& record) const {
+        const uint64_t index_size = record.is_index32 != 0 ? sizeof(uint32_t) : sizeof(uint16_t);
+        const uint16_t index_flags = record.is_index32 != 0 ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE;
+
+        result.vertex_buffer = bgfx::createVertexBuffer(make_reference(record.vertex_buffer_offset, uint64_t(record.num_vertices) * sizeof(Model::CompactModelVertex)),
+                                                        Model::CompactModelVertex::DECLARATION);
+        result.index_buffer = bgfx::createIndexBuffer(make_reference(record.index_buffer_offset, uint64_t(record.num_indices) * index_size), index_flags);
+
+        for (uint32_t i = 0; i < record.num_lods; i++) {
+            const LodRecord& lod_record = lods[record.first_lod + i];
+            result.lods[i].index_buffer = bgfx::createIndexBuffer(make_reference(lod_record.index_buffer_offset, uint64_t(lod_record.num_indices) * index_size), index_flags);
+        }
+    }
+
+    void upload_node(Model::Node& node) {
+        if (node.mesh != nullptr) {
+            for (Model::Primitive& primitive : node.mesh->primitives) {
+                upload_primitive(primitive, primitives[primitive_index++]);
+            }
+        }
+
+        for (Model::Node& child_node : node.children) {
+            upload_node(child_node);
+        }
+    }
+
+    const uint8_t* data;
+    const std::shared_ptr<const void>& owner;
+
+    const PrimitiveRecord* primitives = nullptr;
+    const LodRecord* lods = nullptr;
+    uint32_t primitive_index = 0;
+};
+
+} // namespace cooked_model_details
+
+std::vector<uint8_t> cook_model(const Model& model, uint64_t source_size, int64_t source_time) {
+    using namespace cooked_model_details;
+
+    Writer writer;
+    for (const Model::Node& node : model.children) {
+        cook_node(writer, node);
+    }
+
+    Header header {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.source_size = source_size;
+    header.source_time = source_time;
+    header.num_nodes = static_cast<uint32_t>(writer.nodes.size());
+    header.num_primitives = static_cast<uint32_t>(writer.primitives.size());
+    header.num_lods = static_cast<uint32_t>(writer.lods.size());
+    header.nodes_offset = align(sizeof(Header));
+    header.primitives_offset = align(header.nodes_offset + writer.nodes.size() * sizeof(NodeRecord));
+    header.lods_offset = align(header.primitives_offset + writer.primitives.size() * sizeof(PrimitiveRecord));
+    header.bounds[0] = model.bounds.min_x;
+    header.bounds[1] = model.bounds.min_y;
+    header.bounds[2] = model.bounds.min_z;
+    header.bounds[3] = model.bounds.max_x;
+    header.bounds[4] = model.bounds.max_y;
+    header.bounds[5] = model.bounds.max_z;
+
+    // Now that the table sizes are known, make buffer offsets absolute.
+    const uint64_t data_offset = align(header.lods_offset + writer.lods.size() * sizeof(LodRecord));
+    for (NodeRecord& node : writer.nodes) {
+        node.name_offset += data_offset;
+    }
+    for (PrimitiveRecord& primitive : writer.primitives) {
+        primitive.vertex_buffer_offset += data_offset;
+        primitive.index_buffer_offset += data_offset;
+    }
+    for (LodRecord& lod : writer.lods) {
+        lod.index_buffer_offset += data_offset;
+    }
+
+    std::vector<uint8_t> result(static_cast<size_t>(data_offset + writer.data.size()));
+    std::memcpy(result.data(), &header, sizeof(Header));
+    if (!writer.nodes.empty()) {
+        std::memcpy(result.data() + header.nodes_offset, writer.nodes.data(), writer.nodes.size() * sizeof(NodeRecord));
+    }
+    if (!writer.primitives.empty()) {
+        std::memcpy(result.data() + header.primitives_offset, writer.primitives.data(), writer.primitives.size() * sizeof(PrimitiveRecord));
+    }
+    if (!writer.lods.empty()) {
+        std::memcpy(result.data() + header.lods_offset, writer.lods.data(), writer.lods.size() * sizeof(LodRecord));
+    }
+    if (!writer.data.empty()) {
+        std::memcpy(result.data() + data_offset, writer.data.data(), writer.data.size());
+    }
+    return result;
+}
+
+bool is_cooked_model_up_to_date(const uint8_t* data, size_t size, uint64_t source_size, int64_t source_time) {
+    using namespace cooked_model_details;
+
+    if (data == nullptr || size < sizeof(Header)) {
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    return header.magic == MAGIC && header.version == VERSION && header.source_size == source_size && header.source_time == source_time;
+}
+
+bool decode_cooked_model(Model& result, const uint8_t* data, size_t size) {
+    using namespace cooked_model_details;
+
+    if (data == nullptr || size < sizeof(Header)) {
+        return false;
+    }
+
+    Reader reader { data, size };
+    std::memcpy(&reader.header, data, sizeof(Header));
+
+    const Header& header = reader.header;
+    if (header.magic != MAGIC || header.version != VERSION ||
+        !reader.is_range_valid(header.nodes_offset, uint64_t(header.num_nodes) * sizeof(NodeRecord)) ||
+        !reader.is_range_valid(header.primitives_offset, uint64_t(header.num_primitives) * sizeof(PrimitiveRecord)) ||
+        !reader.is_range_valid(header.lods_offset, uint64_t(header.num_lods) * sizeof(LodRecord))) {
+        return false;
+    }
+
+    reader.nodes = reinterpret_cast<const NodeRecord*>(data + header.nodes_offset);
+    reader.primitives = reinterpret_cast<const PrimitiveRecord*>(data + header.primitives_offset);
+    reader.lods = reinterpret_cast<const LodRecord*>(data + header.lods_offset);
+
+    while (reader.node_index < header.num_nodes) {
+        if (!reader.read_node(result.children.emplace_back())) {
+            return false;
+        }
+    }
+
+    result.bounds.min_x = header.bounds[0];
+    result.bounds.min_y = header.bounds[1];
+    result.bounds.min_z = header.bounds[2];
+    result.bounds.max_x = header.bounds[3];
+    result.bounds.max_y = header.bounds[4];
+    result.bounds.max_z = header.bounds[5];
+    return true;
+}
+
+void upload_cooked_model(Model& model, const uint8_t* data, const std::shared_ptr<const void>& owner) {
+    using namespace cooked_model_details;
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+
+    Uploader uploader { data, owner };
+    uploader.primitives = reinterpret_cast<const PrimitiveRecord*>(data + header.primitives_offset);
+    uploader.lods = reinterpret_cast<const LodRecord*>(data + header.lods_offset);
+
+    for (Model::Node& node : model.children) {
+        uploader.upload_node(node);
+    }
+}
+
+} // namespace hg
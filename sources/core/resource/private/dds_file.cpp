@@ -0,0 +1,106 @@
+#include "core/resource/dds_file.h"
+
+#include <algorithm>
+#include <bimg/bimg.h>
+#include <bx/file.h>
+#include <cassert>
+#include <numeric>
+
+namespace hg {
+
+namespace dds_file_details {
+
+static void release_data(void* /*data*/, void* user_data) {
+    delete static_cast<std::vector<uint8_t>*>(user_data);
+}
+
+} // namespace dds_file_details
+
+bool DdsFile::open(const std::string& file_path) {
+    bx::FileReader file_reader;
+    if (!bx::open(&file_reader, file_path.c_str())) {
+        return false;
+    }
+
+    const int64_t file_size = bx::getSize(&file_reader);
+
+    bimg::ImageContainer image {};
+    const bool is_parsed = bimg::imageParse(image, &file_reader, nullptr);
+    bx::close(&file_reader);
+
+    if (!is_parsed || image.m_cubeMap || image.m_depth != 1 || image.m_numLayers != 1 || image.m_numMips == 0 ||
+        image.m_width > UINT16_MAX || image.m_height > UINT16_MAX) {
+        return false;
+    }
+
+    path     = file_path;
+    format   = static_cast<bgfx::TextureFormat::Enum>(image.m_format);
+    width    = static_cast<uint16_t>(image.m_width);
+    height   = static_cast<uint16_t>(image.m_height);
+    num_mips = image.m_numMips;
+
+    mip_offsets.resize(num_mips);
+    mip_sizes.resize(num_mips);
+
+    uint32_t offset = image.m_offset;
+    for (uint8_t mip = 0; mip < num_mips; mip++) {
+        const auto mip_width  = static_cast<uint16_t>(std::max(width >> mip, 1));
+        const auto mip_height = static_cast<uint16_t>(std::max(height >> mip, 1));
+
+        mip_offsets[mip] = offset;
+        mip_sizes[mip]   = bimg::imageGetSize(nullptr, mip_width, mip_height, 1, false, false, 1, image.m_format);
+        offset += mip_sizes[mip];
+    }
+
+    // Mip chain must fit into the file, otherwise the layout is not the one this class expects.
+    return offset <= static_cast<uint64_t>(file_size);
+}
+
+uint32_t DdsFile::get_size(uint8_t first_mip) const {
+    assert(first_mip < num_mips);
+    return std::accumulate(mip_sizes.begin() + first_mip, mip_sizes.end(), uint32_t(0));
+}
+
+std::vector<uint8_t> DdsFile::read(uint8_t first_mip) const {
+    assert(first_mip < num_mips);
+
+    std::vector<uint8_t> result(get_size(first_mip));
+
+    bx::FileReader file_reader;
+    if (bx::open(&file_reader, path.c_str())) {
+        const auto size = static_cast<int32_t>(result.size());
+        if (bx::seek(&file_reader, mip_offsets[first_mip], bx::Whence::Begin) != mip_offsets[first_mip] ||
+            bx::read(&file_reader, result.data(), size) != size) {
+            result.clear();
+        }
+        bx::close(&file_reader);
+    } else {
+        result.clear();
+    }
+
+    return result;
+}
+
+Texture DdsFile::create(uint8_t first_mip, std::vector<uint8_t>&& data) const {
+    assert(first_mip < num_mips);
+    assert(data.size() == get_size(first_mip));
+
+    Texture result;
+
+    const auto mip_width  = static_cast<uint16_t>(std::max(width >> first_mip, 1));
+    const auto mip_height = static_cast<uint16_t>(std::max(height >> first_mip, 1));
+
+    // Data is released by bgfx once it's uploaded, there's no need to copy it.
+    auto* const data_ptr = new std::vector<uint8_t>(std::move(data));
+    const bgfx::Memory* memory = bgfx::makeRef(data_ptr->data(), static_cast<uint32_t>(data_ptr->size()), dds_file_details::release_data, data_ptr);
+
+    result.handle = bgfx::createTexture2D(mip_width, mip_height, num_mips - first_mip > 1, 1, format, BGFX_TEXTURE_NONE, memory);
+    if (bgfx::isValid(result.handle)) {
+        result.width  = mip_width;
+        result.height = mip_height;
+    }
+
+    return result;
+}
+
+} // namespace hg
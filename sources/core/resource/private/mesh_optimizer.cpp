@@ -0,0 +1,593 @@
+#include "core/resource/mesh_optimizer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+#include <limits>
+#include <unordered_map>
+
+namespace hg {
+
+namespace mesh_optimizer_details {
+
+/** `Quadric` is a symmetric 4x4 matrix, sum of squared distances to a set of planes. */
+struct Quadric final {
+    double xx = 0.0, xy = 0.0, xz = 0.0, xw = 0.0;
+    double yy = 0.0, yz = 0.0, yw = 0.0;
+    double zz = 0.0, zw = 0.0;
+    double ww = 0.0;
+
+    void add_plane(const glm::vec3& normal, float distance) {
+        const double a = normal.x, b = normal.y, c = normal.z, d = distance;
+        xx += a * a; xy += a * b; xz += a * c; xw += a * d;
+        yy += b * b; yz += b * c; yw += b * d;
+        zz += c * c; zw += c * d;
+        ww += d * d;
+    }
+
+    void add(const Quadric& another) {
+        xx += another.xx; xy += another.xy; xz += another.xz; xw += another.xw;
+        yy += another.yy; yz += another.yz; yw += another.yw;
+        zz += another.zz; zw += another.zw;
+        ww += another.ww;
+    }
+
+    double evaluate(const glm::vec3& point) const {
+        const double x = point.x, y = point.y, z = point.z;
+        const double result = xx * x * x + 2.0 * xy * x * y + 2.0 * xz * x * z + 2.0 * xw * x +
+                              yy * y * y + 2.0 * yz * y * z + 2.0 * yw * y +
+                              zz * z * z + 2.0 * zw * z +
+                              ww;
+        return std::max(result, 0.0);
+    }
+};
+
+/** Vertex cache optimization parameters from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation". */
+static const size_t VERTEX_CACHE_SIZE = 32;
+static const float CACHE_DECAY_POWER = 1.5f;
+static const float LAST_TRIANGLE_SCORE = 0.75f;
+static const float VALENCE_BOOST_SCALE = 2.f;
+static const float VALENCE_BOOST_POWER = 0.5f;
+
+/** Size of FIFO cache used to estimate cache misses, close to post-transform cache of common GPUs. */
+static const uint32_t SIMULATED_CACHE_SIZE = 16;
+
+struct Collapse final {
+    uint32_t from;
+    uint32_t to;
+    double error;
+};
+
+struct PositionHash final {
+    size_t operator()(const glm::vec3& position) const {
+        uint32_t bits[3];
+        std::memcpy(bits, &position, sizeof(bits));
+        return (bits[0] * 73856093U) ^ (bits[1] * 19349663U) ^ (bits[2] * 83492791U);
+    }
+};
+
+static glm::vec3 get_position(const Model::BasicModelVertex& vertex) {
+    return glm::vec3(vertex.x, vertex.y, vertex.z);
+}
+
+static glm::vec3 get_normal(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+    return glm::cross(b - a, c - a);
+}
+
+static float get_vertex_score(int32_t cache_position, uint32_t num_live_triangles) {
+    if (num_live_triangles == 0) {
+        // Vertices without triangles left don't affect the choice of the next triangle.
+        return -1.f;
+    }
+
+    float score = 0.f;
+    if (cache_position >= 0) {
+        if (cache_position < 3) {
+            // Vertices of the last triangle get a fixed score, otherwise strips would be preferred over fans.
+            score = LAST_TRIANGLE_SCORE;
+        } else {
+            const float scaler = 1.f / (VERTEX_CACHE_SIZE - 3);
+            score = std::pow(1.f - (cache_position - 3) * scaler, CACHE_DECAY_POWER);
+        }
+    }
+
+    // Vertices with few triangles left are preferred, so they leave the working set sooner.
+    return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(num_live_triangles), -VALENCE_BOOST_POWER);
+}
+
+/** Triangles of vertex `i` are stored in `vertex_triangles` in range [`triangle_offsets[i]`, `triangle_offsets[i + 1]`). */
+static void build_adjacency(const std::vector<uint32_t>& indices, size_t num_vertices,
+                            std::vector<uint32_t>& triangle_offsets, std::vector<uint32_t>& vertex_triangles) {
+    triangle_offsets.assign(num_vertices + 1, 0);
+    for (const uint32_t index : indices) {
+        triangle_offsets[index + 1]++;
+    }
+    for (size_t i = 0; i < num_vertices; i++) {
+        triangle_offsets[i + 1] += triangle_offsets[i];
+    }
+
+    vertex_triangles.resize(indices.size());
+
+    std::vector<uint32_t> next_offsets(triangle_offsets.begin(), triangle_offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++) {
+        vertex_triangles[next_offsets[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+}
+
+} // namespace mesh_optimizer_details
+
+std::vector<uint32_t> simplify_mesh(const std::vector<Model::BasicModelVertex>& vertices, const std::vector<uint32_t>& indices,
+                                    size_t target_num_indices, float max_error) {
+    using namespace mesh_optimizer_details;
+
+    assert(indices.size() % 3 == 0);
+
+    const size_t num_vertices = vertices.size();
+
+    std::vector<glm::vec3> positions(num_vertices);
+    for (size_t i = 0; i < num_vertices; i++) {
+        positions[i] = get_position(vertices[i]);
+    }
+
+    // Vertices that share position with other vertices lie on UV or normal seams. Removing them would tear the mesh.
+    std::vector<bool> is_locked(num_vertices, false);
+    {
+        std::unordered_map<glm::vec3, uint32_t, PositionHash> position_vertices;
+        position_vertices.reserve(num_vertices);
+
+        for (uint32_t i = 0; i < num_vertices; i++) {
+            auto [it, is_inserted] = position_vertices.emplace(positions[i], i);
+            if (!is_inserted) {
+                is_locked[it->second] = true;
+                is_locked[i] = true;
+            }
+        }
+    }
+
+    // Vertices on the mesh border are locked too, otherwise the silhouette would shrink.
+    {
+        std::vector<uint64_t> edges;
+        edges.reserve(indices.size());
+
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            for (size_t j = 0; j < 3; j++) {
+                const uint32_t a = indices[i + j];
+                const uint32_t b = indices[i + (j + 1) % 3];
+                edges.push_back((static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b));
+            }
+        }
+
+        std::sort(edges.begin(), edges.end());
+
+        for (size_t i = 0; i < edges.size();) {
+            size_t j = i + 1;
+            while (j < edges.size() && edges[j] == edges[i]) {
+                j++;
+            }
+            if (j - i == 1) {
+                is_locked[edges[i] >> 32] = true;
+                is_locked[edges[i] & 0xFFFFFFFF] = true;
+            }
+            i = j;
+        }
+    }
+
+    std::vector<Quadric> quadrics(num_vertices);
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        const glm::vec3& a = positions[indices[i + 0]];
+        const glm::vec3& b = positions[indices[i + 1]];
+        const glm::vec3& c = positions[indices[i + 2]];
+
+        const glm::vec3 normal = get_normal(a, b, c);
+        const float length = glm::length(normal);
+        if (length > 0.f) {
+            const glm::vec3 unit_normal = normal / length;
+            for (size_t j = 0; j < 3; j++) {
+                quadrics[indices[i + j]].add_plane(unit_normal, -glm::dot(unit_normal, a));
+            }
+        }
+    }
+
+    const double max_squared_error = static_cast<double>(max_error) * max_error;
+
+    std::vector<uint32_t> result = indices;
+    std::vector<uint32_t> remap(num_vertices);
+    std::vector<bool> is_touched(num_vertices);
+    std::vector<uint32_t> triangle_offsets;
+    std::vector<uint32_t> vertex_triangles;
+    std::vector<uint64_t> edges;
+    std::vector<Collapse> collapses;
+
+    while (result.size() > target_num_indices) {
+        build_adjacency(result, num_vertices, triangle_offsets, vertex_triangles);
+
+        // Find the cheapest direction of each edge collapse.
+        edges.clear();
+        for (size_t i = 0; i < result.size(); i += 3) {
+            for (size_t j = 0; j < 3; j++) {
+                const uint32_t a = result[i + j];
+                const uint32_t b = result[i + (j + 1) % 3];
+                edges.push_back((static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        collapses.clear();
+        for (const uint64_t edge : edges) {
+            const auto a = static_cast<uint32_t>(edge >> 32);
+            const auto b = static_cast<uint32_t>(edge & 0xFFFFFFFF);
+
+            Quadric quadric = quadrics[a];
+            quadric.add(quadrics[b]);
+
+            const double a_to_b_error = is_locked[a] ? std::numeric_limits<double>::max() : quadric.evaluate(positions[b]);
+            const double b_to_a_error = is_locked[b] ? std::numeric_limits<double>::max() : quadric.evaluate(positions[a]);
+
+            const double error = std::min(a_to_b_error, b_to_a_error);
+            if (error <= max_squared_error) {
+                if (a_to_b_error <= b_to_a_error) {
+                    collapses.push_back(Collapse{ a, b, error });
+                } else {
+                    collapses.push_back(Collapse{ b, a, error });
+                }
+            }
+        }
+
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& lhs, const Collapse& rhs) {
+            return lhs.error < rhs.error;
+        });
+
+        for (uint32_t i = 0; i < num_vertices; i++) {
+            remap[i] = i;
+        }
+        std::fill(is_touched.begin(), is_touched.end(), false);
+
+        const size_t num_triangles_to_remove = (result.size() - target_num_indices + 2) / 3;
+        size_t num_removed_triangles = 0;
+
+        for (const Collapse& collapse : collapses) {
+            if (is_touched[collapse.from] || is_touched[collapse.to]) {
+                continue;
+            }
+
+            const uint32_t* const first_triangle = vertex_triangles.data() + triangle_offsets[collapse.from];
+            const uint32_t* const last_triangle = vertex_triangles.data() + triangle_offsets[collapse.from + 1];
+
+            // Reject collapses that flip triangles or touch the vertices affected by other collapses in this pass.
+            bool is_valid = true;
+            size_t num_collapsed_triangles = 0;
+
+            for (const uint32_t* triangle = first_triangle; triangle != last_triangle && is_valid; triangle++) {
+                const uint32_t* const triangle_indices = result.data() + *triangle * 3;
+
+                glm::vec3 triangle_positions[3];
+                bool has_target = false;
+                for (size_t j = 0; j < 3; j++) {
+                    is_valid &= triangle_indices[j] == collapse.from || !is_touched[triangle_indices[j]];
+                    has_target |= triangle_indices[j] == collapse.to;
+                    triangle_positions[j] = positions[triangle_indices[j]];
+                }
+
+                if (has_target) {
+                    num_collapsed_triangles++;
+                    continue;
+                }
+
+                const glm::vec3 old_normal = get_normal(triangle_positions[0], triangle_positions[1], triangle_positions[2]);
+                for (size_t j = 0; j < 3; j++) {
+                    if (triangle_indices[j] == collapse.from) {
+                        triangle_positions[j] = positions[collapse.to];
+                    }
+                }
+                const glm::vec3 new_normal = get_normal(triangle_positions[0], triangle_positions[1], triangle_positions[2]);
+
+                is_valid &= glm::dot(old_normal, new_normal) > 0.f;
+            }
+
+            if (!is_valid) {
+                continue;
+            }
+
+            remap[collapse.from] = collapse.to;
+            quadrics[collapse.to].add(quadrics[collapse.from]);
+
+            for (const uint32_t* triangle = first_triangle; triangle != last_triangle; triangle++) {
+                for (size_t j = 0; j < 3; j++) {
+                    is_touched[result[*triangle * 3 + j]] = true;
+                }
+            }
+
+            num_removed_triangles += num_collapsed_triangles;
+            if (num_removed_triangles >= num_triangles_to_remove) {
+                break;
+            }
+        }
+
+        if (num_removed_triangles == 0) {
+            break;
+        }
+
+        size_t write_index = 0;
+        for (size_t i = 0; i < result.size(); i += 3) {
+            const uint32_t a = remap[result[i + 0]];
+            const uint32_t b = remap[result[i + 1]];
+            const uint32_t c = remap[result[i + 2]];
+
+            if (a != b && b != c && c != a) {
+                result[write_index++] = a;
+                result[write_index++] = b;
+                result[write_index++] = c;
+            }
+        }
+        result.resize(write_index);
+    }
+
+    return result;
+}
+
+void optimize_vertex_cache(std::vector<uint32_t>& indices, size_t num_vertices) {
+    using namespace mesh_optimizer_details;
+
+    assert(indices.size() % 3 == 0);
+
+    const size_t num_triangles = indices.size() / 3;
+    if (num_triangles == 0) {
+        return;
+    }
+
+    std::vector<uint32_t> triangle_offsets;
+    std::vector<uint32_t> vertex_triangles;
+    build_adjacency(indices, num_vertices, triangle_offsets, vertex_triangles);
+
+    // Live triangles of vertex `i` are kept in front of its adjacency range, emitted ones are swapped to the back.
+    std::vector<uint32_t> num_live_triangles(num_vertices);
+    std::vector<int32_t> cache_positions(num_vertices, -1);
+    std::vector<float> vertex_scores(num_vertices);
+    for (size_t i = 0; i < num_vertices; i++) {
+        num_live_triangles[i] = triangle_offsets[i + 1] - triangle_offsets[i];
+        vertex_scores[i] = get_vertex_score(-1, num_live_triangles[i]);
+    }
+
+    auto get_triangle_score = [&](uint32_t triangle) {
+        return vertex_scores[indices[triangle * 3 + 0]] + vertex_scores[indices[triangle * 3 + 1]] + vertex_scores[indices[triangle * 3 + 2]];
+    };
+
+    std::vector<bool> is_emitted(num_triangles, false);
+
+    uint32_t best_triangle = 0;
+    float best_score = get_triangle_score(0);
+    for (uint32_t i = 1; i < num_triangles; i++) {
+        const float score = get_triangle_score(i);
+        if (score > best_score) {
+            best_triangle = i;
+            best_score = score;
+        }
+    }
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+
+    // Three extra slots hold vertices that are pushed out of the cache by the emitted triangle.
+    uint32_t cache[VERTEX_CACHE_SIZE + 3];
+    uint32_t new_cache[VERTEX_CACHE_SIZE + 3];
+    size_t cache_size = 0;
+
+    size_t next_unemitted_triangle = 0;
+
+    while (result.size() < indices.size()) {
+        is_emitted[best_triangle] = true;
+
+        size_t new_cache_size = 0;
+        for (size_t i = 0; i < 3; i++) {
+            const uint32_t vertex = indices[best_triangle * 3 + i];
+            result.push_back(vertex);
+            new_cache[new_cache_size++] = vertex;
+
+            uint32_t* const first_triangle = vertex_triangles.data() + triangle_offsets[vertex];
+            uint32_t* const last_live_triangle = first_triangle + num_live_triangles[vertex];
+            std::swap(*std::find(first_triangle, last_live_triangle, best_triangle), *(last_live_triangle - 1));
+            num_live_triangles[vertex]--;
+        }
+
+        for (size_t i = 0; i < cache_size; i++) {
+            const uint32_t vertex = cache[i];
+            if (vertex != new_cache[0] && vertex != new_cache[1] && vertex != new_cache[2]) {
+                new_cache[new_cache_size++] = vertex;
+            }
+        }
+
+        for (size_t i = 0; i < new_cache_size; i++) {
+            const uint32_t vertex = new_cache[i];
+            cache_positions[vertex] = i < VERTEX_CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+            vertex_scores[vertex] = get_vertex_score(cache_positions[vertex], num_live_triangles[vertex]);
+        }
+
+        cache_size = std::min(new_cache_size, VERTEX_CACHE_SIZE);
+        std::copy(new_cache, new_cache + cache_size, cache);
+
+        // Only triangles of cached vertices change their score, the best one among them is usually the best overall.
+        bool has_best_triangle = false;
+        best_score = -std::numeric_limits<float>::max();
+        for (size_t i = 0; i < cache_size; i++) {
+            const uint32_t vertex = cache[i];
+            const uint32_t* const first_triangle = vertex_triangles.data() + triangle_offsets[vertex];
+            for (const uint32_t* triangle = first_triangle; triangle != first_triangle + num_live_triangles[vertex]; triangle++) {
+                const float score = get_triangle_score(*triangle);
+                if (score > best_score) {
+                    best_triangle = *triangle;
+                    best_score = score;
+                    has_best_triangle = true;
+                }
+            }
+        }
+
+        if (!has_best_triangle && result.size() < indices.size()) {
+            while (is_emitted[next_unemitted_triangle]) {
+                next_unemitted_triangle++;
+            }
+            best_triangle = static_cast<uint32_t>(next_unemitted_triangle);
+        }
+    }
+
+    indices = std::move(result);
+}
+
+void optimize_overdraw(const std::vector<Model::BasicModelVertex>& vertices, std::vector<uint32_t>& indices, float threshold) {
+    using namespace mesh_optimizer_details;
+
+    assert(indices.size() % 3 == 0);
+
+    const size_t num_triangles = indices.size() / 3;
+    if (num_triangles == 0) {
+        return;
+    }
+
+    // FIFO cache is simulated with timestamps: a vertex is cached if fewer than cache size vertices were loaded after it.
+    std::vector<uint32_t> cache_timestamps(vertices.size(), 0);
+    uint32_t timestamp = SIMULATED_CACHE_SIZE + 1;
+
+    auto reset_cache = [&] {
+        timestamp += SIMULATED_CACHE_SIZE + 1;
+    };
+
+    auto count_cache_misses = [&](size_t triangle) {
+        uint32_t result = 0;
+        for (size_t i = 0; i < 3; i++) {
+            const uint32_t vertex = indices[triangle * 3 + i];
+            if (timestamp - cache_timestamps[vertex] > SIMULATED_CACHE_SIZE) {
+                cache_timestamps[vertex] = timestamp++;
+                result++;
+            }
+        }
+        return result;
+    };
+
+    // Vertex cache optimizer restarts where all three vertices of a triangle are not cached. Triangles may be reordered
+    // freely between such points without hurting cache efficiency.
+    std::vector<size_t> hard_clusters;
+    for (size_t i = 0; i < num_triangles; i++) {
+        if (count_cache_misses(i) == 3) {
+            hard_clusters.push_back(i);
+        }
+    }
+    hard_clusters.push_back(num_triangles);
+
+    // Split large clusters further where average cache miss ratio of the cluster start doesn't get much worse.
+    std::vector<size_t> clusters;
+    for (size_t i = 0; i + 1 < hard_clusters.size(); i++) {
+        const size_t begin = hard_clusters[i];
+        const size_t end = hard_clusters[i + 1];
+
+        reset_cache();
+
+        uint32_t num_cluster_misses = 0;
+        for (size_t j = begin; j < end; j++) {
+            num_cluster_misses += count_cache_misses(j);
+        }
+
+        const float max_miss_ratio = static_cast<float>(num_cluster_misses) / (end - begin) * threshold;
+
+        reset_cache();
+
+        size_t soft_begin = begin;
+        uint32_t num_soft_misses = 0;
+        clusters.push_back(begin);
+
+        for (size_t j = begin; j + 1 < end; j++) {
+            num_soft_misses += count_cache_misses(j);
+            if (static_cast<float>(num_soft_misses) / (j + 1 - soft_begin) <= max_miss_ratio) {
+                soft_begin = j + 1;
+                num_soft_misses = 0;
+                clusters.push_back(soft_begin);
+                reset_cache();
+            }
+        }
+    }
+    clusters.push_back(num_triangles);
+
+    struct Cluster final {
+        size_t begin;
+        size_t end;
+        float sort_key;
+    };
+
+    std::vector<Cluster> sorted_clusters(clusters.size() - 1);
+    std::vector<glm::vec3> cluster_centroids(sorted_clusters.size());
+    std::vector<glm::vec3> cluster_normals(sorted_clusters.size());
+
+    glm::vec3 mesh_centroid(0.f);
+    float mesh_area = 0.f;
+
+    for (size_t i = 0; i < sorted_clusters.size(); i++) {
+        glm::vec3 centroid(0.f);
+        glm::vec3 normal(0.f);
+        float area = 0.f;
+
+        for (size_t j = clusters[i]; j < clusters[i + 1]; j++) {
+            const glm::vec3 a = get_position(vertices[indices[j * 3 + 0]]);
+            const glm::vec3 b = get_position(vertices[indices[j * 3 + 1]]);
+            const glm::vec3 c = get_position(vertices[indices[j * 3 + 2]]);
+
+            // Length of the cross product is twice the triangle area, so triangles are weighted by their area.
+            const glm::vec3 triangle_normal = get_normal(a, b, c);
+            const float triangle_area = glm::length(triangle_normal);
+
+            centroid += (a + b + c) * (triangle_area / 3.f);
+            normal += triangle_normal;
+            area += triangle_area;
+        }
+
+        mesh_centroid += centroid;
+        mesh_area += area;
+
+        cluster_centroids[i] = area > 0.f ? centroid / area : centroid;
+        cluster_normals[i] = glm::length(normal) > 0.f ? glm::normalize(normal) : normal;
+        sorted_clusters[i].begin = clusters[i];
+        sorted_clusters[i].end = clusters[i + 1];
+    }
+
+    if (mesh_area > 0.f) {
+        mesh_centroid /= mesh_area;
+    }
+
+    for (size_t i = 0; i < sorted_clusters.size(); i++) {
+        sorted_clusters[i].sort_key = glm::dot(cluster_centroids[i] - mesh_centroid, cluster_normals[i]);
+    }
+
+    // Clusters facing outwards are likely to occlude other clusters, so they are drawn first.
+    std::stable_sort(sorted_clusters.begin(), sorted_clusters.end(), [](const Cluster& lhs, const Cluster& rhs) {
+        return lhs.sort_key > rhs.sort_key;
+    });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+
+    for (const Cluster& cluster : sorted_clusters) {
+        result.insert(result.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+    }
+
+    indices = std::move(result);
+}
+
+void optimize_vertex_fetch(std::vector<Model::BasicModelVertex>& vertices, std::vector<uint32_t>& indices) {
+    std::vector<uint32_t> remap(vertices.size(), std::numeric_limits<uint32_t>::max());
+
+    std::vector<Model::BasicModelVertex> result;
+    result.reserve(vertices.size());
+
+    for (uint32_t& index : indices) {
+        if (remap[index] == std::numeric_limits<uint32_t>::max()) {
+            remap[index] = static_cast<uint32_t>(result.size());
+            result.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    vertices = std::move(result);
+}
+
+} // namespace hg
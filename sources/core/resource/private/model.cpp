@@ -13,11 +13,27 @@ const bgfx::VertexDecl Model::BasicModelVertex::DECLARATION = []{
     return result;
 }();
 
+const bgfx::VertexDecl Model::CompactModelVertex::DECLARATION = []{
+    bgfx::VertexDecl result;
+    result.begin()
+          .add(bgfx::Attrib::Position,  4, bgfx::AttribType::Int16, true)
+          .add(bgfx::Attrib::Normal,    4, bgfx::AttribType::Int16, true)
+          .add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Half)
+          .end();
+    return result;
+}();
+
 Model::Primitive::Primitive(Primitive&& another)
         : index_buffer(another.index_buffer)
         , vertex_buffer(another.vertex_buffer)
         , num_vertices(another.num_vertices)
-        , num_indices(another.num_indices) {
+        , num_indices(another.num_indices)
+        , position_offset(another.position_offset)
+        , position_scale(another.position_scale)
+        , vertices(std::move(another.vertices))
+        , indices(std::move(another.indices))
+        , lods(std::move(another.lods)) {
+    another.lods.clear();
     another.index_buffer  = BGFX_INVALID_HANDLE;
     another.vertex_buffer = BGFX_INVALID_HANDLE;
     another.num_vertices  = 0;
@@ -25,11 +41,17 @@ Model::Primitive::Primitive(Primitive&& another)
 }
 
 Model::Primitive& Model::Primitive::operator=(Primitive&& another) {
-    index_buffer  = another.index_buffer;
-    vertex_buffer = another.vertex_buffer;
-    num_vertices  = another.num_vertices;
-    num_indices   = another.num_indices;
+    index_buffer    = another.index_buffer;
+    vertex_buffer   = another.vertex_buffer;
+    num_vertices    = another.num_vertices;
+    num_indices     = another.num_indices;
+    position_offset = another.position_offset;
+    position_scale  = another.position_scale;
+    vertices        = std::move(another.vertices);
+    indices         = std::move(another.indices);
+    lods            = std::move(another.lods);
 
+    another.lods.clear();
     another.index_buffer  = BGFX_INVALID_HANDLE;
     another.vertex_buffer = BGFX_INVALID_HANDLE;
     another.num_vertices  = 0;
@@ -39,6 +61,12 @@ Model::Primitive& Model::Primitive::operator=(Primitive&& another) {
 }
 
 Model::Primitive::~Primitive() {
+    for (Lod& lod : lods) {
+        if (bgfx::isValid(lod.index_buffer)) {
+            bgfx::destroy(lod.index_buffer);
+        }
+    }
+
     if (bgfx::isValid(index_buffer)) {
         bgfx::destroy(index_buffer);
     }
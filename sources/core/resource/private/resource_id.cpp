@@ -0,0 +1,142 @@
+#include "core/resource/resource_id.h"
+
+#include <cassert>
+#include <cstring>
+#include <ghc/filesystem.hpp>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+namespace hg {
+
+namespace resource_id_details {
+
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+static const uint64_t FNV_PRIME = 1099511628211ull;
+
+/** Interned names are never removed, so references to them stay valid. Function local static allows creating
+    identifiers during static initialization. */
+struct InternTable final {
+    std::unordered_map<uint64_t, std::string> names;
+    std::mutex mutex;
+};
+
+InternTable& get_intern_table() {
+    static InternTable intern_table;
+    return intern_table;
+}
+
+uint64_t hash(uint64_t result, const char* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        result ^= static_cast<uint8_t>(data[i]);
+        result *= FNV_PRIME;
+    }
+    return result;
+}
+
+/** Return true if `lexically_normal` doesn't change the specified name, which is true for almost all names. */
+bool is_normal(const std::string& name) {
+    size_t segment_begin = 0;
+    for (size_t i = 0; i <= name.size(); i++) {
+        if (i == name.size() || name[i] == '/') {
+            const size_t segment_size = i - segment_begin;
+            if (segment_size == 0 ||
+                (segment_size == 1 && name[segment_begin] == '.') ||
+                (segment_size == 2 && name[segment_begin] == '.' && name[segment_begin + 1] == '.')) {
+                return false;
+            }
+            segment_begin = i + 1;
+        } else if (name[i] == '\\') {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Names are normalized with forward slashes, so identifiers don't depend on the platform. */
+std::string normalize(const std::string& name) {
+    return ghc::filesystem::path(name).lexically_normal().generic_string();
+}
+
+void intern(uint64_t hash, const std::string& prefix, const char* suffix, size_t suffix_size) {
+    InternTable& intern_table = get_intern_table();
+
+    std::lock_guard<std::mutex> guard(intern_table.mutex);
+    if (auto result = intern_table.names.find(hash); result != intern_table.names.end()) {
+        const std::string& name = result->second;
+        if (name.size() != prefix.size() + suffix_size ||
+            name.compare(0, prefix.size(), prefix) != 0 ||
+            name.compare(prefix.size(), suffix_size, suffix, suffix_size) != 0) {
+            std::cerr << "[RESOURCE] Resource names \"" << name << "\" and \"" << prefix << suffix << "\" have the same identifier." << std::endl;
+            assert(false);
+        }
+    } else {
+        std::string name;
+        name.reserve(prefix.size() + suffix_size);
+        name.append(prefix);
+        name.append(suffix, suffix_size);
+        intern_table.names.emplace(hash, std::move(name));
+    }
+}
+
+} // namespace resource_id_details
+
+ResourceId::ResourceId(const std::string& name)
+        : ResourceId(name, "") {
+}
+
+ResourceId::ResourceId(const std::string& prefix, const char* suffix) {
+    using namespace resource_id_details;
+
+    assert(suffix != nullptr && std::strchr(suffix, '/') == nullptr && std::strchr(suffix, '\\') == nullptr);
+
+    const size_t suffix_size = std::strlen(suffix);
+    if (prefix.empty() && suffix_size == 0) {
+        return;
+    }
+
+    auto create = [&](const std::string& normalized_prefix) {
+        m_hash = hash(hash(FNV_OFFSET_BASIS, normalized_prefix.data(), normalized_prefix.size()), suffix, suffix_size);
+        intern(m_hash, normalized_prefix, suffix, suffix_size);
+    };
+
+    if (is_normal(prefix)) {
+        create(prefix);
+    } else {
+        create(normalize(prefix));
+    }
+}
+
+const std::string& ResourceId::get_name() const {
+    using namespace resource_id_details;
+
+    static const std::string EMPTY_NAME;
+    if (m_hash == 0) {
+        return EMPTY_NAME;
+    }
+
+    InternTable& intern_table = get_intern_table();
+
+    std::lock_guard<std::mutex> guard(intern_table.mutex);
+    auto result = intern_table.names.find(m_hash);
+    assert(result != intern_table.names.end());
+    return result->second;
+}
+
+uint64_t ResourceId::get_hash() const {
+    return m_hash;
+}
+
+bool ResourceId::is_valid() const {
+    return m_hash != 0;
+}
+
+bool ResourceId::operator==(const ResourceId& another) const {
+    return m_hash == another.m_hash;
+}
+
+bool ResourceId::operator!=(const ResourceId& another) const {
+    return m_hash != another.m_hash;
+}
+
+} // namespace hg
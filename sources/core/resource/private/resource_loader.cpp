@@ -0,0 +1,193 @@
+#include "core/base/locked_output.h"
+#include "core/resource/resource_loader.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace hg {
+
+namespace resource_loader_details {
+
+/** Reading is bound by disk, more threads don't make it faster. */
+static const size_t NUM_READ_THREADS = 2;
+
+/** One hardware thread is left for the main thread. */
+size_t get_num_decode_threads() {
+    return std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t(2)) - 1;
+}
+
+} // namespace resource_loader_details
+
+ResourceLoader::ResourceLoader() {
+    using namespace resource_loader_details;
+
+    for (size_t i = 0; i < NUM_READ_THREADS; i++) {
+        m_threads.emplace_back(&ResourceLoader::read_thread, this);
+    }
+
+    const size_t num_decode_threads = get_num_decode_threads();
+    for (size_t i = 0; i < num_decode_threads; i++) {
+        m_threads.emplace_back(&ResourceLoader::decode_thread, this);
+    }
+}
+
+ResourceLoader::~ResourceLoader() {
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_is_stopped = true;
+    }
+
+    m_read_condition.notify_all();
+    m_decode_condition.notify_all();
+    m_upload_condition.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ResourceLoader::push(Job&& job) {
+    auto entry = std::make_unique<Entry>();
+    entry->job = std::move(job);
+
+    m_num_pending_jobs++;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_read_queue.push_back(std::move(entry));
+    }
+    m_read_condition.notify_one();
+}
+
+void ResourceLoader::upload(size_t budget) {
+    size_t uploaded = 0;
+    while (uploaded < budget) {
+        std::unique_ptr<Entry> entry;
+
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            if (m_upload_queue.empty()) {
+                return;
+            }
+
+            // The first job is uploaded even when it doesn't fit the budget.
+            if (uploaded > 0 && uploaded + m_upload_queue.front()->upload_size > budget) {
+                return;
+            }
+
+            entry = std::move(m_upload_queue.front());
+            m_upload_queue.pop_front();
+        }
+
+        uploaded += entry->upload_size;
+        upload_entry(*entry);
+    }
+}
+
+void ResourceLoader::finish() {
+    while (m_num_pending_jobs > 0) {
+        std::unique_ptr<Entry> entry;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_upload_condition.wait(lock, [this]() { return !m_upload_queue.empty(); });
+
+            entry = std::move(m_upload_queue.front());
+            m_upload_queue.pop_front();
+        }
+
+        upload_entry(*entry);
+    }
+}
+
+size_t ResourceLoader::get_num_pending_jobs() const {
+    return m_num_pending_jobs;
+}
+
+void ResourceLoader::read_thread() {
+    while (true) {
+        std::unique_ptr<Entry> entry;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_read_condition.wait(lock, [this]() { return m_is_stopped || !m_read_queue.empty(); });
+            if (m_is_stopped) {
+                return;
+            }
+
+            entry = std::move(m_read_queue.front());
+            m_read_queue.pop_front();
+        }
+
+        try {
+            if (entry->job.read) {
+                entry->job.read();
+            }
+        }
+        catch (const std::exception& error) {
+            LockedOutput(std::cerr) << "[RESOURCE] Failed to read \"" << entry->job.name << "\".\nDetails: " << error.what() << std::endl;
+            entry->is_failed = true;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            if (entry->is_failed) {
+                m_upload_queue.push_back(std::move(entry));
+            } else {
+                m_decode_queue.push_back(std::move(entry));
+            }
+        }
+        m_decode_condition.notify_one();
+        m_upload_condition.notify_one();
+    }
+}
+
+void ResourceLoader::decode_thread() {
+    while (true) {
+        std::unique_ptr<Entry> entry;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_decode_condition.wait(lock, [this]() { return m_is_stopped || !m_decode_queue.empty(); });
+            if (m_is_stopped) {
+                return;
+            }
+
+            entry = std::move(m_decode_queue.front());
+            m_decode_queue.pop_front();
+        }
+
+        try {
+            if (entry->job.decode) {
+                entry->upload_size = entry->job.decode();
+            }
+        }
+        catch (const std::exception& error) {
+            LockedOutput(std::cerr) << "[RESOURCE] Failed to decode \"" << entry->job.name << "\".\nDetails: " << error.what() << std::endl;
+            entry->is_failed = true;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_upload_queue.push_back(std::move(entry));
+        }
+        m_upload_condition.notify_one();
+    }
+}
+
+void ResourceLoader::upload_entry(Entry& entry) {
+    m_num_pending_jobs--;
+
+    if (entry.is_failed) {
+        if (entry.job.fail) {
+            entry.job.fail();
+        }
+    } else {
+        if (entry.job.upload) {
+            entry.job.upload();
+        }
+    }
+}
+
+} // namespace hg
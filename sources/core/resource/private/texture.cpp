@@ -12,10 +12,12 @@ Texture::Texture(Texture&& another)
         : handle(another.handle)
         , width(another.width)
         , height(another.height)
+        , num_layers(another.num_layers)
         , is_cube_map(another.is_cube_map) {
     another.handle      = BGFX_INVALID_HANDLE;
     another.width       = 0;
     another.height      = 0;
+    another.num_layers  = 1;
     another.is_cube_map = false;
 }
 
@@ -23,11 +25,13 @@ Texture& Texture::operator=(Texture&& another) {
     handle      = another.handle;
     width       = another.width;
     height      = another.height;
+    num_layers  = another.num_layers;
     is_cube_map = another.is_cube_map;
 
     another.handle       = BGFX_INVALID_HANDLE;
     another.width        = 0;
     another.height       = 0;
+    another.num_layers   = 1;
     another.is_cube_map  = false;
 
     return *this;
@@ -0,0 +1,135 @@
+#include "core/resource/vertex_quantization.h"
+
+#include <algorithm>
+#include <bx/uint32_t.h>
+#include <cmath>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <limits>
+
+namespace hg {
+
+namespace vertex_quantization_details {
+
+/** Scale of flat dimensions, prevents division by zero. */
+static const float MIN_POSITION_SCALE = 1e-6f;
+
+static int16_t quantize_snorm(float value) {
+    return static_cast<int16_t>(std::round(glm::clamp(value, -1.f, 1.f) * 32767.f));
+}
+
+/** Must match `decodeNormalOctahedron` from shaderlib.sh, except the result is in [-1, 1] range. */
+static glm::vec2 encode_octahedron(const glm::vec3& direction) {
+    const float length = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+    if (length == 0.f) {
+        return glm::vec2(0.f);
+    }
+
+    const glm::vec3 normalized = direction / length;
+    if (normalized.z >= 0.f) {
+        return glm::vec2(normalized.x, normalized.y);
+    }
+
+    return glm::vec2((1.f - std::abs(normalized.y)) * (normalized.x >= 0.f ? 1.f : -1.f),
+                     (1.f - std::abs(normalized.x)) * (normalized.y >= 0.f ? 1.f : -1.f));
+}
+
+static float dequantize_snorm(int16_t value) {
+    return std::max(value / 32767.f, -1.f);
+}
+
+/** Inverse of `encode_octahedron`. */
+static glm::vec3 decode_octahedron(const glm::vec2& encoded) {
+    glm::vec3 result(encoded.x, encoded.y, 1.f - std::abs(encoded.x) - std::abs(encoded.y));
+    if (result.z < 0.f) {
+        result.x = (1.f - std::abs(encoded.y)) * (encoded.x >= 0.f ? 1.f : -1.f);
+        result.y = (1.f - std::abs(encoded.x)) * (encoded.y >= 0.f ? 1.f : -1.f);
+    }
+    return glm::normalize(result);
+}
+
+} // namespace vertex_quantization_details
+
+std::vector<Model::CompactModelVertex> quantize_vertices(const std::vector<Model::BasicModelVertex>& vertices,
+                                                         glm::vec4& position_offset, glm::vec4& position_scale) {
+    using namespace vertex_quantization_details;
+
+    glm::vec3 min(std::numeric_limits<float>::max());
+    glm::vec3 max(-std::numeric_limits<float>::max());
+    for (const Model::BasicModelVertex& vertex : vertices) {
+        min = glm::min(min, glm::vec3(vertex.x, vertex.y, vertex.z));
+        max = glm::max(max, glm::vec3(vertex.x, vertex.y, vertex.z));
+    }
+
+    if (vertices.empty()) {
+        min = max = glm::vec3(0.f);
+    }
+
+    const glm::vec3 offset = (min + max) * 0.5f;
+    const glm::vec3 scale = glm::max((max - min) * 0.5f, glm::vec3(MIN_POSITION_SCALE));
+
+    position_offset = glm::vec4(offset, 0.f);
+    position_scale = glm::vec4(scale, 1.f);
+
+    std::vector<Model::CompactModelVertex> result(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const Model::BasicModelVertex& source = vertices[i];
+        Model::CompactModelVertex& target = result[i];
+
+        const glm::vec3 position = (glm::vec3(source.x, source.y, source.z) - offset) / scale;
+        target.x = quantize_snorm(position.x);
+        target.y = quantize_snorm(position.y);
+        target.z = quantize_snorm(position.z);
+        target.tangent_w = source.tangent_w < 0.f ? -32767 : 32767;
+
+        const glm::vec2 normal = encode_octahedron(glm::vec3(source.normal_x, source.normal_y, source.normal_z));
+        target.normal_x = quantize_snorm(normal.x);
+        target.normal_y = quantize_snorm(normal.y);
+
+        const glm::vec2 tangent = encode_octahedron(glm::vec3(source.tangent_x, source.tangent_y, source.tangent_z));
+        target.tangent_x = quantize_snorm(tangent.x);
+        target.tangent_y = quantize_snorm(tangent.y);
+
+        target.u = bx::halfFromFloat(source.u);
+        target.v = bx::halfFromFloat(source.v);
+    }
+
+    return result;
+}
+
+std::vector<Model::BasicModelVertex> dequantize_vertices(const Model::CompactModelVertex* vertices, size_t num_vertices,
+                                                         const glm::vec4& position_offset, const glm::vec4& position_scale) {
+    using namespace vertex_quantization_details;
+
+    std::vector<Model::BasicModelVertex> result(num_vertices);
+    for (size_t i = 0; i < num_vertices; i++) {
+        const Model::CompactModelVertex& source = vertices[i];
+        Model::BasicModelVertex& target = result[i];
+
+        const glm::vec3 position = glm::vec3(dequantize_snorm(source.x), dequantize_snorm(source.y), dequantize_snorm(source.z)) *
+                                   glm::vec3(position_scale) + glm::vec3(position_offset);
+        target.x = position.x;
+        target.y = position.y;
+        target.z = position.z;
+
+        const glm::vec3 normal = decode_octahedron(glm::vec2(dequantize_snorm(source.normal_x), dequantize_snorm(source.normal_y)));
+        target.normal_x = normal.x;
+        target.normal_y = normal.y;
+        target.normal_z = normal.z;
+
+        const glm::vec3 tangent = decode_octahedron(glm::vec2(dequantize_snorm(source.tangent_x), dequantize_snorm(source.tangent_y)));
+        target.tangent_x = tangent.x;
+        target.tangent_y = tangent.y;
+        target.tangent_z = tangent.z;
+        target.tangent_w = source.tangent_w < 0 ? -1.f : 1.f;
+
+        target.u = bx::halfToFloat(source.u);
+        target.v = bx::halfToFloat(source.v);
+    }
+
+    return result;
+}
+
+} // namespace hg
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace hg {
+
+/** `ResourceId` identifies a resource by a hash of its normalized name. The name is normalized and hashed once when
+    an identifier is created, so systems create identifiers once and look resources up without any string operations
+    or allocations. Names are interned, so the original name of any identifier is available for diagnostics. */
+class ResourceId final {
+public:
+    /** Invalid identifier that doesn't refer to any resource. */
+    ResourceId() = default;
+
+    /** Create an identifier of the specified resource name. */
+    explicit ResourceId(const std::string& name);
+
+    /** Create an identifier of the name composed of `prefix` and `suffix` without concatenating them, which is useful
+        for textures of materials like "material" and "_bcr.dds". `suffix` must not contain path separators. */
+    ResourceId(const std::string& prefix, const char* suffix);
+
+    /** Return the normalized name of this identifier or an empty string for invalid identifier. */
+    const std::string& get_name() const;
+
+    uint64_t get_hash() const;
+    bool is_valid() const;
+
+    bool operator==(const ResourceId& another) const;
+    bool operator!=(const ResourceId& another) const;
+
+private:
+    uint64_t m_hash = 0;
+};
+
+} // namespace hg
+
+namespace std {
+
+template <>
+struct hash<hg::ResourceId> {
+    size_t operator()(const hg::ResourceId& resource_id) const {
+        return static_cast<size_t>(resource_id.get_hash());
+    }
+};
+
+} // namespace std
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hg {
+
+/** `ResourceLoader` loads resources in three stages on persistent threads. `read` stage performs file I/O on I/O
+    threads, `decode` stage parses and converts the data on decode threads and `upload` stage creates GPU resources and
+    publishes the result on the thread calling `upload`. Stages of different jobs run concurrently regardless of their
+    resource type. Uploads are limited by a byte budget, so creating GPU resources doesn't stall a single frame. */
+class ResourceLoader final {
+public:
+    /** All stages are optional. `decode` returns the number of bytes `upload` passes to GPU. When `read` or `decode`
+        throws, the error is reported and `fail` is called instead of `upload`. */
+    struct Job final {
+        std::string name;
+        std::function<void()> read;
+        std::function<size_t()> decode;
+        std::function<void()> upload;
+        std::function<void()> fail;
+    };
+
+    ResourceLoader();
+    ResourceLoader(const ResourceLoader& another) = delete;
+    ResourceLoader& operator=(const ResourceLoader& another) = delete;
+
+    /** Jobs that are not uploaded yet are discarded, jobs that are being read or decoded are finished first. */
+    ~ResourceLoader();
+
+    void push(Job&& job);
+
+    /** Upload decoded jobs in order of completion until `budget` bytes are uploaded. At least one job is uploaded, so
+        a resource larger than the budget doesn't block the loader. */
+    void upload(size_t budget);
+
+    /** Wait until all pushed jobs are decoded and upload all of them regardless of budget. */
+    void finish();
+
+    /** Return the number of jobs that were pushed, but not uploaded yet. */
+    size_t get_num_pending_jobs() const;
+
+private:
+    struct Entry final {
+        Job job;
+        size_t upload_size = 0;
+        bool is_failed = false;
+    };
+
+    void read_thread();
+    void decode_thread();
+    void upload_entry(Entry& entry);
+
+    std::deque<std::unique_ptr<Entry>> m_read_queue;
+    std::deque<std::unique_ptr<Entry>> m_decode_queue;
+    std::deque<std::unique_ptr<Entry>> m_upload_queue;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_read_condition;
+    std::condition_variable m_decode_condition;
+    std::condition_variable m_upload_condition;
+
+    std::vector<std::thread> m_threads;
+    std::atomic<size_t> m_num_pending_jobs = 0;
+    bool m_is_stopped = false;
+};
+
+} // namespace hg
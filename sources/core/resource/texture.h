@@ -4,8 +4,8 @@
 
 namespace hg {
 
-/** `Texture` is an image with certain number of channels and size power of two.
-    All `Texture` instances must be destroyed before `RenderFetchSystem` destructor. */
+/** `Texture` is an image with certain number of channels and size power of two. Texture with more than one layer is
+    a 2D texture array. All `Texture` instances must be destroyed before `RenderFetchSystem` destructor. */
 class Texture {
 public:
     Texture() = default;
@@ -16,9 +16,10 @@ public:
     Texture& operator=(Texture&& another);
 
     bgfx::TextureHandle handle = BGFX_INVALID_HANDLE;
-    uint16_t width   = 0;
-    uint16_t height  = 0;
-    bool is_cube_map = false;
+    uint16_t width      = 0;
+    uint16_t height     = 0;
+    uint16_t num_layers = 1;
+    bool is_cube_map    = false;
 };
 
 } // namespace hg
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "core/resource/model.h"
+
+#include <glm/vec4.hpp>
+#include <vector>
+
+namespace hg {
+
+/** Convert vertices to `Model::CompactModelVertex`. Positions are quantized relative to the bounds of `vertices`,
+    parameters to decode them are written to `position_offset` and `position_scale`. */
+std::vector<Model::CompactModelVertex> quantize_vertices(const std::vector<Model::BasicModelVertex>& vertices,
+                                                         glm::vec4& position_offset, glm::vec4& position_scale);
+
+/** Convert vertices back to `Model::BasicModelVertex`. The result matches what vertex shaders decode, so the precision
+    lost in quantization is not restored. */
+std::vector<Model::BasicModelVertex> dequantize_vertices(const Model::CompactModelVertex* vertices, size_t num_vertices,
+                                                         const glm::vec4& position_offset, const glm::vec4& position_scale);
+
+} // namespace hg
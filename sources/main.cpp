@@ -2,10 +2,16 @@
 #include "world/editor/editor_tags.h"
 #include "world/imgui/imgui_tags.h"
 #include "world/physics/physics_tags.h"
+#include "world/render/dynamic_resolution_single_component.h"
+#include "world/render/render_single_component.h"
 #include "world/render/render_tags.h"
+#include "world/render/texture_streaming_single_component.h"
+#include "world/shared/frame_pacing_single_component.h"
 #include "world/shared/level_single_component.h"
+#include "world/shared/resource_loading_single_component.h"
 
 #include <SDL2/SDL_messagebox.h>
+#include <algorithm>
 #include <chrono>
 #include <clara.hpp>
 #include <fmt/format.h>
@@ -24,10 +30,32 @@ int main(int argc, char* argv[]) {
     hg::register_components();
 
     try {
-        bool is_editor         = false;
-        std::string level_file = "default.yaml";
+        bool is_editor          = false;
+        bool no_render_thread   = false;
+        bool no_vsync           = false;
+        bool no_idle            = false;
+        bool is_uncapped        = false;
+        bool texture_arrays     = false;
+        bool no_streaming       = false;
+        uint32_t texture_budget = 256;
+        uint32_t upload_budget  = 32;
+        uint32_t target_fps     = 0;
+        float min_resolution    = 50.f;
+        float max_resolution    = 100.f;
+        std::string level_file  = "default.yaml";
 
         auto cli = clara::Opt(is_editor)["--editor"]("Run level editor") |
+                   clara::Opt(no_render_thread)["--no-render-thread"]("Render on the main thread, one frame less latency") |
+                   clara::Opt(target_fps, "fps")["--fps"]("Limit frame rate, 0 means uncapped") |
+                   clara::Opt(no_vsync)["--no-vsync"]("Disable vertical synchronization") |
+                   clara::Opt(no_idle)["--no-idle"]("Keep rendering when nothing changes in the editor") |
+                   clara::Opt(is_uncapped)["--uncapped"]("Render as fast as possible for benchmarks, same as --fps 0 --no-vsync --no-idle") |
+                   clara::Opt(min_resolution, "percent")["--min-resolution"]("Minimum dynamic resolution in percent of the window size") |
+                   clara::Opt(max_resolution, "percent")["--max-resolution"]("Maximum dynamic resolution in percent of the window size") |
+                   clara::Opt(texture_arrays)["--texture-arrays"]("Pack material textures of the same size and format into texture arrays") |
+                   clara::Opt(no_streaming)["--no-texture-streaming"]("Load all texture mips at startup") |
+                   clara::Opt(texture_budget, "megabytes")["--texture-budget"]("Video memory budget for streamed textures") |
+                   clara::Opt(upload_budget, "megabytes")["--upload-budget"]("Resource data passed to GPU per frame while loading") |
                    clara::Opt(level_file, "default.yaml")["--level"]("Level file to play/edit");
         if (auto result = cli.parse(clara::Args(argc, argv)); !result) {
             const std::string error_description = fmt::format("Error in command line: {}", result.errorMessage());
@@ -43,6 +71,26 @@ int main(int argc, char* argv[]) {
         auto& level_single_component = world.set<hg::LevelSingleComponent>();
         level_single_component.level_name = level_file;
 
+        auto& render_single_component = world.set<hg::RenderSingleComponent>();
+        render_single_component.is_render_thread_enabled = !no_render_thread;
+        render_single_component.is_texture_array_enabled = texture_arrays;
+
+        auto& frame_pacing_single_component = world.set<hg::FramePacingSingleComponent>();
+        frame_pacing_single_component.target_fps       = is_uncapped ? 0 : target_fps;
+        frame_pacing_single_component.is_vsync_enabled = !no_vsync && !is_uncapped;
+        frame_pacing_single_component.is_idle_enabled  = !no_idle && !is_uncapped;
+
+        auto& dynamic_resolution_single_component = world.set<hg::DynamicResolutionSingleComponent>();
+        dynamic_resolution_single_component.max_scale = std::max(max_resolution, 1.f) / 100.f;
+        dynamic_resolution_single_component.min_scale = std::clamp(min_resolution / 100.f, 0.01f, dynamic_resolution_single_component.max_scale);
+
+        auto& texture_streaming_single_component = world.set<hg::TextureStreamingSingleComponent>();
+        texture_streaming_single_component.is_enabled = !no_streaming;
+        texture_streaming_single_component.budget     = texture_budget;
+
+        auto& resource_loading_single_component = world.set<hg::ResourceLoadingSingleComponent>();
+        resource_loading_single_component.upload_budget = upload_budget;
+
         std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now();
         while (true) {
             std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
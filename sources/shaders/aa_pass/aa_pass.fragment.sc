@@ -6,6 +6,7 @@ $input v_texcoord0
 SAMPLER2D(s_texture, 0);
 
 uniform vec4 u_pixel_size;
+uniform vec4 u_uv_scale;
 
 #define EDGE_THRESHOLD_MIN 0.0312
 #define EDGE_THRESHOLD_MAX 0.125
@@ -19,7 +20,7 @@ float rgb2luma(vec3 rgb) {
 
 /* FXAA as described in the Nvidia FXAA 3.11 white paper. */
 void main() {
-    vec2 uv = to_uv(v_texcoord0);
+    vec2 uv = to_uv(v_texcoord0 * u_uv_scale.xy);
     vec3 color = texture2D(s_texture, uv).rgb;
 
     float luma       = rgb2luma(color);
@@ -1,12 +1,21 @@
-$input a_position, a_normal, a_tangent, a_texcoord0
+$input a_position, a_normal, a_texcoord0
 $output v_normal, v_tangent, v_bitangent, v_texcoord0, v_position
 
 #include <bgfx_shader.sh>
+#include <shaderlib.sh>
+#include <shader_utils.sh>
+
+uniform vec4 u_position_offset;
+uniform vec4 u_position_scale;
 
 void main() {
-    v_normal    = normalize(mul(u_model[0], vec4(a_normal.xyz,  0.0)).xyz);
-    v_tangent   = normalize(mul(u_model[0], vec4(a_tangent.xyz, 0.0)).xyz);
-    v_bitangent = cross(v_normal, v_tangent) * a_tangent.w;
+    vec3 position = decode_position(a_position, u_position_offset, u_position_scale);
+    vec3 normal   = decode_octahedron(a_normal.xy);
+    vec3 tangent  = decode_octahedron(a_normal.zw);
+
+    v_normal    = normalize(mul(u_model[0], vec4(normal,  0.0)).xyz);
+    v_tangent   = normalize(mul(u_model[0], vec4(tangent, 0.0)).xyz);
+    v_bitangent = cross(v_normal, v_tangent) * a_position.w;
 
     #if BGFX_SHADER_LANGUAGE_HLSL || BGFX_SHADER_LANGUAGE_PSSL || BGFX_SHADER_LANGUAGE_METAL
     // DirectX & Metal treats vec3 as row vectors.
@@ -20,20 +29,21 @@ void main() {
     float scale_y = length(model_matrix[1].xyz);
     float scale_z = length(model_matrix[2].xyz);
 
-    if (a_normal.x == 1.0) {
+    // Quantized normals are not exactly axis aligned.
+    if (normal.x > 0.99) {
         v_texcoord0 = vec2(a_texcoord0.x * scale_z, (a_texcoord0.y - 1.0) * scale_y);
-    } else if (a_normal.x == -1.0) {
+    } else if (normal.x < -0.99) {
         v_texcoord0 = vec2((a_texcoord0.x - 1.0) * scale_z, (a_texcoord0.y - 1.0) * scale_y);
-    } else if (a_normal.y == 1.0) {
+    } else if (normal.y > 0.99) {
         v_texcoord0 = vec2((a_texcoord0.x - 1.0) * scale_x, (a_texcoord0.y - 1.0) * scale_z);
-    } else if (a_normal.y == -1.0) {
+    } else if (normal.y < -0.99) {
         v_texcoord0 = vec2(a_texcoord0.x * scale_x, (a_texcoord0.y - 1.0) * scale_z);
-    } else if (a_normal.z == 1.0) {
+    } else if (normal.z > 0.99) {
         v_texcoord0 = vec2(a_texcoord0.x * scale_x, (a_texcoord0.y - 1.0) * scale_y);
     } else {
         v_texcoord0 = vec2((a_texcoord0.x - 1.0) * scale_x, (a_texcoord0.y - 1.0) * scale_y);
     }
 
-    gl_Position = mul(u_modelViewProj, vec4(a_position, 1.0));
+    gl_Position = mul(u_modelViewProj, vec4(position, 1.0));
     v_position  = gl_Position;
 }
@@ -4,7 +4,6 @@ vec3 v_bitangent : BINORMAL  = vec3(0.0, 0.0, 1.0);
 vec2 v_texcoord0 : TEXCOORD0 = vec2(0.0, 0.0);
 vec4 v_position  : POSITION1 = vec4(0.0, 0.0, 0.0, 1.0);
 
-vec3 a_position  : POSITION;
-vec3 a_normal    : NORMAL;
-vec4 a_tangent   : TANGENT;
+vec4 a_position  : POSITION;
+vec4 a_normal    : NORMAL;
 vec2 a_texcoord0 : TEXCOORD0;
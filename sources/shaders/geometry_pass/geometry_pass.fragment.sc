@@ -7,6 +7,8 @@ $input v_normal, v_tangent, v_bitangent, v_texcoord0, v_position
 SAMPLER2D(s_color_roughness, 0);
 SAMPLER2D(s_normal_metal_ao, 1);
 
+uniform vec4 u_entity;
+
 void main() {
     #if BGFX_SHADER_LANGUAGE_HLSL || BGFX_SHADER_LANGUAGE_PSSL || BGFX_SHADER_LANGUAGE_METAL
     // DirectX & Metal treats vec3 as row vectors.
@@ -28,4 +30,5 @@ void main() {
     gl_FragData[0] = texture2D(s_color_roughness, v_texcoord0);
     gl_FragData[1] = vec4(encodeNormalOctahedron(normal), normal_metal_ao.zw);
     gl_FragData[2] = vec4(depth_out, 0.0, 0.0, 1.0);
+    gl_FragData[3] = u_entity;
 }
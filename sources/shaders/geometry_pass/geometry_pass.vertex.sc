@@ -1,13 +1,22 @@
-$input a_position, a_normal, a_tangent, a_texcoord0
+$input a_position, a_normal, a_texcoord0
 $output v_normal, v_tangent, v_bitangent, v_texcoord0, v_position
 
 #include <bgfx_shader.sh>
+#include <shaderlib.sh>
+#include <shader_utils.sh>
+
+uniform vec4 u_position_offset;
+uniform vec4 u_position_scale;
 
 void main() {
-    v_normal    = normalize(mul(u_model[0], vec4(a_normal.xyz,  0.0)).xyz);
-    v_tangent   = normalize(mul(u_model[0], vec4(a_tangent.xyz, 0.0)).xyz);
-    v_bitangent = cross(v_normal, v_tangent) * a_tangent.w;
+    vec3 position = decode_position(a_position, u_position_offset, u_position_scale);
+    vec3 normal   = decode_octahedron(a_normal.xy);
+    vec3 tangent  = decode_octahedron(a_normal.zw);
+
+    v_normal    = normalize(mul(u_model[0], vec4(normal,  0.0)).xyz);
+    v_tangent   = normalize(mul(u_model[0], vec4(tangent, 0.0)).xyz);
+    v_bitangent = cross(v_normal, v_tangent) * a_position.w;
     v_texcoord0 = a_texcoord0;
-    gl_Position = mul(u_modelViewProj, vec4(a_position, 1.0));
+    gl_Position = mul(u_modelViewProj, vec4(position, 1.0));
     v_position  = gl_Position;
 }
@@ -123,4 +123,14 @@ vec2 to_uv(vec2 uv) {
     return to_uv(uv.x, uv.y);
 }
 
+// Decode position of `CompactModelVertex` quantized relative to the primitive bounds.
+vec3 decode_position(vec4 position, vec4 offset, vec4 scale) {
+    return position.xyz * scale.xyz + offset.xyz;
+}
+
+// Decode octahedron encoded direction in [-1, 1] range. Requires shaderlib.sh.
+vec3 decode_octahedron(vec2 direction) {
+    return decodeNormalOctahedron(direction * 0.5 + 0.5);
+}
+
 #endif // SHADER_UTILS_H_HEADER_GUARD
@@ -14,9 +14,12 @@ SAMPLER2D(s_skybox_lut,          5);
 uniform vec4 u_light_color;
 uniform vec4 u_light_position;
 uniform vec4 u_mip_prefilter_max;
+uniform vec4 u_uv_scale;
 
 void main() {
-    vec2 uv = to_uv(v_texcoord0);
+    // G-buffer is rendered to the `u_uv_scale` part of the textures.
+    vec2 screen_uv = to_uv(v_texcoord0);
+    vec2 uv = to_uv(v_texcoord0 * u_uv_scale.xy);
     vec4 color_roughness = texture2D(s_color_roughness, uv);
     vec3 color = toLinear(color_roughness.xyz);
     float roughness = color_roughness.w;
@@ -27,7 +30,7 @@ void main() {
     float ao = normal_metal_ao.w;
 
     float clip_depth = texture2D(s_depth, uv).x;
-    vec3 clip_position = to_clip_space_position(vec3(uv * 2.0 - 1.0, clip_depth));
+    vec3 clip_position = to_clip_space_position(vec3(screen_uv * 2.0 - 1.0, clip_depth));
     vec3 world_position = to_world_space_position(clip_position);
     vec3 camera_position = mul(u_invView, vec4(0.0, 0.0, 0.0, 1.0)).xyz;
     vec3 camera_dir = normalize(camera_position.xyz - world_position);
@@ -1,7 +1,13 @@
-$input a_position, a_normal, a_tangent, a_texcoord0
+$input a_position, a_normal, a_texcoord0
 
 #include <bgfx_shader.sh>
+#include <shaderlib.sh>
+#include <shader_utils.sh>
+
+uniform vec4 u_position_offset;
+uniform vec4 u_position_scale;
 
 void main() {
-    gl_Position = mul(u_modelViewProj, vec4(a_position, 1.0));
+    vec3 position = decode_position(a_position, u_position_offset, u_position_scale);
+    gl_Position = mul(u_modelViewProj, vec4(position, 1.0));
 }
@@ -1,4 +1,3 @@
-vec3 a_position  : POSITION;
-vec3 a_normal    : NORMAL;
-vec4 a_tangent   : TANGENT;
+vec4 a_position  : POSITION;
+vec4 a_normal    : NORMAL;
 vec2 a_texcoord0 : TEXCOORD0;
@@ -1,4 +0,0 @@
-vec3 a_position  : POSITION;
-vec3 a_normal    : NORMAL;
-vec4 a_tangent   : TANGENT;
-vec2 a_texcoord0 : TEXCOORD0;
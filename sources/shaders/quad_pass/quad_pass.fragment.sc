@@ -5,6 +5,8 @@ $input v_texcoord0
 
 SAMPLER2D(s_texture, 0);
 
+uniform vec4 u_uv_scale;
+
 void main() {
-    gl_FragColor = texture2D(s_texture, to_uv(v_texcoord0));
+    gl_FragColor = texture2D(s_texture, to_uv(v_texcoord0 * u_uv_scale.xy));
 }
@@ -16,9 +16,11 @@
 #include "world/physics/physics_static_rigid_body_component.h"
 #include "world/physics/physics_static_rigid_body_private_component.h"
 #include "world/render/aa_pass_single_component.h"
+#include "world/render/aabb_tree_single_component.h"
 #include "world/render/blockout_component.h"
 #include "world/render/camera_single_component.h"
 #include "world/render/debug_draw_pass_single_component.h"
+#include "world/render/dynamic_resolution_single_component.h"
 #include "world/render/geometry_pass_single_component.h"
 #include "world/render/hdr_pass_single_component.h"
 #include "world/render/light_component.h"
@@ -26,17 +28,23 @@
 #include "world/render/material_component.h"
 #include "world/render/model_component.h"
 #include "world/render/model_single_component.h"
+#include "world/render/occlusion_culling_single_component.h"
 #include "world/render/outline_component.h"
 #include "world/render/outline_pass_single_component.h"
 #include "world/render/picking_pass_single_component.h"
 #include "world/render/quad_single_component.h"
 #include "world/render/render_single_component.h"
+#include "world/render/render_statistics_single_component.h"
 #include "world/render/skybox_pass_single_component.h"
+#include "world/render/static_geometry_single_component.h"
 #include "world/render/texture_single_component.h"
+#include "world/render/texture_streaming_single_component.h"
+#include "world/shared/frame_pacing_single_component.h"
 #include "world/shared/level_single_component.h"
 #include "world/shared/name_component.h"
 #include "world/shared/name_single_component.h"
 #include "world/shared/normal_input_single_component.h"
+#include "world/shared/resource_loading_single_component.h"
 #include "world/shared/transform_component.h"
 #include "world/shared/window_single_component.h"
 
@@ -45,14 +53,17 @@
 namespace hg {
 
 void register_components() {
+    REGISTER_COMPONENT(AABBTreeSingleComponent);
     REGISTER_COMPONENT(AAPassSingleComponent);
     REGISTER_COMPONENT(CameraSingleComponent);
     REGISTER_COMPONENT(DebugDrawPassSingleComponent);
+    REGISTER_COMPONENT(DynamicResolutionSingleComponent);
     REGISTER_COMPONENT(EditorFileSingleComponent);
     REGISTER_COMPONENT(EditorGizmoSingleComponent);
     REGISTER_COMPONENT(EditorHistorySingleComponent);
     REGISTER_COMPONENT(EditorPresetSingleComponent);
     REGISTER_COMPONENT(EditorSelectionSingleComponent);
+    REGISTER_COMPONENT(FramePacingSingleComponent);
     REGISTER_COMPONENT(GeometryPassSingleComponent);
     REGISTER_COMPONENT(HDRPassSingleComponent);
     REGISTER_COMPONENT(ImguiSingleComponent);
@@ -61,15 +72,20 @@ void register_components() {
     REGISTER_COMPONENT(ModelSingleComponent);
     REGISTER_COMPONENT(NameSingleComponent);
     REGISTER_COMPONENT(NormalInputSingleComponent);
+    REGISTER_COMPONENT(OcclusionCullingSingleComponent);
     REGISTER_COMPONENT(OutlinePassSingleComponent);
     REGISTER_COMPONENT(PhysicsCharacterControllerSingleComponent);
     REGISTER_COMPONENT(PhysicsSingleComponent);
     REGISTER_COMPONENT(PickingPassSingleComponent);
     REGISTER_COMPONENT(QuadSingleComponent);
     REGISTER_COMPONENT(RenderSingleComponent);
+    REGISTER_COMPONENT(RenderStatisticsSingleComponent);
+    REGISTER_COMPONENT(ResourceLoadingSingleComponent);
     REGISTER_COMPONENT(RunningWorldSingleComponent);
     REGISTER_COMPONENT(SkyboxPassSingleComponent);
+    REGISTER_COMPONENT(StaticGeometrySingleComponent);
     REGISTER_COMPONENT(TextureSingleComponent);
+    REGISTER_COMPONENT(TextureStreamingSingleComponent);
     REGISTER_COMPONENT(WindowSingleComponent);
 
     REGISTER_COMPONENT(BlockoutComponent);
@@ -9,6 +9,11 @@ class EditorHistorySystem final : public NormalSystem {
 public:
     explicit EditorHistorySystem(World& world);
     void update(float elapsed_time) override;
+
+private:
+    size_t m_undo_position = 0;
+    size_t m_num_undo_actions = 0;
+    size_t m_num_redo_changes = 0;
 };
 
 } // namespace hg
@@ -30,6 +30,9 @@ struct EditorSelectionSingleComponent final {
     std::shared_ptr<bool> select_all_entities;
     std::shared_ptr<bool> clear_selected_entities;
     std::shared_ptr<bool> delete_selected_entities;
+
+    /** When set, picking is performed on CPU against model geometry instead of reading back geometry pass. */
+    std::shared_ptr<bool> cpu_picking;
 };
 
 } // namespace hg
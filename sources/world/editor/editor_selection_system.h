@@ -2,10 +2,13 @@
 
 #include "core/ecs/system.h"
 
+#include <entt/entity/fwd.hpp>
+
 namespace hg {
 
 class NormalInputSingleComponent;
 struct EditorSelectionSingleComponent;
+struct PickingPassSingleComponent;
 
 /** `EditorSelectionSystem` shows Entity list UI, allows to pick an entity and stores it in
     `EditorSelectionSingleComponent`. */
@@ -19,6 +22,9 @@ private:
                            NormalInputSingleComponent& normal_input_single_component) const;
     void perform_picking(EditorSelectionSingleComponent& editor_selection_single_component,
                          NormalInputSingleComponent& normal_input_single_component) const;
+    void select_picked_entity(EditorSelectionSingleComponent& editor_selection_single_component,
+                              NormalInputSingleComponent& normal_input_single_component, entt::entity picked_entity) const;
+    entt::entity pick_entity(const PickingPassSingleComponent& picking_pass_single_component) const;
     void delete_selected(EditorSelectionSingleComponent& editor_selection_single_component,
                          NormalInputSingleComponent& normal_input_single_component) const;
     void select_all(EditorSelectionSingleComponent& editor_selection_single_component, 
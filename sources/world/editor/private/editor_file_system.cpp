@@ -23,7 +23,7 @@ namespace hg {
 SYSTEM_DESCRIPTOR(
     SYSTEM(EditorFileSystem),
     TAGS(editor),
-    BEFORE("ImguiPassSystem", "GeometryPassSystem"),
+    BEFORE("ImguiPassSystem", "GeometryPassSystem", "AABBTreeSystem", "StaticGeometrySystem"),
     AFTER("EditorMenuSystem", "WindowSystem", "ImguiFetchSystem", "ResourceSystem")
 )
 
@@ -372,19 +372,21 @@ bool EditorFileSystem::open_level() {
         return false;
     }
 
-    const YAML::Node node = YAML::Load(stream);
-    if (!node.IsMap()) {
-        return false;
-    }
+    // Entities are deserialized while the level is parsed, so the current level is cleared right before the first one.
+    bool is_cleared = false;
+
+    const bool is_level = ResourceUtils::deserialize_level(world, stream, &name_single_component, nullptr, [&]() {
+        clear_level();
+        is_cleared = true;
+    });
 
-    const YAML::Node entities = node["entities"];
-    if (!entities.IsSequence()) {
+    if (!is_level) {
         return false;
     }
 
-    clear_level();
-
-    ResourceUtils::deserialize_level(world, entities, &name_single_component);
+    if (!is_cleared) {
+        clear_level();
+    }
 
     return true;
 }
@@ -23,7 +23,7 @@ namespace hg {
 SYSTEM_DESCRIPTOR(
     SYSTEM(EditorGizmoSystem),
     TAGS(editor),
-    BEFORE("ImguiPassSystem", "GeometryPassSystem"),
+    BEFORE("ImguiPassSystem", "GeometryPassSystem", "AABBTreeSystem", "StaticGeometrySystem"),
     AFTER("EditorMenuSystem", "WindowSystem", "ImguiFetchSystem", "CameraSystem", "EditorSelectionSystem")
 )
 
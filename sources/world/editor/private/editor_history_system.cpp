@@ -4,6 +4,7 @@
 #include "world/editor/editor_history_system.h"
 #include "world/editor/editor_menu_single_component.h"
 #include "world/editor/editor_tags.h"
+#include "world/shared/frame_pacing_single_component.h"
 #include "world/shared/normal_input_single_component.h"
 
 #include <imgui.h>
@@ -73,6 +74,18 @@ void EditorHistorySystem::update(float /*elapsed_time*/) {
         editor_history_single_component.perform_redo(world);
     }
     *editor_history_single_component.redo_action = false;
+
+    // Level changes must be shown even if they're not caused by input.
+    const size_t undo_position = editor_history_single_component.undo_position;
+    const size_t num_undo_actions = editor_history_single_component.undo[undo_position].actions.size();
+    const size_t num_redo_changes = editor_history_single_component.redo.size();
+    if (undo_position != m_undo_position || num_undo_actions != m_num_undo_actions || num_redo_changes != m_num_redo_changes) {
+        m_undo_position = undo_position;
+        m_num_undo_actions = num_undo_actions;
+        m_num_redo_changes = num_redo_changes;
+
+        world.ctx<FramePacingSingleComponent>().wake_up();
+    }
 }
 
 } // namespace hg
@@ -156,6 +156,7 @@ void EditorPresetSystem::process_drag_and_drop(EditorPresetSingleComponent& edit
                 assert(world.has<TransformComponent>(editor_preset_single_component.placed_entity));
                 auto& transform_component = world.get<TransformComponent>(editor_preset_single_component.placed_entity);
                 transform_component.translation = camera_single_component.translation + camera_single_component.rotation * glm::vec3(projection_space_position);
+                world.notify<TransformComponent>(editor_preset_single_component.placed_entity);
             }
         } else if (world.valid(editor_preset_single_component.placed_entity)) {
             editor_preset_single_component.placed_entity = entt::null;
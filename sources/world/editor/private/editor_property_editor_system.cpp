@@ -22,7 +22,7 @@ namespace hg {
 SYSTEM_DESCRIPTOR(
     SYSTEM(EditorPropertyEditorSystem),
     TAGS(editor),
-    BEFORE("ImguiPassSystem", "GeometryPassSystem"),
+    BEFORE("ImguiPassSystem", "GeometryPassSystem", "AABBTreeSystem", "StaticGeometrySystem"),
     AFTER("ImguiFetchSystem", "EditorSelectionSystem")
 )
 
@@ -5,8 +5,10 @@
 #include "world/editor/editor_selection_single_component.h"
 #include "world/editor/editor_selection_system.h"
 #include "world/editor/editor_tags.h"
+#include "world/render/camera_single_component.h"
 #include "world/render/outline_component.h"
 #include "world/render/picking_pass_single_component.h"
+#include "world/render/picking_utils.h"
 #include "world/render/render_single_component.h"
 #include "world/shared/name_component.h"
 #include "world/shared/normal_input_single_component.h"
@@ -18,13 +20,14 @@
 #include <fmt/format.h>
 #include <glm/common.hpp>
 #include <imgui.h>
+#include <limits>
 
 namespace hg {
 
 SYSTEM_DESCRIPTOR(
     SYSTEM(EditorSelectionSystem),
     TAGS(editor),
-    BEFORE("ImguiPassSystem", "PickingPassSystem"),
+    BEFORE("ImguiPassSystem", "GeometryPassSystem", "PickingPassSystem"),
     AFTER("EditorMenuSystem", "WindowSystem", "ImguiFetchSystem")
 )
 
@@ -34,11 +37,13 @@ EditorSelectionSystem::EditorSelectionSystem(World& world)
     editor_selection_single_component.select_all_entities = std::make_shared<bool>(false);
     editor_selection_single_component.clear_selected_entities = std::make_shared<bool>(false);
     editor_selection_single_component.delete_selected_entities = std::make_shared<bool>(false);
+    editor_selection_single_component.cpu_picking = std::make_shared<bool>(false);
 
     auto& editor_menu_single_component = world.ctx<EditorMenuSingleComponent>();
     editor_menu_single_component.add_item("1Edit/2Select all entities",      editor_selection_single_component.select_all_entities,      "Ctrl+A");
     editor_menu_single_component.add_item("1Edit/3Clear selected entities",  editor_selection_single_component.clear_selected_entities,  "Ctrl+D");
     editor_menu_single_component.add_item("1Edit/4Delete selected entities", editor_selection_single_component.delete_selected_entities, "Del");
+    editor_menu_single_component.add_item("1Edit/5CPU picking",              editor_selection_single_component.cpu_picking);
 }
 
 void EditorSelectionSystem::update(float /*elapsed_time*/) {
@@ -105,35 +110,7 @@ void EditorSelectionSystem::perform_picking(EditorSelectionSingleComponent& edit
         if (render_single_component.current_frame >= picking_pass_single_component.target_frame) {
             editor_selection_single_component.waiting_for_pick = false;
 
-            const bgfx::RendererType::Enum renderer_type = bgfx::getRendererType();
-            if (renderer_type == bgfx::RendererType::OpenGL || renderer_type == bgfx::RendererType::OpenGLES) {
-                // OpenGL coordinate system starts at lower-left corner.
-                editor_selection_single_component.selection_y = window_single_component.height - editor_selection_single_component.selection_y;
-            }
-
-            assert(window_single_component.width != 0);
-            assert(window_single_component.height != 0);
-
-            const auto selection_x = static_cast<uint32_t>(glm::clamp(editor_selection_single_component.selection_x, 0, static_cast<int32_t>(window_single_component.width) - 1));
-            const auto selection_y = static_cast<uint32_t>(glm::clamp(editor_selection_single_component.selection_y, 0, static_cast<int32_t>(window_single_component.height) - 1));
-
-            entt::entity selected_entity = entt::null;
-            const uint32_t offset = (window_single_component.width * selection_y + selection_x) * 4;
-            if (offset + sizeof(uint32_t) <= picking_pass_single_component.target_data.size()) {
-                selected_entity = *reinterpret_cast<entt::entity*>(picking_pass_single_component.target_data.data() + offset);
-            }
-
-            if (!normal_input_single_component.is_down(Control::KEY_SHIFT) && !normal_input_single_component.is_down(Control::KEY_ALT)) {
-                editor_selection_single_component.clear_selection(world);
-            }
-
-            if (world.valid(selected_entity)) {
-                if (normal_input_single_component.is_down(Control::KEY_ALT)) {
-                    editor_selection_single_component.remove_from_selection(world, selected_entity);
-                } else {
-                    editor_selection_single_component.add_to_selection(world, selected_entity);
-                }
-            }
+            select_picked_entity(editor_selection_single_component, normal_input_single_component, pick_entity(picking_pass_single_component));
         }
     } else {
         const int32_t mouse_x = normal_input_single_component.get_mouse_x();
@@ -143,14 +120,67 @@ void EditorSelectionSystem::perform_picking(EditorSelectionSingleComponent& edit
             editor_selection_single_component.selection_y = mouse_y;
             editor_selection_single_component.selection_time = SDL_GetTicks();
         } else if (normal_input_single_component.is_released(Control::BUTTON_LEFT)) {
-            if (SDL_GetTicks() - editor_selection_single_component.selection_time < 150) {
-                picking_pass_single_component.perform_picking = true;
-                editor_selection_single_component.waiting_for_pick = true;
+            if (SDL_GetTicks() - editor_selection_single_component.selection_time < 150 && window_single_component.width != 0 && window_single_component.height != 0) {
+                if (*editor_selection_single_component.cpu_picking) {
+                    auto& camera_single_component = world.ctx<CameraSingleComponent>();
+
+                    const Ray ray = PickingUtils::screen_to_ray(camera_single_component, editor_selection_single_component.selection_x, editor_selection_single_component.selection_y,
+                                                                window_single_component.width, window_single_component.height);
+                    select_picked_entity(editor_selection_single_component, normal_input_single_component, PickingUtils::raycast(world, ray));
+                } else {
+                    // Picking pass maps the point to the view rect the geometry pass is rendered to.
+                    picking_pass_single_component.picking_x = static_cast<float>(editor_selection_single_component.selection_x) / window_single_component.width;
+                    picking_pass_single_component.picking_y = static_cast<float>(editor_selection_single_component.selection_y) / window_single_component.height;
+                    picking_pass_single_component.perform_picking = true;
+                    editor_selection_single_component.waiting_for_pick = true;
+                }
             }
         }
     }
 }
 
+void EditorSelectionSystem::select_picked_entity(EditorSelectionSingleComponent& editor_selection_single_component,
+                                                 NormalInputSingleComponent& normal_input_single_component, entt::entity picked_entity) const {
+    if (!normal_input_single_component.is_down(Control::KEY_SHIFT) && !normal_input_single_component.is_down(Control::KEY_ALT)) {
+        editor_selection_single_component.clear_selection(world);
+    }
+
+    if (world.valid(picked_entity)) {
+        if (normal_input_single_component.is_down(Control::KEY_ALT)) {
+            editor_selection_single_component.remove_from_selection(world, picked_entity);
+        } else {
+            editor_selection_single_component.add_to_selection(world, picked_entity);
+        }
+    }
+}
+
+entt::entity EditorSelectionSystem::pick_entity(const PickingPassSingleComponent& picking_pass_single_component) const {
+    const int32_t center_x = picking_pass_single_component.center_x;
+    const int32_t center_y = picking_pass_single_component.center_y;
+
+    // Prefer the texel under the cursor, but if it's empty take the closest one that is not. Makes thin objects easier to select.
+    entt::entity result = entt::null;
+    int32_t result_distance = std::numeric_limits<int32_t>::max();
+
+    for (int32_t y = 0; y < picking_pass_single_component.region_height; y++) {
+        for (int32_t x = 0; x < picking_pass_single_component.region_width; x++) {
+            const size_t offset = (static_cast<size_t>(y) * PickingPassSingleComponent::REGION_SIZE + x) * 4;
+            assert(offset + sizeof(uint32_t) <= picking_pass_single_component.target_data.size());
+
+            const entt::entity entity = *reinterpret_cast<const entt::entity*>(picking_pass_single_component.target_data.data() + offset);
+            if (entity != entt::null && world.valid(entity)) {
+                const int32_t distance = (x - center_x) * (x - center_x) + (y - center_y) * (y - center_y);
+                if (distance < result_distance) {
+                    result = entity;
+                    result_distance = distance;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
 void EditorSelectionSystem::delete_selected(EditorSelectionSingleComponent& editor_selection_single_component,
                                             NormalInputSingleComponent& normal_input_single_component) const {
     auto& editor_history_single_component = world.ctx<EditorHistorySingleComponent>();
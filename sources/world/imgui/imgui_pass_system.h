@@ -2,14 +2,21 @@
 
 #include "core/ecs/system.h"
 
+struct ImDrawData;
+
 namespace hg {
 
-/** `ImguiPassSystem` displays ImGui on the screen. */
+/** `ImguiPassSystem` displays ImGui on the screen. Draw data is uploaded only when its hash changes, otherwise previous
+    frame draw commands are submitted again. */
 class ImguiPassSystem final : public NormalSystem {
 public:
     explicit ImguiPassSystem(World& world);
     ~ImguiPassSystem() override;
     void update(float elapsed_time) override;
+
+private:
+    void upload_draw_data(const ImDrawData* draw_data);
+    void submit_draw_commands();
 };
 
 } // namespace hg
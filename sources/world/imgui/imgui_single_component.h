@@ -2,13 +2,30 @@
 
 #include <bgfx/bgfx.h>
 #include <imgui.h>
+#include <vector>
 
 struct SDL_Cursor;
 
 namespace hg {
 
-/** `ImguiSingleComponent` holds ImGui internal data. */
+/** `ImguiSingleComponent` holds ImGui internal data. Draw lists of all ImGui windows are uploaded to a single vertex and
+    index buffer, which are kept along with the draw commands until the draw data hash changes. */
 struct ImguiSingleComponent final {
+    /** Draw command of the uploaded draw data. Vertices and indices are in `vertex_buffer_handle` and `index_buffer_handle`. */
+    struct DrawCommand final {
+        bgfx::TextureHandle texture_handle = BGFX_INVALID_HANDLE;
+
+        uint16_t scissor_x      = 0;
+        uint16_t scissor_y      = 0;
+        uint16_t scissor_width  = 0;
+        uint16_t scissor_height = 0;
+
+        uint32_t first_vertex = 0;
+        uint32_t num_vertices = 0;
+        uint32_t first_index  = 0;
+        uint32_t num_indices  = 0;
+    };
+
     SDL_Cursor* mouse_cursors[ImGuiMouseCursor_COUNT] = { nullptr };
 
     bgfx::VertexDecl vertex_declaration;
@@ -16,6 +33,18 @@ struct ImguiSingleComponent final {
     bgfx::ProgramHandle program_handle      = BGFX_INVALID_HANDLE;
     bgfx::TextureHandle font_texture_handle = BGFX_INVALID_HANDLE;
     bgfx::UniformHandle font_uniform_handle = BGFX_INVALID_HANDLE;
+
+    bgfx::DynamicVertexBufferHandle vertex_buffer_handle = BGFX_INVALID_HANDLE;
+    bgfx::DynamicIndexBufferHandle index_buffer_handle   = BGFX_INVALID_HANDLE;
+
+    /** Capacity of the vertex and index buffers. They grow when the draw data doesn't fit. */
+    uint32_t vertex_buffer_size = 0;
+    uint32_t index_buffer_size  = 0;
+
+    std::vector<DrawCommand> draw_commands;
+
+    /** Hash of the uploaded draw data. Zero means the draw data can't be reused. */
+    uint64_t draw_data_hash = 0;
 };
 
 } // namespace hg
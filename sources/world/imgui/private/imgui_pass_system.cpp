@@ -8,9 +8,12 @@
 #include "world/imgui/imgui_tags.h"
 #include "world/shared/window_single_component.h"
 
+#include <algorithm>
 #include <bgfx/bgfx.h>
 #include <bgfx/embedded_shader.h>
+#include <cstring>
 #include <imgui.h>
+#include <limits>
 
 namespace hg {
 
@@ -22,6 +25,59 @@ static const bgfx::EmbeddedShader IMGUI_PASS_SHADER[] = {
         BGFX_EMBEDDED_SHADER_END()
 };
 
+static_assert(sizeof(ImDrawIdx) == sizeof(uint16_t), "ImGui indices must match bgfx 16-bit index buffer.");
+
+static const uint64_t HASH_PRIME_1 = 11400714785074694791ULL;
+static const uint64_t HASH_PRIME_2 = 14029467366897019727ULL;
+
+/** Combine the specified hash with the specified data, 8 bytes at a time. */
+static uint64_t hash_data(uint64_t hash, const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+
+    auto round = [&](uint64_t word) {
+        hash += word * HASH_PRIME_2;
+        hash = (hash << 31) | (hash >> 33);
+        hash *= HASH_PRIME_1;
+    };
+
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(uint64_t));
+        round(word);
+    }
+
+    uint64_t tail = 0;
+    if (i < size) {
+        std::memcpy(&tail, bytes + i, size - i);
+    }
+    round(tail ^ size);
+
+    return hash;
+}
+
+/** Return hash of the specified draw data or zero if it contains user callbacks, which must be called every frame. */
+static uint64_t hash_draw_data(const ImDrawData* draw_data) {
+    uint64_t hash = hash_data(HASH_PRIME_1, &draw_data->DisplaySize, sizeof(draw_data->DisplaySize));
+
+    for (int i = 0; i < draw_data->CmdListsCount; i++) {
+        const ImDrawList* draw_list = draw_data->CmdLists[i];
+        for (const ImDrawCmd& command : draw_list->CmdBuffer) {
+            if (command.UserCallback != nullptr) {
+                return 0;
+            }
+            hash = hash_data(hash, &command.ClipRect, sizeof(command.ClipRect));
+            hash = hash_data(hash, &command.TextureId, sizeof(command.TextureId));
+            hash = hash_data(hash, &command.ElemCount, sizeof(command.ElemCount));
+            hash = hash_data(hash, &command.VtxOffset, sizeof(command.VtxOffset));
+        }
+        hash = hash_data(hash, draw_list->VtxBuffer.Data, draw_list->VtxBuffer.size_in_bytes());
+        hash = hash_data(hash, draw_list->IdxBuffer.Data, draw_list->IdxBuffer.size_in_bytes());
+    }
+
+    return hash == 0 ? 1 : hash;
+}
+
 } // namespace imgui_pass_system_details
 
 SYSTEM_DESCRIPTOR(
@@ -46,6 +102,7 @@ ImguiPassSystem::ImguiPassSystem(World& world)
     int texture_width, texture_height;
 
     ImGuiIO& io = ImGui::GetIO();
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
     io.Fonts->AddFontDefault();
     io.Fonts->GetTexDataAsRGBA32(&texture_data, &texture_width, &texture_height);
 
@@ -75,6 +132,8 @@ ImguiPassSystem::~ImguiPassSystem() {
     destroy_valid(imgui_context_single_component.font_texture_handle);
     destroy_valid(imgui_context_single_component.font_uniform_handle);
     destroy_valid(imgui_context_single_component.program_handle);
+    destroy_valid(imgui_context_single_component.vertex_buffer_handle);
+    destroy_valid(imgui_context_single_component.index_buffer_handle);
 }
 
 void ImguiPassSystem::update(float /*elapsed_time*/) {
@@ -89,51 +148,107 @@ void ImguiPassSystem::update(float /*elapsed_time*/) {
 
     bgfx::touch(IMGUI_PASS);
 
-    ImDrawData* draw_data = ImGui::GetDrawData();
+    const ImDrawData* draw_data = ImGui::GetDrawData();
+
+    // Editor UI rarely changes from frame to frame, so in most frames nothing is uploaded.
+    const uint64_t draw_data_hash = imgui_pass_system_details::hash_draw_data(draw_data);
+    if (draw_data_hash == 0 || draw_data_hash != imgui_context_single_component.draw_data_hash) {
+        upload_draw_data(draw_data);
+        imgui_context_single_component.draw_data_hash = draw_data_hash;
+    }
+
+    submit_draw_commands();
+}
+
+void ImguiPassSystem::upload_draw_data(const ImDrawData* draw_data) {
+    auto& imgui_context_single_component = world.ctx<ImguiSingleComponent>();
+
+    imgui_context_single_component.draw_commands.clear();
+
+    const auto total_vertices = static_cast<uint32_t>(draw_data->TotalVtxCount);
+    const auto total_indices  = static_cast<uint32_t>(draw_data->TotalIdxCount);
+    if (total_vertices == 0 || total_indices == 0) {
+        return;
+    }
+
+    if (total_vertices > imgui_context_single_component.vertex_buffer_size) {
+        if (bgfx::isValid(imgui_context_single_component.vertex_buffer_handle)) {
+            bgfx::destroy(imgui_context_single_component.vertex_buffer_handle);
+        }
+        imgui_context_single_component.vertex_buffer_size = std::max(total_vertices, imgui_context_single_component.vertex_buffer_size * 2);
+        imgui_context_single_component.vertex_buffer_handle = bgfx::createDynamicVertexBuffer(imgui_context_single_component.vertex_buffer_size, imgui_context_single_component.vertex_declaration);
+    }
+
+    if (total_indices > imgui_context_single_component.index_buffer_size) {
+        if (bgfx::isValid(imgui_context_single_component.index_buffer_handle)) {
+            bgfx::destroy(imgui_context_single_component.index_buffer_handle);
+        }
+        imgui_context_single_component.index_buffer_size = std::max(total_indices, imgui_context_single_component.index_buffer_size * 2);
+        imgui_context_single_component.index_buffer_handle = bgfx::createDynamicIndexBuffer(imgui_context_single_component.index_buffer_size);
+    }
+
+    const bgfx::Memory* vertex_memory = bgfx::alloc(total_vertices * sizeof(ImDrawVert));
+    const bgfx::Memory* index_memory  = bgfx::alloc(total_indices * sizeof(ImDrawIdx));
+
+    uint32_t vertex_offset = 0;
+    uint32_t index_offset  = 0;
+
     for (int i = 0; i < draw_data->CmdListsCount; i++) {
         const ImDrawList* draw_list = draw_data->CmdLists[i];
         auto num_vertices = static_cast<uint32_t>(draw_list->VtxBuffer.size());
         auto num_indices  = static_cast<uint32_t>(draw_list->IdxBuffer.size());
 
-        if (!bgfx::getAvailTransientVertexBuffer(num_vertices, imgui_context_single_component.vertex_declaration) || !bgfx::getAvailTransientIndexBuffer(num_indices)) {
-            break;
-        }
+        std::copy(draw_list->VtxBuffer.begin(), draw_list->VtxBuffer.end(), reinterpret_cast<ImDrawVert*>(vertex_memory->data) + vertex_offset);
+        std::copy(draw_list->IdxBuffer.begin(), draw_list->IdxBuffer.end(), reinterpret_cast<ImDrawIdx*>(index_memory->data) + index_offset);
 
-        bgfx::TransientVertexBuffer vertex_buffer {};
-        bgfx::allocTransientVertexBuffer(&vertex_buffer, num_vertices, imgui_context_single_component.vertex_declaration);
-        std::copy(draw_list->VtxBuffer.begin(), draw_list->VtxBuffer.end(), reinterpret_cast<ImDrawVert*>(vertex_buffer.data));
-
-        bgfx::TransientIndexBuffer index_buffer {};
-        bgfx::allocTransientIndexBuffer(&index_buffer, num_indices);
-        std::copy(draw_list->IdxBuffer.begin(), draw_list->IdxBuffer.end(), reinterpret_cast<ImDrawIdx*>(index_buffer.data));
-
-        uint32_t offset = 0;
+        uint32_t offset = index_offset;
         for (const ImDrawCmd* command = draw_list->CmdBuffer.begin(); command != draw_list->CmdBuffer.end(); command++) {
             if (command->UserCallback != nullptr) {
                 command->UserCallback(draw_list, command);
             } else if (command->ElemCount != 0) {
-                bgfx::TextureHandle texture_handle = imgui_context_single_component.font_texture_handle;
+                ImguiSingleComponent::DrawCommand& draw_command = imgui_context_single_component.draw_commands.emplace_back();
+
+                draw_command.texture_handle = imgui_context_single_component.font_texture_handle;
                 if (command->TextureId != nullptr) {
-                    texture_handle.idx = uint16_t(reinterpret_cast<uintptr_t>(command->TextureId));
+                    draw_command.texture_handle.idx = uint16_t(reinterpret_cast<uintptr_t>(command->TextureId));
                 }
 
-                auto x = static_cast<uint16_t>(std::max(command->ClipRect.x, 0.f));
-                auto y = static_cast<uint16_t>(std::max(command->ClipRect.y, 0.f));
-                auto width = static_cast<uint16_t>(std::min(command->ClipRect.z, static_cast<float>(std::numeric_limits<uint16_t>::max())) - x);
-                auto height = static_cast<uint16_t>(std::min(command->ClipRect.w, static_cast<float>(std::numeric_limits<uint16_t>::max())) - y);
-                bgfx::setScissor(x, y, width, height);
+                draw_command.scissor_x      = static_cast<uint16_t>(std::max(command->ClipRect.x, 0.f));
+                draw_command.scissor_y      = static_cast<uint16_t>(std::max(command->ClipRect.y, 0.f));
+                draw_command.scissor_width  = static_cast<uint16_t>(std::min(command->ClipRect.z, static_cast<float>(std::numeric_limits<uint16_t>::max())) - draw_command.scissor_x);
+                draw_command.scissor_height = static_cast<uint16_t>(std::min(command->ClipRect.w, static_cast<float>(std::numeric_limits<uint16_t>::max())) - draw_command.scissor_y);
 
-                bgfx::setVertexBuffer(0, &vertex_buffer, 0, num_vertices);
-                bgfx::setIndexBuffer(&index_buffer, offset, command->ElemCount);
-
-                bgfx::setTexture(0, imgui_context_single_component.font_uniform_handle, texture_handle);
-
-                bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA));
-
-                bgfx::submit(IMGUI_PASS, imgui_context_single_component.program_handle);
+                // 16-bit indices are relative to the draw list vertices, so each draw list starts at its own vertex.
+                draw_command.first_vertex = vertex_offset + command->VtxOffset;
+                draw_command.num_vertices = num_vertices - command->VtxOffset;
+                draw_command.first_index  = offset;
+                draw_command.num_indices  = command->ElemCount;
             }
             offset += command->ElemCount;
         }
+
+        vertex_offset += num_vertices;
+        index_offset  += num_indices;
+    }
+
+    bgfx::update(imgui_context_single_component.vertex_buffer_handle, 0, vertex_memory);
+    bgfx::update(imgui_context_single_component.index_buffer_handle, 0, index_memory);
+}
+
+void ImguiPassSystem::submit_draw_commands() {
+    auto& imgui_context_single_component = world.ctx<ImguiSingleComponent>();
+
+    for (const ImguiSingleComponent::DrawCommand& draw_command : imgui_context_single_component.draw_commands) {
+        bgfx::setScissor(draw_command.scissor_x, draw_command.scissor_y, draw_command.scissor_width, draw_command.scissor_height);
+
+        bgfx::setVertexBuffer(0, imgui_context_single_component.vertex_buffer_handle, draw_command.first_vertex, draw_command.num_vertices);
+        bgfx::setIndexBuffer(imgui_context_single_component.index_buffer_handle, draw_command.first_index, draw_command.num_indices);
+
+        bgfx::setTexture(0, imgui_context_single_component.font_uniform_handle, draw_command.texture_handle);
+
+        bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA));
+
+        bgfx::submit(IMGUI_PASS, imgui_context_single_component.program_handle);
     }
 }
 
@@ -3,6 +3,7 @@
 #include "world/physics/physics_fetch_system.h"
 #include "world/physics/physics_single_component.h"
 #include "world/physics/physics_tags.h"
+#include "world/shared/frame_pacing_single_component.h"
 
 #include <PxScene.h>
 
@@ -21,6 +22,13 @@ PhysicsFetchSystem::PhysicsFetchSystem(World& world)
 void PhysicsFetchSystem::update(float /*elapsed_time*/) {
     auto& physics_single_component = world.ctx<PhysicsSingleComponent>();
     physics_single_component.get_scene().fetchResults(true);
+
+    // Keep producing frames until all physics actors fall asleep.
+    physx::PxU32 num_active_actors = 0;
+    physics_single_component.get_scene().getActiveActors(num_active_actors);
+    if (num_active_actors > 0) {
+        world.ctx<FramePacingSingleComponent>().wake_up();
+    }
 }
 
 } // namespace hg
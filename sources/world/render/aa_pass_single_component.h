@@ -12,6 +12,7 @@ struct AAPassSingleComponent final {
 
     bgfx::UniformHandle pixel_size_uniform = BGFX_INVALID_HANDLE;
     bgfx::UniformHandle texture_uniform    = BGFX_INVALID_HANDLE;
+    bgfx::UniformHandle uv_scale_uniform   = BGFX_INVALID_HANDLE;
 };
 
 } // namespace hg
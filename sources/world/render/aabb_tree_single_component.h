@@ -0,0 +1,32 @@
+#pragma once
+
+#include "core/math/dynamic_aabb_tree.h"
+
+#include <entt/entity/fwd.hpp>
+#include <unordered_map>
+
+namespace hg {
+
+class AABBTreeSystem;
+
+/** `AABBTreeSingleComponent` contains a dynamic AABB tree of all entities with `ModelComponent` and
+    `TransformComponent`. Tree values are entity identifiers. The tree is maintained by `AABBTreeSystem`. */
+class AABBTreeSingleComponent final {
+public:
+    /** Return the tree. Fat boxes are in world space. */
+    const DynamicAABBTree& get_tree() const;
+
+    /** Store fat world space bounds of the specified entity in `min` and `max`. Return false if entity is not in the tree. */
+    bool get_bounds(entt::entity entity, glm::vec3& min, glm::vec3& max) const;
+
+    /** Return true if the specified entity is in the tree. */
+    bool contains(entt::entity entity) const;
+
+private:
+    DynamicAABBTree m_tree;
+    std::unordered_map<entt::entity, uint32_t> m_proxies;
+
+    friend class AABBTreeSystem;
+};
+
+} // namespace hg
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "core/ecs/system.h"
+
+#include <entt/entity/observer.hpp>
+#include <vector>
+
+namespace hg {
+
+/** `AABBTreeSystem` keeps `AABBTreeSingleComponent` in sync with `ModelComponent` and `TransformComponent` changes.
+    Transform changes must be signalled either by `replace` or by `notify`, direct writes are not observed. */
+class AABBTreeSystem final : public NormalSystem {
+public:
+    explicit AABBTreeSystem(World& world);
+    ~AABBTreeSystem() override;
+    void update(float elapsed_time) override;
+
+private:
+    void model_destroyed(entt::entity entity, entt::registry& registry);
+
+    entt::observer m_model_observer;
+
+    /** Entities that existed before this system was created. */
+    std::vector<entt::entity> m_initial_entities;
+};
+
+} // namespace hg
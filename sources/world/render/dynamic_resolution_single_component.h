@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/vec4.hpp>
+
+namespace hg {
+
+/** `DynamicResolutionSingleComponent` contains the resolution of the scene passes (geometry, lighting, skybox and
+    offscreen debug draw). Their targets are allocated at `max_scale` of the window size and the scene is rendered to
+    the top-left `width` x `height` part of them, so changing the scale never reallocates anything. AA pass upscales
+    the result to the window size. Settings may be set up before `DynamicResolutionSystem` is created. */
+struct DynamicResolutionSingleComponent final {
+    /** When disabled, the scene is always rendered at `max_scale`. */
+    bool is_enabled = true;
+
+    float min_scale = 0.5f;
+    float max_scale = 1.f;
+
+    /** Scale is adjusted to keep GPU frame time (in milliseconds) slightly below this value. */
+    float target_gpu_time = 16.f;
+
+    /** Current scale of the window size. */
+    float scale = 1.f;
+
+    /** Current scene resolution. */
+    uint16_t width  = 1;
+    uint16_t height = 1;
+
+    /** Size of the scene targets. */
+    uint16_t texture_width  = 1;
+    uint16_t texture_height = 1;
+
+    /** Set when scene targets must be recreated because of window resize or `max_scale` change. */
+    bool is_texture_resized = false;
+
+    /** Part of the scene targets that contains the current frame in UV space (`width / texture_width`,
+        `height / texture_height`). */
+    glm::vec4 uv_scale = glm::vec4(1.f, 1.f, 0.f, 0.f);
+};
+
+} // namespace hg
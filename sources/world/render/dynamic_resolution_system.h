@@ -0,0 +1,24 @@
+#pragma once
+
+#include "core/ecs/system.h"
+
+namespace hg {
+
+struct DynamicResolutionSingleComponent;
+
+/** `DynamicResolutionSystem` scales scene resolution between `min_scale` and `max_scale` of the window size depending
+    on the measured GPU frame time. */
+class DynamicResolutionSystem final : public NormalSystem {
+public:
+    explicit DynamicResolutionSystem(World& world);
+    void update(float elapsed_time) override;
+
+private:
+    void update_scale(DynamicResolutionSingleComponent& dynamic_resolution_single_component);
+    void update_size(DynamicResolutionSingleComponent& dynamic_resolution_single_component) const;
+
+    float m_gpu_time_sum = 0.f;
+    uint32_t m_num_gpu_times = 0;
+};
+
+} // namespace hg
@@ -4,20 +4,29 @@
 
 namespace hg {
 
-/** `GeometryPassSingleComponent` contains geometry pass shaders, uniforms and framebuffers. */
+/** `GeometryPassSingleComponent` contains geometry pass shaders, uniforms and framebuffers. Besides the regular G-buffer,
+    geometry pass writes entity identifiers into `entity_texture`, which is used for picking. Array programs are used
+    for materials packed into texture arrays. */
 struct GeometryPassSingleComponent final {
     bgfx::FrameBufferHandle gbuffer = BGFX_INVALID_HANDLE;
 
-    bgfx::ProgramHandle geometry_blockout_pass_program    = BGFX_INVALID_HANDLE;
-    bgfx::ProgramHandle geometry_pass_program             = BGFX_INVALID_HANDLE;
+    bgfx::ProgramHandle geometry_array_pass_program          = BGFX_INVALID_HANDLE;
+    bgfx::ProgramHandle geometry_blockout_array_pass_program = BGFX_INVALID_HANDLE;
+    bgfx::ProgramHandle geometry_blockout_pass_program       = BGFX_INVALID_HANDLE;
+    bgfx::ProgramHandle geometry_pass_program                = BGFX_INVALID_HANDLE;
 
     bgfx::TextureHandle color_roughness_texture = BGFX_INVALID_HANDLE;
     bgfx::TextureHandle depth_texture           = BGFX_INVALID_HANDLE;
     bgfx::TextureHandle depth_stencil_texture   = BGFX_INVALID_HANDLE;
+    bgfx::TextureHandle entity_texture          = BGFX_INVALID_HANDLE;
     bgfx::TextureHandle normal_metal_ao_texture = BGFX_INVALID_HANDLE;
 
     bgfx::UniformHandle color_roughness_uniform   = BGFX_INVALID_HANDLE;
     bgfx::UniformHandle normal_metal_ao_uniform   = BGFX_INVALID_HANDLE;
+    bgfx::UniformHandle entity_uniform            = BGFX_INVALID_HANDLE;
+    bgfx::UniformHandle material_layer_uniform    = BGFX_INVALID_HANDLE;
+    bgfx::UniformHandle position_offset_uniform   = BGFX_INVALID_HANDLE;
+    bgfx::UniformHandle position_scale_uniform    = BGFX_INVALID_HANDLE;
 };
 
 } // namespace hg
@@ -25,6 +25,7 @@ private:
 
     void reset(GeometryPassSingleComponent& geometry_pass_single_component, uint16_t width, uint16_t height) const;
     void draw_node(const DrawNodeContext& context, const Model::Node& node, const glm::mat4& transform) const;
+    void draw_primitive(const DrawNodeContext& context, const Model::Primitive& primitive, const glm::mat4& transform) const;
 
     entt::basic_group<entt::entity, entt::exclude_t<>, entt::get_t<>, ModelComponent, MaterialComponent, TransformComponent> m_group;
 };
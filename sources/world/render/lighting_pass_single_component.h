@@ -16,6 +16,7 @@ struct LightingPassSingleComponent final {
     bgfx::UniformHandle light_position_uniform  = BGFX_INVALID_HANDLE;
     bgfx::UniformHandle normal_metal_ao_uniform = BGFX_INVALID_HANDLE;
     bgfx::UniformHandle texture_uniform         = BGFX_INVALID_HANDLE;
+    bgfx::UniformHandle uv_scale_uniform        = BGFX_INVALID_HANDLE;
 
     bgfx::UniformHandle skybox_mip_prefilter_max_uniform  = BGFX_INVALID_HANDLE;
     bgfx::UniformHandle skybox_texture_irradiance_uniform = BGFX_INVALID_HANDLE;
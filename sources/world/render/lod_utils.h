@@ -0,0 +1,25 @@
+#pragma once
+
+#include "core/resource/model.h"
+
+#include <glm/mat4x4.hpp>
+
+namespace hg {
+
+struct CameraSingleComponent;
+
+/** `LodUtils` is a set of utility functions for level of detail selection. */
+class LodUtils final {
+public:
+    LodUtils() = delete;
+
+    /** Return level of detail for a model with the specified local `bounds` and world `transform`. Level of detail is
+        chosen from projected size of the model's bounding sphere, zero is the most detailed level. */
+    static size_t get_lod(const CameraSingleComponent& camera_single_component, const Model::AABB& bounds, const glm::mat4& transform);
+
+    /** Set index buffer of the specified level of detail of the given `primitive`. When the primitive doesn't have such
+        level of detail, the least detailed available level is used. */
+    static void set_index_buffer(const Model::Primitive& primitive, size_t lod);
+};
+
+} // namespace hg
@@ -14,6 +14,9 @@ struct MaterialComponent final {
     // In order to update these fields `material` must be updated via `replace` world method.
     const Texture* color_roughness = nullptr;
     const Texture* normal_metal_ao = nullptr;
+
+    /** Layer of both textures when they are texture arrays. */
+    uint16_t layer = 0;
 };
 
 } // namespace hg
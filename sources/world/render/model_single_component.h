@@ -1,7 +1,8 @@
 #pragma once
 
+#include "core/resource/resource_id.h"
+
 #include <memory>
-#include <string>
 #include <unordered_map>
 
 namespace hg {
@@ -19,11 +20,11 @@ public:
     ModelSingleComponent& operator=(ModelSingleComponent&& another);
     ~ModelSingleComponent();
 
-    /** Return model with the specified name or nullptr if such model doesn't exists. */
-    const Model* get(const std::string& name) const;
+    /** Return model with the specified identifier or nullptr if such model doesn't exists. */
+    const Model* get(ResourceId id) const;
 
 private:
-    std::unordered_map<std::string, std::unique_ptr<Model>> m_models;
+    std::unordered_map<ResourceId, std::unique_ptr<Model>> m_models;
 
     friend class ResourceSystem;
 };
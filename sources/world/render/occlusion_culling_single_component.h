@@ -0,0 +1,83 @@
+#pragma once
+
+#include "core/render/occlusion_buffer.h"
+
+#include <entt/entity/registry.hpp>
+#include <future>
+#include <glm/mat4x4.hpp>
+#include <memory>
+#include <vector>
+
+namespace hg {
+
+class AABBTreeSingleComponent;
+class OcclusionCullingSystem;
+class WorkerPool;
+
+/** `OcclusionCullingSingleComponent` contains the result of CPU occlusion culling for the current frame. Nearest
+    blockout boxes are rasterized into a low resolution depth buffer, then bounds of all entities inside of the frustum
+    are tested against it. The work is started by `OcclusionCullingSystem` and performed on persistent worker threads. */
+class OcclusionCullingSingleComponent final {
+public:
+    /** Low resolution depth buffer size. */
+    static constexpr uint32_t BUFFER_WIDTH = 256;
+    static constexpr uint32_t BUFFER_HEIGHT = 128;
+
+    OcclusionCullingSingleComponent();
+    OcclusionCullingSingleComponent(const OcclusionCullingSingleComponent& another) = delete;
+    OcclusionCullingSingleComponent(OcclusionCullingSingleComponent&& another);
+    OcclusionCullingSingleComponent& operator=(const OcclusionCullingSingleComponent& another) = delete;
+    OcclusionCullingSingleComponent& operator=(OcclusionCullingSingleComponent&& another);
+    ~OcclusionCullingSingleComponent();
+
+    /** Wait until occlusion culling for the current frame is finished. Must be called before `is_visible`. */
+    void wait();
+
+    /** Return false if the specified entity was outside of the frustum or occluded by blockout geometry when culling
+        was started. Entities that were not in the AABB tree back then, like just created ones, are visible. When
+        occlusion culling is disabled, all entities are visible. */
+    bool is_visible(entt::entity entity) const;
+
+    /** Toggled by F9. */
+    bool is_enabled = true;
+
+    /** Maximum number of the nearest blockout boxes that are rasterized as occluders. */
+    uint32_t max_occluders = 32;
+
+    /** Counters of the last finished frame. */
+    uint32_t num_occluders = 0;
+    uint32_t num_frustum_culled = 0;
+    uint32_t num_occlusion_culled = 0;
+    uint32_t num_visible = 0;
+
+private:
+    struct Occluder final {
+        glm::mat4 transform;
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    struct Occludee final {
+        entt::entity entity;
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    OcclusionBuffer m_buffer;
+    glm::mat4 m_view_projection;
+    std::vector<Occluder> m_occluders;
+    std::vector<Occludee> m_occludees;
+
+    /** Sorted list of frustum visible entities that are not occluded, valid when `m_has_result` is true and `m_task` is
+        finished. Entities missing from `m_aabb_tree` are not culled. */
+    std::vector<entt::entity> m_visible_entities;
+    const AABBTreeSingleComponent* m_aabb_tree = nullptr;
+
+    std::unique_ptr<WorkerPool> m_worker_pool;
+    std::future<void> m_task;
+    bool m_has_result = false;
+
+    friend class OcclusionCullingSystem;
+};
+
+} // namespace hg
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "core/ecs/system.h"
+
+namespace hg {
+
+class OcclusionCullingSingleComponent;
+
+/** `OcclusionCullingSystem` gathers occluders and frustum visible entities from `AABBTreeSingleComponent` and starts
+    occlusion culling on worker threads. `GeometryPassSystem` waits for the result before submitting draw calls. */
+class OcclusionCullingSystem final : public NormalSystem {
+public:
+    explicit OcclusionCullingSystem(World& world);
+    ~OcclusionCullingSystem() override;
+    void update(float elapsed_time) override;
+
+private:
+    static void cull(OcclusionCullingSingleComponent& occlusion_culling_single_component);
+};
+
+} // namespace hg
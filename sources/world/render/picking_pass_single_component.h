@@ -1,21 +1,36 @@
 #pragma once
 
 #include <bgfx/bgfx.h>
+#include <vector>
 
 namespace hg {
 
-/** `PickingPassSingleComponent` contains picking pass shaders, textures and uniforms. */
+/** `PickingPassSingleComponent` contains picking pass textures and the read back region of geometry pass entity texture. */
 struct PickingPassSingleComponent final {
-    bgfx::FrameBufferHandle buffer = BGFX_INVALID_HANDLE;
-    bgfx::ProgramHandle program    = BGFX_INVALID_HANDLE;
+    /** Width and height of the region around the cursor that is read back from GPU. */
+    static constexpr uint16_t REGION_SIZE = 9;
 
-    bgfx::TextureHandle color_texture    = BGFX_INVALID_HANDLE;
-    bgfx::TextureHandle rt_color_texture = BGFX_INVALID_HANDLE;
-    bgfx::TextureHandle rt_depth_buffer  = BGFX_INVALID_HANDLE;
-
-    bgfx::UniformHandle object_index_uniform = BGFX_INVALID_HANDLE;
+    bgfx::TextureHandle region_texture = BGFX_INVALID_HANDLE;
 
+    /** Set `perform_picking` to true to read back the region around (`picking_x`, `picking_y`) point. The point is in
+        [0, 1] range relative to the top-left corner of the view, it's mapped to the dynamic resolution view rect of
+        the frame that is picked from. */
     bool perform_picking = false;
+    float picking_x = 0.f;
+    float picking_y = 0.f;
+
+    /** Texel position and size of the region that was actually copied. The region never leaves the current view rect,
+        so it's smaller than `REGION_SIZE` only when the view rect itself is smaller than that. `target_data` rows are
+        always `REGION_SIZE` texels wide. */
+    uint16_t region_x = 0;
+    uint16_t region_y = 0;
+    uint16_t region_width = 0;
+    uint16_t region_height = 0;
+
+    /** Position of the texel under the cursor relative to the region. */
+    uint16_t center_x = 0;
+    uint16_t center_y = 0;
+
     uint32_t target_frame = 0;
     std::vector<uint8_t> target_data;
 };
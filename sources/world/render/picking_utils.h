@@ -0,0 +1,30 @@
+#pragma once
+
+#include "core/math/ray.h"
+
+#include <entt/entity/fwd.hpp>
+#include <cstdint>
+
+namespace hg {
+
+class World;
+struct CameraSingleComponent;
+
+/** `PickingUtils` is a set of utility functions for CPU picking. Unlike GPU picking, CPU picking gives the result
+    immediately and doesn't need a render pass. */
+class PickingUtils final {
+public:
+    PickingUtils() = delete;
+
+    /** Return world space ray that goes from the active camera through the specified window position. Ray direction
+        is scaled so that the ray reaches far plane at distance one. */
+    static Ray screen_to_ray(const CameraSingleComponent& camera_single_component, int32_t x, int32_t y, uint32_t width, uint32_t height);
+
+    /** Return the closest entity with `ModelComponent` and `TransformComponent` whose geometry is intersected by the
+        specified `ray`, or null entity if there's no such entity. Intersection distance is stored in `distance`.
+        Candidates come from `AABBTreeSingleComponent`, so entities changed later than `AABBTreeSystem` update are
+        tested against their previous frame bounds. */
+    static entt::entity raycast(World& world, const Ray& ray, float* distance = nullptr);
+};
+
+} // namespace hg
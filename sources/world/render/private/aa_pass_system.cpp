@@ -6,6 +6,7 @@
 #include "world/render/aa_pass_single_component.h"
 #include "world/render/aa_pass_system.h"
 #include "world/render/camera_single_component.h"
+#include "world/render/dynamic_resolution_single_component.h"
 #include "world/render/quad_single_component.h"
 #include "world/render/render_tags.h"
 #include "world/render/skybox_pass_single_component.h"
@@ -49,6 +50,7 @@ AAPassSystem::AAPassSystem(World& world)
 
     aa_pass_single_component.texture_uniform    = bgfx::createUniform("s_texture", bgfx::UniformType::Sampler);
     aa_pass_single_component.pixel_size_uniform = bgfx::createUniform("u_pixel_size", bgfx::UniformType::Vec4);
+    aa_pass_single_component.uv_scale_uniform   = bgfx::createUniform("u_uv_scale", bgfx::UniformType::Vec4);
 
     reset(aa_pass_single_component, window_single_component.width, window_single_component.height);
 
@@ -69,11 +71,13 @@ AAPassSystem::~AAPassSystem() {
     destroy_valid(aa_pass_single_component.buffer);
     destroy_valid(aa_pass_single_component.pixel_size_uniform);
     destroy_valid(aa_pass_single_component.texture_uniform);
+    destroy_valid(aa_pass_single_component.uv_scale_uniform);
 }
 
 void AAPassSystem::update(float /*elapsed_time*/) {
     auto& aa_pass_single_component = world.ctx<AAPassSingleComponent>();
     auto& camera_single_component = world.ctx<CameraSingleComponent>();
+    auto& dynamic_resolution_single_component = world.ctx<DynamicResolutionSingleComponent>();
     auto& quad_single_component = world.ctx<QuadSingleComponent>();
     auto& skybox_pass_single_component = world.ctx<SkyboxPassSingleComponent>();
     auto& window_single_component = world.ctx<WindowSingleComponent>();
@@ -89,8 +93,10 @@ void AAPassSystem::update(float /*elapsed_time*/) {
 
     bgfx::setTexture(0, aa_pass_single_component.texture_uniform, skybox_pass_single_component.color_texture);
 
-    const float pixel_resolution[4] = { 1.f / window_single_component.width, 1.f / window_single_component.height, 0.f, 0.f};
+    // Skybox pass output is rendered at dynamic resolution, so AA pass upscales it to the window size.
+    const float pixel_resolution[4] = { 1.f / dynamic_resolution_single_component.texture_width, 1.f / dynamic_resolution_single_component.texture_height, 0.f, 0.f};
     bgfx::setUniform(aa_pass_single_component.pixel_size_uniform, &pixel_resolution);
+    bgfx::setUniform(aa_pass_single_component.uv_scale_uniform, &dynamic_resolution_single_component.uv_scale);
 
     bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_CULL_CW);
 
@@ -0,0 +1,21 @@
+#include "world/render/aabb_tree_single_component.h"
+
+namespace hg {
+
+const DynamicAABBTree& AABBTreeSingleComponent::get_tree() const {
+    return m_tree;
+}
+
+bool AABBTreeSingleComponent::get_bounds(entt::entity entity, glm::vec3& min, glm::vec3& max) const {
+    if (auto proxy = m_proxies.find(entity); proxy != m_proxies.end()) {
+        m_tree.get_bounds(proxy->second, min, max);
+        return true;
+    }
+    return false;
+}
+
+bool AABBTreeSingleComponent::contains(entt::entity entity) const {
+    return m_proxies.count(entity) > 0;
+}
+
+} // namespace hg
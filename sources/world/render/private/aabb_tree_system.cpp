@@ -0,0 +1,122 @@
+#include "core/ecs/system_descriptor.h"
+#include "core/ecs/world.h"
+#include "world/render/aabb_tree_single_component.h"
+#include "world/render/aabb_tree_system.h"
+#include "world/render/model_component.h"
+#include "world/render/render_tags.h"
+#include "world/shared/transform_component.h"
+
+#include <glm/common.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <limits>
+#include <utility>
+
+namespace hg {
+
+namespace aabb_tree_system_details {
+
+static void get_bounds(const ModelComponent& model_component, const TransformComponent& transform_component, glm::vec3& min, glm::vec3& max) {
+    glm::mat4 transform = glm::translate(glm::mat4(1.f), transform_component.translation);
+    transform = transform * glm::mat4_cast(transform_component.rotation);
+    transform = glm::scale(transform, transform_component.scale);
+
+    const Model::AABB& bounds = model_component.model.bounds;
+
+    min = glm::vec3(std::numeric_limits<float>::max());
+    max = glm::vec3(-std::numeric_limits<float>::max());
+
+    for (size_t i = 0; i < 8; i++) {
+        const glm::vec4 corner((i & 1) != 0 ? bounds.max_x : bounds.min_x,
+                               (i & 2) != 0 ? bounds.max_y : bounds.min_y,
+                               (i & 4) != 0 ? bounds.max_z : bounds.min_z,
+                               1.f);
+        const glm::vec3 transformed_corner(transform * corner);
+
+        min = glm::min(min, transformed_corner);
+        max = glm::max(max, transformed_corner);
+    }
+}
+
+} // namespace aabb_tree_system_details
+
+SYSTEM_DESCRIPTOR(
+    SYSTEM(AABBTreeSystem),
+    TAGS(render),
+    BEFORE("GeometryPassSystem", "RenderSystem"),
+    AFTER("ResourceSystem")
+)
+
+AABBTreeSystem::AABBTreeSystem(World& world)
+        : NormalSystem(world)
+        , m_model_observer(entt::observer(world, entt::collector.group<ModelComponent, TransformComponent>()
+                                                                .replace<ModelComponent>().where<TransformComponent>()
+                                                                .replace<TransformComponent>().where<ModelComponent>())) {
+    world.set<AABBTreeSingleComponent>();
+
+    // Level is loaded by `ResourceSystem` constructor, which is executed before this system is created.
+    world.view<ModelComponent, TransformComponent>().each([&](entt::entity entity, ModelComponent& /*model_component*/, TransformComponent& /*transform_component*/) {
+        m_initial_entities.push_back(entity);
+    });
+
+    world.on_destroy<ModelComponent>().connect<&AABBTreeSystem::model_destroyed>(*this);
+    world.on_destroy<TransformComponent>().connect<&AABBTreeSystem::model_destroyed>(*this);
+}
+
+AABBTreeSystem::~AABBTreeSystem() {
+    world.on_destroy<ModelComponent>().disconnect<&AABBTreeSystem::model_destroyed>(*this);
+    world.on_destroy<TransformComponent>().disconnect<&AABBTreeSystem::model_destroyed>(*this);
+
+    m_model_observer.disconnect();
+}
+
+void AABBTreeSystem::update(float /*elapsed_time*/) {
+    using namespace aabb_tree_system_details;
+
+    auto& aabb_tree_single_component = world.ctx<AABBTreeSingleComponent>();
+
+    auto model_updated = [&](const entt::entity entity) {
+        if (!world.valid(entity) || !world.has<ModelComponent, TransformComponent>(entity)) {
+            return;
+        }
+
+        auto& model_component = world.get<ModelComponent>(entity);
+        auto& transform_component = world.get<TransformComponent>(entity);
+
+        auto proxy = aabb_tree_single_component.m_proxies.find(entity);
+
+        // Models that are not loaded yet don't have any geometry to cull or pick.
+        if (model_component.model.children.empty()) {
+            if (proxy != aabb_tree_single_component.m_proxies.end()) {
+                aabb_tree_single_component.m_tree.remove(proxy->second);
+                aabb_tree_single_component.m_proxies.erase(proxy);
+            }
+            return;
+        }
+
+        glm::vec3 min, max;
+        get_bounds(model_component, transform_component, min, max);
+
+        if (proxy != aabb_tree_single_component.m_proxies.end()) {
+            aabb_tree_single_component.m_tree.update(proxy->second, min, max);
+        } else {
+            aabb_tree_single_component.m_proxies.emplace(entity, aabb_tree_single_component.m_tree.insert(min, max, static_cast<uint32_t>(entity)));
+        }
+    };
+
+    for (entt::entity entity : std::exchange(m_initial_entities, {})) {
+        model_updated(entity);
+    }
+
+    m_model_observer.each(model_updated);
+}
+
+void AABBTreeSystem::model_destroyed(const entt::entity entity, entt::registry& /*registry*/) {
+    auto& aabb_tree_single_component = world.ctx<AABBTreeSingleComponent>();
+
+    if (auto proxy = aabb_tree_single_component.m_proxies.find(entity); proxy != aabb_tree_single_component.m_proxies.end()) {
+        aabb_tree_single_component.m_tree.remove(proxy->second);
+        aabb_tree_single_component.m_proxies.erase(proxy);
+    }
+}
+
+} // namespace hg
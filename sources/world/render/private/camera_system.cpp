@@ -3,6 +3,7 @@
 #include "world/render/camera_single_component.h"
 #include "world/render/camera_system.h"
 #include "world/render/render_tags.h"
+#include "world/shared/frame_pacing_single_component.h"
 #include "world/shared/transform_component.h"
 #include "world/shared/window_single_component.h"
 
@@ -23,6 +24,8 @@ void CameraSystem::update(float /*elapsed_time*/) {
     auto& window_single_component = world.ctx<WindowSingleComponent>();
 
     if (world.valid(camera_single_component.active_camera)) {
+        const glm::mat4 previous_view_projection_matrix = camera_single_component.view_projection_matrix;
+
         auto& transform_component = world.get<TransformComponent>(camera_single_component.active_camera);
 
         const glm::vec3 forward = transform_component.rotation * glm::vec3(0.f, 0.f, 1.f);
@@ -36,6 +39,10 @@ void CameraSystem::update(float /*elapsed_time*/) {
         camera_single_component.inverse_view_matrix = glm::inverse(camera_single_component.view_matrix);
         camera_single_component.inverse_projection_matrix = glm::inverse(camera_single_component.projection_matrix);
         camera_single_component.inverse_view_projection_matrix = glm::inverse(camera_single_component.view_projection_matrix);
+
+        if (camera_single_component.view_projection_matrix != previous_view_projection_matrix) {
+            world.ctx<FramePacingSingleComponent>().wake_up();
+        }
     }
 }
 
@@ -8,6 +8,7 @@
 #include "world/render/camera_single_component.h"
 #include "world/render/debug_draw_pass_single_component.h"
 #include "world/render/debug_draw_pass_system.h"
+#include "world/render/dynamic_resolution_single_component.h"
 #include "world/render/geometry_pass_single_component.h"
 #include "world/render/quad_single_component.h"
 #include "world/render/render_tags.h"
@@ -68,9 +69,9 @@ DebugDrawPassSystem::DebugDrawPassSystem(World& world)
     using namespace debug_draw_pass_system_details;
 
     auto& debug_draw_single_component = world.set<DebugDrawPassSingleComponent>();
-    auto& window_single_component = world.ctx<WindowSingleComponent>();
+    auto& dynamic_resolution_single_component = world.ctx<DynamicResolutionSingleComponent>();
 
-    reset(debug_draw_single_component, window_single_component.width, window_single_component.height);
+    reset(debug_draw_single_component, dynamic_resolution_single_component.texture_width, dynamic_resolution_single_component.texture_height);
 
     bgfx::RendererType::Enum type = bgfx::getRendererType();
 
@@ -114,13 +115,19 @@ DebugDrawPassSystem::~DebugDrawPassSystem() {
 void DebugDrawPassSystem::update(float /*elapsed_time*/) {
     auto& camera_single_component = world.ctx<CameraSingleComponent>();
     auto& debug_draw_single_component = world.ctx<DebugDrawPassSingleComponent>();
+    auto& dynamic_resolution_single_component = world.ctx<DynamicResolutionSingleComponent>();
     auto& quad_single_component = world.ctx<QuadSingleComponent>();
     auto& window_single_component = world.ctx<WindowSingleComponent>();
 
-    if (window_single_component.resized) {
-        reset(debug_draw_single_component, window_single_component.width, window_single_component.height);
+    if (dynamic_resolution_single_component.is_texture_resized) {
+        reset(debug_draw_single_component, dynamic_resolution_single_component.texture_width, dynamic_resolution_single_component.texture_height);
     }
 
+    // Offscreen pass shares depth with geometry pass, so it's rendered at the same dynamic resolution and then
+    // upscaled to the screen by onscreen pass.
+    bgfx::setViewRect(DEBUG_DRAW_OFFSCREEN_PASS, 0, 0, dynamic_resolution_single_component.width, dynamic_resolution_single_component.height);
+    bgfx::setViewRect(DEBUG_DRAW_ONSCREEN_PASS, 0, 0, window_single_component.width, window_single_component.height);
+
     bgfx::setViewTransform(DEBUG_DRAW_OFFSCREEN_PASS, glm::value_ptr(camera_single_component.view_matrix), glm::value_ptr(camera_single_component.projection_matrix));
     bgfx::touch(DEBUG_DRAW_OFFSCREEN_PASS);
 
@@ -130,6 +137,7 @@ void DebugDrawPassSystem::update(float /*elapsed_time*/) {
     bgfx::setIndexBuffer(quad_single_component.index_buffer, 0, QuadSingleComponent::NUM_INDICES);
 
     bgfx::setTexture(0, debug_draw_single_component.texture_uniform, debug_draw_single_component.color_texture);
+    bgfx::setUniform(quad_single_component.uv_scale_uniform, &dynamic_resolution_single_component.uv_scale);
 
     bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_CULL_CW | BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA));
 
@@ -157,9 +165,6 @@ void DebugDrawPassSystem::reset(DebugDrawPassSingleComponent& debug_draw_pass_si
     debug_draw_pass_single_component.buffer = bgfx::createFrameBuffer(static_cast<uint8_t>(std::size(attachments)), attachments, false);
 
     bgfx::setViewFrameBuffer(DEBUG_DRAW_OFFSCREEN_PASS, debug_draw_pass_single_component.buffer);
-    bgfx::setViewRect(DEBUG_DRAW_OFFSCREEN_PASS, 0, 0, width, height);
-
-    bgfx::setViewRect(DEBUG_DRAW_ONSCREEN_PASS, 0, 0, width, height);
 }
 
 dd::GlyphTextureHandle DebugDrawPassSystem::createGlyphTexture(int width, int height, const void* pixels) {
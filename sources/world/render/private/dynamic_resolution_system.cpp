@@ -0,0 +1,108 @@
+#include "core/ecs/system_descriptor.h"
+#include "core/ecs/world.h"
+#include "world/render/dynamic_resolution_single_component.h"
+#include "world/render/dynamic_resolution_system.h"
+#include "world/render/render_tags.h"
+#include "world/shared/window_single_component.h"
+
+#include <algorithm>
+#include <bgfx/bgfx.h>
+#include <cmath>
+
+namespace hg {
+
+namespace dynamic_resolution_system_details {
+
+/** Number of frames GPU time is averaged over before the scale is adjusted. bgfx statistics lag a frame or two behind,
+    so adjusting every frame would overshoot. */
+static const uint32_t ADJUSTMENT_INTERVAL = 8;
+
+/** Maximum scale change per adjustment. */
+static const float MAX_SCALE_STEP = 0.1f;
+
+/** Scale is increased only when GPU time is below this fraction of the target, so it doesn't oscillate. */
+static const float LOWER_THRESHOLD = 0.8f;
+
+/** After an adjustment GPU time is expected to be at this fraction of the target. */
+static const float TARGET_THRESHOLD = 0.9f;
+
+} // namespace dynamic_resolution_system_details
+
+SYSTEM_DESCRIPTOR(
+    SYSTEM(DynamicResolutionSystem),
+    TAGS(render),
+    BEFORE("GeometryPassSystem", "LightingPassSystem", "SkyboxPassSystem", "AAPassSystem", "DebugDrawPassSystem", "PickingPassSystem", "EditorSelectionSystem"),
+    AFTER("WindowSystem", "RenderFetchSystem")
+)
+
+DynamicResolutionSystem::DynamicResolutionSystem(World& world)
+        : NormalSystem(world) {
+    auto& dynamic_resolution_single_component = world.ctx_or_set<DynamicResolutionSingleComponent>();
+    dynamic_resolution_single_component.scale = dynamic_resolution_single_component.max_scale;
+    update_size(dynamic_resolution_single_component);
+
+    // Scene passes create their targets using the initial size.
+    dynamic_resolution_single_component.is_texture_resized = false;
+}
+
+void DynamicResolutionSystem::update(float /*elapsed_time*/) {
+    auto& dynamic_resolution_single_component = world.ctx<DynamicResolutionSingleComponent>();
+
+    update_scale(dynamic_resolution_single_component);
+    update_size(dynamic_resolution_single_component);
+}
+
+void DynamicResolutionSystem::update_scale(DynamicResolutionSingleComponent& dynamic_resolution_single_component) {
+    using namespace dynamic_resolution_system_details;
+
+    if (!dynamic_resolution_single_component.is_enabled) {
+        dynamic_resolution_single_component.scale = dynamic_resolution_single_component.max_scale;
+        m_gpu_time_sum = 0.f;
+        m_num_gpu_times = 0;
+        return;
+    }
+
+    const bgfx::Stats* const stats = bgfx::getStats();
+    if (stats->gpuTimerFreq > 0 && stats->gpuTimeEnd > stats->gpuTimeBegin) {
+        m_gpu_time_sum += static_cast<float>(static_cast<double>(stats->gpuTimeEnd - stats->gpuTimeBegin) * 1000.0 / static_cast<double>(stats->gpuTimerFreq));
+        m_num_gpu_times++;
+    }
+
+    if (m_num_gpu_times >= ADJUSTMENT_INTERVAL) {
+        const float gpu_time = m_gpu_time_sum / m_num_gpu_times;
+        const float target_gpu_time = dynamic_resolution_single_component.target_gpu_time;
+
+        if (gpu_time > target_gpu_time || gpu_time < target_gpu_time * LOWER_THRESHOLD) {
+            // GPU time of the scene passes is roughly proportional to the number of pixels, which is squared scale.
+            const float scale = dynamic_resolution_single_component.scale;
+            const float desired_scale = scale * std::sqrt(target_gpu_time * TARGET_THRESHOLD / gpu_time);
+            dynamic_resolution_single_component.scale = std::clamp(desired_scale, scale - MAX_SCALE_STEP, scale + MAX_SCALE_STEP);
+        }
+
+        m_gpu_time_sum = 0.f;
+        m_num_gpu_times = 0;
+    }
+
+    dynamic_resolution_single_component.scale = std::clamp(dynamic_resolution_single_component.scale, dynamic_resolution_single_component.min_scale, dynamic_resolution_single_component.max_scale);
+}
+
+void DynamicResolutionSystem::update_size(DynamicResolutionSingleComponent& dynamic_resolution_single_component) const {
+    auto& window_single_component = world.ctx<WindowSingleComponent>();
+
+    const auto texture_width = static_cast<uint16_t>(std::max(std::ceil(window_single_component.width * dynamic_resolution_single_component.max_scale), 1.f));
+    const auto texture_height = static_cast<uint16_t>(std::max(std::ceil(window_single_component.height * dynamic_resolution_single_component.max_scale), 1.f));
+
+    dynamic_resolution_single_component.is_texture_resized = texture_width != dynamic_resolution_single_component.texture_width ||
+                                                             texture_height != dynamic_resolution_single_component.texture_height;
+
+    dynamic_resolution_single_component.texture_width = texture_width;
+    dynamic_resolution_single_component.texture_height = texture_height;
+
+    dynamic_resolution_single_component.width = static_cast<uint16_t>(std::clamp(std::round(window_single_component.width * dynamic_resolution_single_component.scale), 1.f, static_cast<float>(texture_width)));
+    dynamic_resolution_single_component.height = static_cast<uint16_t>(std::clamp(std::round(window_single_component.height * dynamic_resolution_single_component.scale), 1.f, static_cast<float>(texture_height)));
+
+    dynamic_resolution_single_component.uv_scale = glm::vec4(static_cast<float>(dynamic_resolution_single_component.width) / texture_width,
+                                                             static_cast<float>(dynamic_resolution_single_component.height) / texture_height, 0.f, 0.f);
+}
+
+} // namespace hg
@@ -2,15 +2,20 @@
 #include "core/ecs/world.h"
 #include "core/render/render_pass.h"
 #include "core/resource/texture.h"
+#include "shaders/geometry_array_pass/geometry_array_pass.fragment.h"
 #include "shaders/geometry_blockout_pass/geometry_blockout_pass.vertex.h"
 #include "shaders/geometry_pass/geometry_pass.fragment.h"
 #include "shaders/geometry_pass/geometry_pass.vertex.h"
 #include "world/render/blockout_component.h"
 #include "world/render/camera_single_component.h"
+#include "world/render/dynamic_resolution_single_component.h"
 #include "world/render/geometry_pass_single_component.h"
 #include "world/render/geometry_pass_system.h"
+#include "world/render/lod_utils.h"
+#include "world/render/occlusion_culling_single_component.h"
+#include "world/render/picking_pass_single_component.h"
 #include "world/render/render_tags.h"
-#include "world/shared/window_single_component.h"
+#include "world/render/static_geometry_single_component.h"
 
 #include <bgfx/bgfx.h>
 #include <bgfx/embedded_shader.h>
@@ -32,6 +37,18 @@ static const bgfx::EmbeddedShader GEOMETRY_BLOCKOUT_PASS_SHADER[] = {
         BGFX_EMBEDDED_SHADER_END()
 };
 
+static const bgfx::EmbeddedShader GEOMETRY_ARRAY_PASS_SHADER[] = {
+        BGFX_EMBEDDED_SHADER(geometry_pass_vertex),
+        BGFX_EMBEDDED_SHADER(geometry_array_pass_fragment),
+        BGFX_EMBEDDED_SHADER_END()
+};
+
+static const bgfx::EmbeddedShader GEOMETRY_BLOCKOUT_ARRAY_PASS_SHADER[] = {
+        BGFX_EMBEDDED_SHADER(geometry_blockout_pass_vertex),
+        BGFX_EMBEDDED_SHADER(geometry_array_pass_fragment),
+        BGFX_EMBEDDED_SHADER_END()
+};
+
 static const uint64_t ATTACHMENT_FLAGS = BGFX_TEXTURE_RT | BGFX_SAMPLER_MIN_POINT | BGFX_SAMPLER_MAG_POINT | BGFX_SAMPLER_MIP_POINT | BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP;
 
 } // namespace render_system_details
@@ -46,10 +63,19 @@ SYSTEM_DESCRIPTOR(
 struct GeometryPassSystem::DrawNodeContext final {
     bgfx::UniformHandle color_roughness_uniform   = BGFX_INVALID_HANDLE;
     bgfx::UniformHandle normal_metal_ao_uniform   = BGFX_INVALID_HANDLE;
+    bgfx::UniformHandle entity_uniform            = BGFX_INVALID_HANDLE;
+    bgfx::UniformHandle material_layer_uniform    = BGFX_INVALID_HANDLE;
+    bgfx::UniformHandle position_offset_uniform   = BGFX_INVALID_HANDLE;
+    bgfx::UniformHandle position_scale_uniform    = BGFX_INVALID_HANDLE;
 
     const Texture* color_roughness = nullptr;
     const Texture* normal_metal_ao = nullptr;
 
+    glm::vec4 entity;
+    glm::vec4 material_layer = glm::vec4(0.f);
+
+    size_t lod = 0;
+
     bgfx::ProgramHandle program    = BGFX_INVALID_HANDLE;
 };
 
@@ -58,10 +84,10 @@ GeometryPassSystem::GeometryPassSystem(World& world)
         , m_group(world.group<ModelComponent, MaterialComponent, TransformComponent>()) {
     using namespace geometry_pass_system_details;
 
+    auto& dynamic_resolution_single_component = world.ctx<DynamicResolutionSingleComponent>();
     auto& geometry_pass_single_component = world.set<GeometryPassSingleComponent>();
-    auto& window_single_component = world.ctx<WindowSingleComponent>();
 
-    reset(geometry_pass_single_component, window_single_component.width, window_single_component.height);
+    reset(geometry_pass_single_component, dynamic_resolution_single_component.texture_width, dynamic_resolution_single_component.texture_height);
     
     bgfx::RendererType::Enum type = bgfx::getRendererType();
 
@@ -73,8 +99,20 @@ GeometryPassSystem::GeometryPassSystem(World& world)
     fragment_shader_handle = bgfx::createEmbeddedShader(GEOMETRY_BLOCKOUT_PASS_SHADER, type, "geometry_pass_fragment");
     geometry_pass_single_component.geometry_blockout_pass_program = bgfx::createProgram(vertex_shader_handle, fragment_shader_handle, true);
 
+    vertex_shader_handle   = bgfx::createEmbeddedShader(GEOMETRY_ARRAY_PASS_SHADER, type, "geometry_pass_vertex");
+    fragment_shader_handle = bgfx::createEmbeddedShader(GEOMETRY_ARRAY_PASS_SHADER, type, "geometry_array_pass_fragment");
+    geometry_pass_single_component.geometry_array_pass_program = bgfx::createProgram(vertex_shader_handle, fragment_shader_handle, true);
+
+    vertex_shader_handle   = bgfx::createEmbeddedShader(GEOMETRY_BLOCKOUT_ARRAY_PASS_SHADER, type, "geometry_blockout_pass_vertex");
+    fragment_shader_handle = bgfx::createEmbeddedShader(GEOMETRY_BLOCKOUT_ARRAY_PASS_SHADER, type, "geometry_array_pass_fragment");
+    geometry_pass_single_component.geometry_blockout_array_pass_program = bgfx::createProgram(vertex_shader_handle, fragment_shader_handle, true);
+
     geometry_pass_single_component.color_roughness_uniform   = bgfx::createUniform("s_color_roughness",   bgfx::UniformType::Sampler);
     geometry_pass_single_component.normal_metal_ao_uniform   = bgfx::createUniform("s_normal_metal_ao",   bgfx::UniformType::Sampler);
+    geometry_pass_single_component.entity_uniform            = bgfx::createUniform("u_entity",            bgfx::UniformType::Vec4);
+    geometry_pass_single_component.material_layer_uniform    = bgfx::createUniform("u_material_layer",    bgfx::UniformType::Vec4);
+    geometry_pass_single_component.position_offset_uniform   = bgfx::createUniform("u_position_offset",   bgfx::UniformType::Vec4);
+    geometry_pass_single_component.position_scale_uniform    = bgfx::createUniform("u_position_scale",    bgfx::UniformType::Vec4);
 
     bgfx::setViewClear(GEOMETRY_PASS, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH | BGFX_CLEAR_STENCIL, 0xFFFFFFFF, 1.f, 0);
     bgfx::setViewName(GEOMETRY_PASS, "geometry_pass");
@@ -90,51 +128,102 @@ GeometryPassSystem::~GeometryPassSystem() {
     };
 
     destroy_valid(geometry_pass_single_component.color_roughness_uniform);
+    destroy_valid(geometry_pass_single_component.entity_uniform);
     destroy_valid(geometry_pass_single_component.gbuffer);
+    destroy_valid(geometry_pass_single_component.geometry_array_pass_program);
+    destroy_valid(geometry_pass_single_component.geometry_blockout_array_pass_program);
     destroy_valid(geometry_pass_single_component.geometry_blockout_pass_program);
     destroy_valid(geometry_pass_single_component.geometry_pass_program);
+    destroy_valid(geometry_pass_single_component.material_layer_uniform);
     destroy_valid(geometry_pass_single_component.normal_metal_ao_uniform);
+    destroy_valid(geometry_pass_single_component.position_offset_uniform);
+    destroy_valid(geometry_pass_single_component.position_scale_uniform);
 }
 
 void GeometryPassSystem::update(float /*elapsed_time*/) {
     auto& camera_single_component = world.ctx<CameraSingleComponent>();
+    auto& dynamic_resolution_single_component = world.ctx<DynamicResolutionSingleComponent>();
     auto& geometry_pass_single_component = world.ctx<GeometryPassSingleComponent>();
-    auto& window_single_component = world.ctx<WindowSingleComponent>();
+    auto& occlusion_culling_single_component = world.ctx<OcclusionCullingSingleComponent>();
+    auto& picking_pass_single_component = world.ctx<PickingPassSingleComponent>();
+    auto& static_geometry_single_component = world.ctx<StaticGeometrySingleComponent>();
 
-    if (window_single_component.resized) {
-        reset(geometry_pass_single_component, window_single_component.width, window_single_component.height);
+    if (dynamic_resolution_single_component.is_texture_resized) {
+        reset(geometry_pass_single_component, dynamic_resolution_single_component.texture_width, dynamic_resolution_single_component.texture_height);
     }
 
+    bgfx::setViewRect(GEOMETRY_PASS, 0, 0, dynamic_resolution_single_component.width, dynamic_resolution_single_component.height);
     bgfx::setViewTransform(GEOMETRY_PASS, glm::value_ptr(camera_single_component.view_matrix), glm::value_ptr(camera_single_component.projection_matrix));
 
     DrawNodeContext context;
     context.color_roughness_uniform   = geometry_pass_single_component.color_roughness_uniform;
     context.normal_metal_ao_uniform   = geometry_pass_single_component.normal_metal_ao_uniform;
+    context.entity_uniform            = geometry_pass_single_component.entity_uniform;
+    context.material_layer_uniform    = geometry_pass_single_component.material_layer_uniform;
+    context.position_offset_uniform   = geometry_pass_single_component.position_offset_uniform;
+    context.position_scale_uniform    = geometry_pass_single_component.position_scale_uniform;
 
     bgfx::touch(GEOMETRY_PASS);
+
+    occlusion_culling_single_component.wait();
+
+    // Merged chunks have no entity identifiers, so the frame that is picked from draws merged entities one by one.
+    const bool is_merging_enabled = static_geometry_single_component.is_enabled && !picking_pass_single_component.perform_picking;
     
     m_group.each([&](entt::entity entity, ModelComponent& model_component, MaterialComponent& material_component, TransformComponent& transform_component) {
-        if (material_component.color_roughness != nullptr && material_component.normal_metal_ao != nullptr && !model_component.model.children.empty()) {
+        if (material_component.color_roughness != nullptr && material_component.normal_metal_ao != nullptr && !model_component.model.children.empty() &&
+            (!is_merging_enabled || !static_geometry_single_component.is_merged(entity)) && occlusion_culling_single_component.is_visible(entity)) {
             context.color_roughness   = material_component.color_roughness;
             context.normal_metal_ao   = material_component.normal_metal_ao;
+            context.material_layer.x  = static_cast<float>(material_component.layer);
+
+            // Materials packed into the same texture arrays are drawn with identical bindings.
+            const bool is_texture_array = context.color_roughness->num_layers > 1;
+
+            // Entity texture is BGRA8, so after the read back these four bytes form the original entity identifier.
+            const auto entity_index = static_cast<uint32_t>(entity);
+            context.entity.x = ((entity_index >> 16) & 0xFF) / 255.f;
+            context.entity.y = ((entity_index >> 8) & 0xFF) / 255.f;
+            context.entity.z = (entity_index & 0xFF) / 255.f;
+            context.entity.w = ((entity_index >> 24) & 0xFF) / 255.f;
 
             glm::mat4 transform = glm::translate(glm::mat4(1.f), transform_component.translation);
             transform = transform * glm::mat4_cast(transform_component.rotation);
             transform = glm::scale(transform, transform_component.scale);
 
+            context.lod = LodUtils::get_lod(camera_single_component, model_component.model.bounds, transform);
+
             if (!world.has<BlockoutComponent>(entity)) {
-                context.program = geometry_pass_single_component.geometry_pass_program;
+                context.program = is_texture_array ? geometry_pass_single_component.geometry_array_pass_program : geometry_pass_single_component.geometry_pass_program;
                 for (const Model::Node& node : model_component.model.children) {
                     draw_node(context, node, transform);
                 }
             } else {
-                context.program = geometry_pass_single_component.geometry_blockout_pass_program;
+                context.program = is_texture_array ? geometry_pass_single_component.geometry_blockout_array_pass_program : geometry_pass_single_component.geometry_blockout_pass_program;
                 for (const Model::Node& node : model_component.model.children) {
                     draw_node(context, node, transform);
                 }
             }
         }
     });
+
+    if (is_merging_enabled) {
+        std::vector<const StaticGeometrySingleComponent::Chunk*> chunks;
+        static_geometry_single_component.query_frustum(camera_single_component.view_projection_matrix, chunks);
+
+        // Chunks are never picked from, null entity identifier has all bits set.
+        context.entity = glm::vec4(1.f);
+        context.lod = 0;
+
+        for (const StaticGeometrySingleComponent::Chunk* chunk : chunks) {
+            context.color_roughness = chunk->color_roughness;
+            context.normal_metal_ao = chunk->normal_metal_ao;
+            context.material_layer.x = static_cast<float>(chunk->layer);
+            context.program = chunk->color_roughness->num_layers > 1 ? geometry_pass_single_component.geometry_array_pass_program : geometry_pass_single_component.geometry_pass_program;
+
+            draw_primitive(context, chunk->primitive, glm::mat4(1.f));
+        }
+    }
 }
 
 void GeometryPassSystem::reset(GeometryPassSingleComponent& geometry_pass_single_component, uint16_t width, uint16_t height) const {
@@ -156,17 +245,20 @@ void GeometryPassSystem::reset(GeometryPassSingleComponent& geometry_pass_single
     geometry_pass_single_component.depth_stencil_texture = bgfx::createTexture2D(width, height, false, 1, bgfx::TextureFormat::D24S8, ATTACHMENT_FLAGS);
     bgfx::setName(geometry_pass_single_component.depth_stencil_texture, "geometry_pass_output_depth_stencil");
 
+    geometry_pass_single_component.entity_texture = bgfx::createTexture2D(width, height, false, 1, bgfx::TextureFormat::BGRA8, ATTACHMENT_FLAGS);
+    bgfx::setName(geometry_pass_single_component.entity_texture, "geometry_pass_output_entity");
+
     const bgfx::TextureHandle attachments[] = {
             geometry_pass_single_component.color_roughness_texture,
             geometry_pass_single_component.normal_metal_ao_texture,
             geometry_pass_single_component.depth_texture,
+            geometry_pass_single_component.entity_texture,
             geometry_pass_single_component.depth_stencil_texture
     };
 
     geometry_pass_single_component.gbuffer = bgfx::createFrameBuffer(static_cast<uint8_t>(std::size(attachments)), attachments, true);
 
     bgfx::setViewFrameBuffer(GEOMETRY_PASS, geometry_pass_single_component.gbuffer);
-    bgfx::setViewRect(GEOMETRY_PASS, 0, 0, width, height);
 }
 
 void GeometryPassSystem::draw_node(const DrawNodeContext& context, const Model::Node& node, const glm::mat4& transform) const {
@@ -178,28 +270,7 @@ void GeometryPassSystem::draw_node(const DrawNodeContext& context, const Model::
 
     if (node.mesh) {
         for (const Model::Primitive& primitive : node.mesh->primitives) {
-            assert(bgfx::isValid(primitive.vertex_buffer));
-            assert(bgfx::isValid(primitive.index_buffer));
-            
-            bgfx::setVertexBuffer(0, primitive.vertex_buffer, 0, static_cast<uint32_t>(primitive.num_vertices));
-            bgfx::setIndexBuffer(primitive.index_buffer, 0, static_cast<uint32_t>(primitive.num_indices));
-
-            assert(bgfx::isValid(context.color_roughness_uniform));
-            assert(bgfx::isValid(context.normal_metal_ao_uniform));
-            
-            bgfx::setTexture(0, context.color_roughness_uniform, context.color_roughness->handle);
-            bgfx::setTexture(1, context.normal_metal_ao_uniform, context.normal_metal_ao->handle);
-
-            bgfx::setTransform(glm::value_ptr(world_transform), 1);
-
-            bgfx::setStencil(BGFX_STENCIL_TEST_ALWAYS | BGFX_STENCIL_FUNC_REF(1) | BGFX_STENCIL_FUNC_RMASK(0xFF) |
-                             BGFX_STENCIL_OP_FAIL_S_REPLACE | BGFX_STENCIL_OP_FAIL_Z_REPLACE | BGFX_STENCIL_OP_PASS_Z_REPLACE,
-                             BGFX_STENCIL_NONE);
-            bgfx::setState(BGFX_STATE_WRITE_MASK | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_CULL_CW);
-
-            assert(bgfx::isValid(context.program));
-            
-            bgfx::submit(GEOMETRY_PASS, context.program);
+            draw_primitive(context, primitive, world_transform);
         }
     }
 
@@ -208,4 +279,45 @@ void GeometryPassSystem::draw_node(const DrawNodeContext& context, const Model::
     }
 }
 
+void GeometryPassSystem::draw_primitive(const DrawNodeContext& context, const Model::Primitive& primitive, const glm::mat4& transform) const {
+    assert(bgfx::isValid(primitive.vertex_buffer));
+    assert(bgfx::isValid(primitive.index_buffer));
+    
+    bgfx::setVertexBuffer(0, primitive.vertex_buffer, 0, static_cast<uint32_t>(primitive.num_vertices));
+    LodUtils::set_index_buffer(primitive, context.lod);
+
+    assert(bgfx::isValid(context.color_roughness_uniform));
+    assert(bgfx::isValid(context.normal_metal_ao_uniform));
+    
+    bgfx::setTexture(0, context.color_roughness_uniform, context.color_roughness->handle);
+    bgfx::setTexture(1, context.normal_metal_ao_uniform, context.normal_metal_ao->handle);
+
+    assert(bgfx::isValid(context.entity_uniform));
+
+    bgfx::setUniform(context.entity_uniform, glm::value_ptr(context.entity));
+
+    if (context.color_roughness->num_layers > 1) {
+        assert(bgfx::isValid(context.material_layer_uniform));
+
+        bgfx::setUniform(context.material_layer_uniform, glm::value_ptr(context.material_layer));
+    }
+
+    assert(bgfx::isValid(context.position_offset_uniform));
+    assert(bgfx::isValid(context.position_scale_uniform));
+
+    bgfx::setUniform(context.position_offset_uniform, glm::value_ptr(primitive.position_offset));
+    bgfx::setUniform(context.position_scale_uniform, glm::value_ptr(primitive.position_scale));
+
+    bgfx::setTransform(glm::value_ptr(transform), 1);
+
+    bgfx::setStencil(BGFX_STENCIL_TEST_ALWAYS | BGFX_STENCIL_FUNC_REF(1) | BGFX_STENCIL_FUNC_RMASK(0xFF) |
+                     BGFX_STENCIL_OP_FAIL_S_REPLACE | BGFX_STENCIL_OP_FAIL_Z_REPLACE | BGFX_STENCIL_OP_PASS_Z_REPLACE,
+                     BGFX_STENCIL_NONE);
+    bgfx::setState(BGFX_STATE_WRITE_MASK | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_CULL_CW);
+
+    assert(bgfx::isValid(context.program));
+    
+    bgfx::submit(GEOMETRY_PASS, context.program);
+}
+
 } // namespace hg
@@ -1,9 +1,11 @@
 #include "core/ecs/system_descriptor.h"
 #include "core/ecs/world.h"
 #include "core/render/render_pass.h"
+#include "core/resource/resource_id.h"
 #include "shaders/lighting_pass/lighting_pass.fragment.h"
 #include "shaders/lighting_pass/lighting_pass.vertex.h"
 #include "world/render/camera_single_component.h"
+#include "world/render/dynamic_resolution_single_component.h"
 #include "world/render/geometry_pass_single_component.h"
 #include "world/render/light_component.h"
 #include "world/render/lighting_pass_single_component.h"
@@ -12,7 +14,6 @@
 #include "world/render/render_tags.h"
 #include "world/render/texture_single_component.h"
 #include "world/shared/transform_component.h"
-#include "world/shared/window_single_component.h"
 
 #include <bgfx/embedded_shader.h>
 #include <debug_draw.hpp>
@@ -30,6 +31,11 @@ static const bgfx::EmbeddedShader LIGHTING_PASS_SHADER[] = {
 
 static const uint64_t ATTACHMENT_FLAGS = BGFX_TEXTURE_RT | BGFX_SAMPLER_MIN_POINT | BGFX_SAMPLER_MAG_POINT | BGFX_SAMPLER_MIP_POINT | BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP;
 
+// TODO: Get actual skybox from level file or something.
+static const ResourceId IRRADIANCE_TEXTURE("house_irradiance.dds");
+static const ResourceId PREFILTER_TEXTURE("house_prefilter.dds");
+static const ResourceId BRDF_LUT_TEXTURE("brdf_lut.dds");
+
 } // namespace lighting_pass_system_details
 
 SYSTEM_DESCRIPTOR(
@@ -43,8 +49,8 @@ LightingPassSystem::LightingPassSystem(World& world)
         : NormalSystem(world) {
     using namespace lighting_pass_system_details;
 
+    auto& dynamic_resolution_single_component = world.ctx<DynamicResolutionSingleComponent>();
     auto& lighting_pass_single_component = world.set<LightingPassSingleComponent>();
-    auto& window_single_component = world.ctx<WindowSingleComponent>();
 
     bgfx::RendererType::Enum type = bgfx::getRendererType();
     bgfx::ShaderHandle vertex_shader_handle   = bgfx::createEmbeddedShader(LIGHTING_PASS_SHADER, type, "lighting_pass_vertex");
@@ -56,13 +62,14 @@ LightingPassSystem::LightingPassSystem(World& world)
     lighting_pass_single_component.light_color_uniform         = bgfx::createUniform("u_light_color",         bgfx::UniformType::Vec4);
     lighting_pass_single_component.light_position_uniform      = bgfx::createUniform("u_light_position",      bgfx::UniformType::Vec4);
     lighting_pass_single_component.normal_metal_ao_uniform     = bgfx::createUniform("s_normal_metal_ao",     bgfx::UniformType::Sampler);
+    lighting_pass_single_component.uv_scale_uniform            = bgfx::createUniform("u_uv_scale",            bgfx::UniformType::Vec4);
 
     lighting_pass_single_component.skybox_texture_irradiance_uniform = bgfx::createUniform("s_skybox_irradiance", bgfx::UniformType::Sampler);
     lighting_pass_single_component.skybox_texture_lut_uniform        = bgfx::createUniform("s_skybox_lut",        bgfx::UniformType::Sampler);
     lighting_pass_single_component.skybox_texture_prefilter_uniform  = bgfx::createUniform("s_skybox_prefilter",  bgfx::UniformType::Sampler);
     lighting_pass_single_component.skybox_mip_prefilter_max_uniform  = bgfx::createUniform("u_mip_prefilter_max", bgfx::UniformType::Vec4);
 
-    reset(lighting_pass_single_component, window_single_component.width, window_single_component.height);
+    reset(lighting_pass_single_component, dynamic_resolution_single_component.texture_width, dynamic_resolution_single_component.texture_height);
 
     bgfx::setViewClear(LIGHTING_PASS, BGFX_CLEAR_COLOR, 0x00000000, 1.f, 0);
     bgfx::setViewName(LIGHTING_PASS, "lighting_pass");
@@ -86,6 +93,7 @@ LightingPassSystem::~LightingPassSystem() {
     destroy_valid(lighting_pass_single_component.lighting_pass_program);
     destroy_valid(lighting_pass_single_component.normal_metal_ao_uniform);
     destroy_valid(lighting_pass_single_component.texture_uniform);
+    destroy_valid(lighting_pass_single_component.uv_scale_uniform);
 
     destroy_valid(lighting_pass_single_component.skybox_mip_prefilter_max_uniform);
     destroy_valid(lighting_pass_single_component.skybox_texture_irradiance_uniform);
@@ -94,21 +102,24 @@ LightingPassSystem::~LightingPassSystem() {
 }
 
 void LightingPassSystem::update(float /*elapsed_time*/) {
+    using namespace lighting_pass_system_details;
+
     auto& camera_single_component = world.ctx<CameraSingleComponent>();
+    auto& dynamic_resolution_single_component = world.ctx<DynamicResolutionSingleComponent>();
     auto& geometry_pass_single_component = world.ctx<GeometryPassSingleComponent>();
     auto& lighting_pass_single_component = world.ctx<LightingPassSingleComponent>();
     auto& quad_single_component = world.ctx<QuadSingleComponent>();
     auto& texture_single_component = world.ctx<TextureSingleComponent>();
-    auto& window_single_component = world.ctx<WindowSingleComponent>();
 
-    if (window_single_component.resized) {
-        reset(lighting_pass_single_component, window_single_component.width, window_single_component.height);
+    if (dynamic_resolution_single_component.is_texture_resized) {
+        reset(lighting_pass_single_component, dynamic_resolution_single_component.texture_width, dynamic_resolution_single_component.texture_height);
     }
 
-    // TODO: Get actual skybox from level file or something.
-    const Texture& irradiance_texture = texture_single_component.get("house_irradiance.dds");
-    const Texture& prefilter_texture = texture_single_component.get("house_prefilter.dds");
-    const Texture& brdf_lut_texture = texture_single_component.get("brdf_lut.dds");
+    bgfx::setViewRect(LIGHTING_PASS, 0, 0, dynamic_resolution_single_component.width, dynamic_resolution_single_component.height);
+
+    const Texture& irradiance_texture = texture_single_component.get(IRRADIANCE_TEXTURE);
+    const Texture& prefilter_texture = texture_single_component.get(PREFILTER_TEXTURE);
+    const Texture& brdf_lut_texture = texture_single_component.get(BRDF_LUT_TEXTURE);
 
     if (!irradiance_texture.is_cube_map || !prefilter_texture.is_cube_map) {
         // Skybox textures are missing.
@@ -129,6 +140,7 @@ void LightingPassSystem::update(float /*elapsed_time*/) {
 
     const glm::vec4 mip_prefilter_max(4.f, 0.f, 0.f, 0.f);
     bgfx::setUniform(lighting_pass_single_component.skybox_mip_prefilter_max_uniform, &mip_prefilter_max);
+    bgfx::setUniform(lighting_pass_single_component.uv_scale_uniform, &dynamic_resolution_single_component.uv_scale);
 
     world.view<LightComponent, TransformComponent>().each([&](entt::entity, LightComponent& light_component, TransformComponent& transform_component) {
         const glm::vec4 light_position(transform_component.translation, 0.f);
@@ -167,7 +179,6 @@ void LightingPassSystem::reset(LightingPassSingleComponent &lighting_pass_single
     lighting_pass_single_component.buffer = bgfx::createFrameBuffer(static_cast<uint8_t>(std::size(attachments)), attachments, false);
 
     bgfx::setViewFrameBuffer(LIGHTING_PASS, lighting_pass_single_component.buffer);
-    bgfx::setViewRect(LIGHTING_PASS, 0, 0, width, height);
 }
 
 } // namespace hg
@@ -0,0 +1,55 @@
+#include "world/render/camera_single_component.h"
+#include "world/render/lod_utils.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <glm/geometric.hpp>
+
+namespace hg {
+
+namespace lod_utils_details {
+
+/** Level of detail `i + 1` is used when bounding sphere diameter is smaller than `LOD_SCREEN_SIZES[i]` of the screen
+    height. Each level allows twice the simplification error of the previous one, so these sizes keep the error
+    around a couple of pixels. */
+static const float LOD_SCREEN_SIZES[] = { 0.5f, 0.25f, 0.125f };
+
+} // namespace lod_utils_details
+
+size_t LodUtils::get_lod(const CameraSingleComponent& camera_single_component, const Model::AABB& bounds, const glm::mat4& transform) {
+    using namespace lod_utils_details;
+
+    const glm::vec3 min(bounds.min_x, bounds.min_y, bounds.min_z);
+    const glm::vec3 max(bounds.max_x, bounds.max_y, bounds.max_z);
+
+    const float scale = std::max(std::max(glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1]))), glm::length(glm::vec3(transform[2])));
+    const float radius = glm::length(max - min) * 0.5f * scale;
+    const glm::vec3 center(transform * glm::vec4((min + max) * 0.5f, 1.f));
+
+    const float distance = glm::distance(center, camera_single_component.translation);
+    if (distance <= radius) {
+        return 0;
+    }
+
+    const float screen_size = radius / (distance * std::tan(camera_single_component.fov * 0.5f));
+
+    size_t result = 0;
+    while (result < std::size(LOD_SCREEN_SIZES) && screen_size < LOD_SCREEN_SIZES[result]) {
+        result++;
+    }
+    return result;
+}
+
+void LodUtils::set_index_buffer(const Model::Primitive& primitive, size_t lod) {
+    if (lod == 0 || primitive.lods.empty()) {
+        assert(bgfx::isValid(primitive.index_buffer));
+        bgfx::setIndexBuffer(primitive.index_buffer, 0, static_cast<uint32_t>(primitive.num_indices));
+    } else {
+        const Model::Lod& primitive_lod = primitive.lods[std::min(lod, primitive.lods.size()) - 1];
+        assert(bgfx::isValid(primitive_lod.index_buffer));
+        bgfx::setIndexBuffer(primitive_lod.index_buffer, 0, static_cast<uint32_t>(primitive_lod.num_indices));
+    }
+}
+
+} // namespace hg
@@ -1,8 +1,6 @@
 #include "core/resource/model.h"
 #include "world/render/model_single_component.h"
 
-#include <ghc/filesystem.hpp>
-
 namespace hg {
 
 ModelSingleComponent::ModelSingleComponent() = default;
@@ -11,9 +9,8 @@ ModelSingleComponent& ModelSingleComponent::operator=(ModelSingleComponent&& ano
 ModelSingleComponent::~ModelSingleComponent() = default;
 
 
-const Model* ModelSingleComponent::get(const std::string& name) const {
-    const std::string normalized_name = ghc::filesystem::path(name).lexically_normal().string();
-    if (auto result = m_models.find(normalized_name); result != m_models.end()) {
+const Model* ModelSingleComponent::get(ResourceId id) const {
+    if (auto result = m_models.find(id); result != m_models.end()) {
         return result->second.get();
     }
     return nullptr;
@@ -0,0 +1,50 @@
+#include "core/base/worker_pool.h"
+#include "world/render/aabb_tree_single_component.h"
+#include "world/render/occlusion_culling_single_component.h"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+namespace hg {
+
+namespace occlusion_culling_single_component_details {
+
+static const size_t MAX_THREADS = 4;
+
+} // namespace occlusion_culling_single_component_details
+
+OcclusionCullingSingleComponent::OcclusionCullingSingleComponent()
+        : m_buffer(BUFFER_WIDTH, BUFFER_HEIGHT)
+        , m_view_projection(1.f)
+        , m_worker_pool(std::make_unique<WorkerPool>(std::clamp(static_cast<size_t>(std::thread::hardware_concurrency()), size_t(1),
+                                                                occlusion_culling_single_component_details::MAX_THREADS))) {
+}
+
+OcclusionCullingSingleComponent::OcclusionCullingSingleComponent(OcclusionCullingSingleComponent&& another) = default;
+OcclusionCullingSingleComponent& OcclusionCullingSingleComponent::operator=(OcclusionCullingSingleComponent&& another) = default;
+
+OcclusionCullingSingleComponent::~OcclusionCullingSingleComponent() {
+    // Worker threads access this component, so they must be finished before it's destroyed.
+    if (m_task.valid()) {
+        m_task.wait();
+    }
+}
+
+void OcclusionCullingSingleComponent::wait() {
+    if (m_task.valid()) {
+        m_task.get();
+    }
+}
+
+bool OcclusionCullingSingleComponent::is_visible(entt::entity entity) const {
+    if (!m_has_result) {
+        return true;
+    }
+
+    assert(!m_task.valid());
+    assert(m_aabb_tree != nullptr);
+    return std::binary_search(m_visible_entities.begin(), m_visible_entities.end(), entity) || !m_aabb_tree->contains(entity);
+}
+
+} // namespace hg
@@ -0,0 +1,197 @@
+#include "core/base/worker_pool.h"
+#include "core/ecs/system_descriptor.h"
+#include "core/ecs/world.h"
+#include "world/render/aabb_tree_single_component.h"
+#include "world/render/blockout_component.h"
+#include "world/render/camera_single_component.h"
+#include "world/render/model_component.h"
+#include "world/render/occlusion_culling_single_component.h"
+#include "world/render/occlusion_culling_system.h"
+#include "world/render/render_single_component.h"
+#include "world/render/render_tags.h"
+#include "world/shared/normal_input_single_component.h"
+#include "world/shared/transform_component.h"
+
+#include <algorithm>
+#include <bgfx/bgfx.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace hg {
+
+namespace occlusion_culling_system_details {
+
+/** Only boxes are rasterized as occluders, other blockout models don't fill their bounds. */
+static const char* const BLOCKOUT_MODEL = "blockout.glb";
+
+/** Call `callback(first, last)` for `count` items split into ranges, one range per pool thread. Must be called from
+    a pool task, which takes one of the threads, so every pushed range has a free thread. */
+template <typename T>
+void parallel_for(WorkerPool& worker_pool, size_t count, T callback) {
+    const size_t num_threads = worker_pool.get_num_threads();
+    const size_t range_size = (count + num_threads - 1) / num_threads;
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(num_threads);
+
+    for (size_t first = range_size; first < count; first += range_size) {
+        futures.push_back(worker_pool.push([callback, first, last = std::min(first + range_size, count)]() {
+            callback(first, last);
+        }));
+    }
+
+    // The first range is processed on the calling thread.
+    callback(size_t(0), std::min(range_size, count));
+
+    for (std::future<void>& future : futures) {
+        future.get();
+    }
+}
+
+} // namespace occlusion_culling_system_details
+
+SYSTEM_DESCRIPTOR(
+    SYSTEM(OcclusionCullingSystem),
+    TAGS(render),
+    BEFORE("GeometryPassSystem", "RenderSystem"),
+    AFTER("WindowSystem", "RenderFetchSystem", "CameraSystem", "AABBTreeSystem")
+)
+
+OcclusionCullingSystem::OcclusionCullingSystem(World& world)
+        : NormalSystem(world) {
+    world.set<OcclusionCullingSingleComponent>();
+}
+
+OcclusionCullingSystem::~OcclusionCullingSystem() {
+    world.ctx<OcclusionCullingSingleComponent>().wait();
+}
+
+void OcclusionCullingSystem::update(float /*elapsed_time*/) {
+    using namespace occlusion_culling_system_details;
+
+    auto& aabb_tree_single_component = world.ctx<AABBTreeSingleComponent>();
+    auto& camera_single_component = world.ctx<CameraSingleComponent>();
+    auto& normal_input_single_component = world.ctx<NormalInputSingleComponent>();
+    auto& occlusion_culling_single_component = world.ctx<OcclusionCullingSingleComponent>();
+    auto& render_single_component = world.ctx<RenderSingleComponent>();
+
+    // Normally the previous frame's task is already finished by `GeometryPassSystem`.
+    occlusion_culling_single_component.wait();
+
+    if (normal_input_single_component.is_pressed(Control::KEY_F9)) {
+        occlusion_culling_single_component.is_enabled = !occlusion_culling_single_component.is_enabled;
+    }
+
+    if (render_single_component.show_debug_info) {
+        const uint16_t text_height = bgfx::getStats()->textHeight;
+        bgfx::dbgTextPrintf(0, text_height - 2, 0x0F, "Occlusion culling (F9): %s, occluders: %u, visible: %u, frustum culled: %u, occlusion culled: %u",
+                            occlusion_culling_single_component.is_enabled ? "on" : "off",
+                            occlusion_culling_single_component.num_occluders,
+                            occlusion_culling_single_component.num_visible,
+                            occlusion_culling_single_component.num_frustum_culled,
+                            occlusion_culling_single_component.num_occlusion_culled);
+    }
+
+    if (!occlusion_culling_single_component.is_enabled) {
+        occlusion_culling_single_component.m_has_result = false;
+        return;
+    }
+
+    const DynamicAABBTree& tree = aabb_tree_single_component.get_tree();
+
+    std::vector<uint32_t> frustum_entities;
+    tree.query_frustum(camera_single_component.view_projection_matrix, frustum_entities);
+
+    auto& occludees = occlusion_culling_single_component.m_occludees;
+    auto& occluders = occlusion_culling_single_component.m_occluders;
+    occludees.clear();
+    occluders.clear();
+
+    std::vector<std::pair<float, entt::entity>> occluder_candidates;
+
+    for (uint32_t value : frustum_entities) {
+        const auto entity = static_cast<entt::entity>(value);
+
+        OcclusionCullingSingleComponent::Occludee& occludee = occludees.emplace_back();
+        occludee.entity = entity;
+        [[maybe_unused]] const bool result = aabb_tree_single_component.get_bounds(entity, occludee.min, occludee.max);
+        assert(result);
+
+        if (world.has<BlockoutComponent>(entity) && world.get<ModelComponent>(entity).path == BLOCKOUT_MODEL) {
+            const glm::vec3 center = (occludee.min + occludee.max) * 0.5f;
+            occluder_candidates.emplace_back(glm::distance(center, camera_single_component.translation), entity);
+        }
+    }
+
+    if (occluder_candidates.size() > occlusion_culling_single_component.max_occluders) {
+        std::nth_element(occluder_candidates.begin(), occluder_candidates.begin() + occlusion_culling_single_component.max_occluders, occluder_candidates.end());
+        occluder_candidates.resize(occlusion_culling_single_component.max_occluders);
+    }
+
+    for (const auto& [distance, entity] : occluder_candidates) {
+        auto& model_component = world.get<ModelComponent>(entity);
+        auto& transform_component = world.get<TransformComponent>(entity);
+
+        glm::mat4 transform = glm::translate(glm::mat4(1.f), transform_component.translation);
+        transform = transform * glm::mat4_cast(transform_component.rotation);
+        transform = glm::scale(transform, transform_component.scale);
+
+        const Model::AABB& bounds = model_component.model.bounds;
+
+        OcclusionCullingSingleComponent::Occluder& occluder = occluders.emplace_back();
+        occluder.transform = camera_single_component.view_projection_matrix * transform;
+        occluder.min = glm::vec3(bounds.min_x, bounds.min_y, bounds.min_z);
+        occluder.max = glm::vec3(bounds.max_x, bounds.max_y, bounds.max_z);
+    }
+
+    // Tree entities outside of the frustum are culled, entities missing from the tree are never culled.
+    occlusion_culling_single_component.m_aabb_tree = &aabb_tree_single_component;
+    occlusion_culling_single_component.m_view_projection = camera_single_component.view_projection_matrix;
+    occlusion_culling_single_component.num_frustum_culled = static_cast<uint32_t>(tree.size() - occludees.size());
+    occlusion_culling_single_component.m_has_result = true;
+    occlusion_culling_single_component.m_task = occlusion_culling_single_component.m_worker_pool->push([&occlusion_culling_single_component]() {
+        cull(occlusion_culling_single_component);
+    });
+}
+
+void OcclusionCullingSystem::cull(OcclusionCullingSingleComponent& occlusion_culling_single_component) {
+    using namespace occlusion_culling_system_details;
+
+    OcclusionBuffer& buffer = occlusion_culling_single_component.m_buffer;
+    const auto& occluders = occlusion_culling_single_component.m_occluders;
+    const auto& occludees = occlusion_culling_single_component.m_occludees;
+    WorkerPool& worker_pool = *occlusion_culling_single_component.m_worker_pool;
+
+    buffer.clear();
+
+    // Each thread rasterizes all occluders, but writes only to its own rows.
+    parallel_for(worker_pool, buffer.get_height(), [&](size_t first_row, size_t last_row) {
+        for (const OcclusionCullingSingleComponent::Occluder& occluder : occluders) {
+            buffer.rasterize_box(occluder.transform, occluder.min, occluder.max, static_cast<uint32_t>(first_row), static_cast<uint32_t>(last_row));
+        }
+    });
+
+    std::vector<uint8_t> visibility(occludees.size());
+
+    parallel_for(worker_pool, occludees.size(), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            visibility[i] = buffer.test_box(occlusion_culling_single_component.m_view_projection, occludees[i].min, occludees[i].max);
+        }
+    });
+
+    auto& visible_entities = occlusion_culling_single_component.m_visible_entities;
+    visible_entities.clear();
+
+    for (size_t i = 0; i < occludees.size(); i++) {
+        if (visibility[i] != 0) {
+            visible_entities.push_back(occludees[i].entity);
+        }
+    }
+
+    std::sort(visible_entities.begin(), visible_entities.end());
+
+    occlusion_culling_single_component.num_occluders = static_cast<uint32_t>(occluders.size());
+    occlusion_culling_single_component.num_visible = static_cast<uint32_t>(visible_entities.size());
+    occlusion_culling_single_component.num_occlusion_culled = static_cast<uint32_t>(occludees.size() - visible_entities.size());
+}
+
+} // namespace hg
@@ -6,6 +6,7 @@
 #include "shaders/outline_pass/outline_pass.vertex.h"
 #include "shaders/quad_pass/quad_pass.vertex.h"
 #include "world/render/camera_single_component.h"
+#include "world/render/lod_utils.h"
 #include "world/render/outline_pass_single_component.h"
 #include "world/render/outline_pass_system.h"
 #include "world/render/quad_single_component.h"
@@ -62,9 +63,11 @@ OutlinePassSystem::OutlinePassSystem(World& world)
     fragment_shader_handle = bgfx::createEmbeddedShader(OUTLINE_BLUR_PASS_SHADER, type, "outline_blur_pass_fragment");
     outline_pass_single_component.outline_blur_pass_program = bgfx::createProgram(vertex_shader_handle, fragment_shader_handle, true);
 
-    outline_pass_single_component.texture_uniform       = bgfx::createUniform("s_texture",       bgfx::UniformType::Sampler);
-    outline_pass_single_component.outline_color_uniform = bgfx::createUniform("u_outline_color", bgfx::UniformType::Vec4);
-    outline_pass_single_component.group_index_uniform   = bgfx::createUniform("u_group_index",   bgfx::UniformType::Vec4);
+    outline_pass_single_component.texture_uniform         = bgfx::createUniform("s_texture",         bgfx::UniformType::Sampler);
+    outline_pass_single_component.outline_color_uniform   = bgfx::createUniform("u_outline_color",   bgfx::UniformType::Vec4);
+    outline_pass_single_component.group_index_uniform     = bgfx::createUniform("u_group_index",     bgfx::UniformType::Vec4);
+    outline_pass_single_component.position_offset_uniform = bgfx::createUniform("u_position_offset", bgfx::UniformType::Vec4);
+    outline_pass_single_component.position_scale_uniform  = bgfx::createUniform("u_position_scale",  bgfx::UniformType::Vec4);
 
     bgfx::setViewClear(OUTLINE_PASS, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH, 0x00000000, 1.f, 0);
     bgfx::setViewName(OUTLINE_PASS, "outline_pass");
@@ -87,6 +90,8 @@ OutlinePassSystem::~OutlinePassSystem() {
     destroy_valid(outline_pass_single_component.outline_blur_pass_program);
     destroy_valid(outline_pass_single_component.outline_color_uniform);
     destroy_valid(outline_pass_single_component.outline_pass_program);
+    destroy_valid(outline_pass_single_component.position_offset_uniform);
+    destroy_valid(outline_pass_single_component.position_scale_uniform);
     destroy_valid(outline_pass_single_component.texture_uniform);
 }
 
@@ -109,8 +114,11 @@ void OutlinePassSystem::update(float /*elapsed_time*/) {
         transform = transform * glm::mat4_cast(transform_component.rotation);
         transform = glm::scale(transform, transform_component.scale);
 
+        // Outline must match the silhouette drawn by geometry pass, so the level of detail is selected the same way.
+        const size_t lod = LodUtils::get_lod(camera_single_component, model_component.model.bounds, transform);
+
         for (const Model::Node& node : model_component.model.children) {
-            draw_node(outline_pass_single_component, node, transform, outline_component.group_index);
+            draw_node(outline_pass_single_component, node, transform, outline_component.group_index, lod);
         }
     });
 
@@ -147,7 +155,7 @@ void OutlinePassSystem::reset(OutlinePassSingleComponent& outline_pass_single_co
     bgfx::setViewRect(OUTLINE_BLUR_PASS, 0, 0, width, height);
 }
 
-void OutlinePassSystem::draw_node(const OutlinePassSingleComponent& outline_pass_single_component, const Model::Node& node, const glm::mat4& transform, uint32_t group_index) const {
+void OutlinePassSystem::draw_node(const OutlinePassSingleComponent& outline_pass_single_component, const Model::Node& node, const glm::mat4& transform, uint32_t group_index, size_t lod) const {
     glm::mat4 local_transform = glm::translate(glm::mat4(1.f), node.translation);
     local_transform = local_transform * glm::mat4_cast(node.rotation);
     local_transform = glm::scale(local_transform, node.scale);
@@ -160,7 +168,7 @@ void OutlinePassSystem::draw_node(const OutlinePassSingleComponent& outline_pass
             assert(bgfx::isValid(primitive.index_buffer));
 
             bgfx::setVertexBuffer(0, primitive.vertex_buffer, 0, static_cast<uint32_t>(primitive.num_vertices));
-            bgfx::setIndexBuffer(primitive.index_buffer, 0, static_cast<uint32_t>(primitive.num_indices));
+            LodUtils::set_index_buffer(primitive, lod);
 
             glm::vec4 uniform_value;
             uniform_value.x = ((group_index >> 16) & 0xFF) / 255.f;
@@ -169,6 +177,9 @@ void OutlinePassSystem::draw_node(const OutlinePassSingleComponent& outline_pass
             uniform_value.w = 1.f;
             bgfx::setUniform(outline_pass_single_component.group_index_uniform, glm::value_ptr(uniform_value));
 
+            bgfx::setUniform(outline_pass_single_component.position_offset_uniform, glm::value_ptr(primitive.position_offset));
+            bgfx::setUniform(outline_pass_single_component.position_scale_uniform, glm::value_ptr(primitive.position_scale));
+
             bgfx::setTransform(glm::value_ptr(world_transform), 1);
 
             bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_CULL_CW);
@@ -180,7 +191,7 @@ void OutlinePassSystem::draw_node(const OutlinePassSingleComponent& outline_pass
     }
 
     for (const Model::Node& child_node : node.children) {
-        draw_node(outline_pass_single_component, child_node, world_transform, group_index);
+        draw_node(outline_pass_single_component, child_node, world_transform, group_index, lod);
     }
 }
 
@@ -0,0 +1,104 @@
+#include "core/ecs/world.h"
+#include "world/render/aabb_tree_single_component.h"
+#include "world/render/camera_single_component.h"
+#include "world/render/model_component.h"
+#include "world/render/picking_utils.h"
+#include "world/shared/transform_component.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <limits>
+
+namespace hg {
+
+namespace picking_utils_details {
+
+static glm::mat4 get_transform(const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale) {
+    glm::mat4 result = glm::translate(glm::mat4(1.f), translation);
+    result = result * glm::mat4_cast(rotation);
+    return glm::scale(result, scale);
+}
+
+static bool raycast_node(const Ray& ray, const Model::Node& node, const glm::mat4& transform, float& distance) {
+    const glm::mat4 world_transform = transform * get_transform(node.translation, node.rotation, node.scale);
+
+    bool result = false;
+
+    if (node.mesh) {
+        // Both origin and direction are transformed, so local space distances match world space distances.
+        const glm::mat4 inverse_world_transform = glm::inverse(world_transform);
+        const Ray local_ray{
+            glm::vec3(inverse_world_transform * glm::vec4(ray.origin, 1.f)),
+            glm::vec3(inverse_world_transform * glm::vec4(ray.direction, 0.f))
+        };
+
+        for (const Model::Primitive& primitive : node.mesh->primitives) {
+            assert(primitive.indices.size() % 3 == 0);
+
+            for (size_t i = 0; i + 2 < primitive.indices.size(); i += 3) {
+                const Model::BasicModelVertex& a = primitive.vertices[primitive.indices[i + 0]];
+                const Model::BasicModelVertex& b = primitive.vertices[primitive.indices[i + 1]];
+                const Model::BasicModelVertex& c = primitive.vertices[primitive.indices[i + 2]];
+
+                float triangle_distance;
+                if (intersect_ray_triangle(local_ray, glm::vec3(a.x, a.y, a.z), glm::vec3(b.x, b.y, b.z), glm::vec3(c.x, c.y, c.z), distance, triangle_distance)) {
+                    distance = triangle_distance;
+                    result = true;
+                }
+            }
+        }
+    }
+
+    for (const Model::Node& child_node : node.children) {
+        result |= raycast_node(ray, child_node, world_transform, distance);
+    }
+
+    return result;
+}
+
+} // namespace picking_utils_details
+
+Ray PickingUtils::screen_to_ray(const CameraSingleComponent& camera_single_component, int32_t x, int32_t y, uint32_t width, uint32_t height) {
+    assert(width != 0);
+    assert(height != 0);
+
+    const float normalized_x = static_cast<float>(x) / width * 2.f - 1.f;
+    const float normalized_y = 1.f - static_cast<float>(y) / height * 2.f;
+
+    glm::vec4 view_space_position = camera_single_component.inverse_projection_matrix * glm::vec4(normalized_x, normalized_y, 1.f, 1.f);
+    view_space_position /= view_space_position.w;
+
+    return Ray{ camera_single_component.translation, camera_single_component.rotation * glm::vec3(view_space_position) };
+}
+
+entt::entity PickingUtils::raycast(World& world, const Ray& ray, float* distance) {
+    using namespace picking_utils_details;
+
+    const DynamicAABBTree& tree = world.ctx<AABBTreeSingleComponent>().get_tree();
+
+    entt::entity result = entt::null;
+    float result_distance = std::numeric_limits<float>::max();
+
+    tree.raycast(ray, result_distance, [&](uint32_t value, float /*box_distance*/) {
+        const auto entity = static_cast<entt::entity>(value);
+
+        auto& model_component = world.get<ModelComponent>(entity);
+        auto& transform_component = world.get<TransformComponent>(entity);
+
+        const glm::mat4 transform = get_transform(transform_component.translation, transform_component.rotation, transform_component.scale);
+        for (const Model::Node& node : model_component.model.children) {
+            if (raycast_node(ray, node, transform, result_distance)) {
+                result = entity;
+            }
+        }
+
+        return result_distance;
+    });
+
+    if (distance != nullptr) {
+        *distance = result_distance;
+    }
+
+    return result;
+}
+
+} // namespace hg
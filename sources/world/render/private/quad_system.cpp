@@ -59,6 +59,8 @@ QuadSystem::QuadSystem(World& world)
     bgfx::ShaderHandle vertex_shader_handle   = bgfx::createEmbeddedShader(QUAD_PASS_SHADER, type, "quad_pass_vertex");
     bgfx::ShaderHandle fragment_shader_handle = bgfx::createEmbeddedShader(QUAD_PASS_SHADER, type, "quad_pass_fragment");
     quad_single_component.program = bgfx::createProgram(vertex_shader_handle, fragment_shader_handle, true);
+
+    quad_single_component.uv_scale_uniform = bgfx::createUniform("u_uv_scale", bgfx::UniformType::Vec4);
 }
 
 QuadSystem::~QuadSystem() {
@@ -72,6 +74,7 @@ QuadSystem::~QuadSystem() {
 
     destroy_valid(quad_single_component.index_buffer);
     destroy_valid(quad_single_component.program);
+    destroy_valid(quad_single_component.uv_scale_uniform);
     destroy_valid(quad_single_component.vertex_buffer);
 }
 
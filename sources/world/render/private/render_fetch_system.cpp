@@ -3,6 +3,7 @@
 #include "world/render/render_fetch_system.h"
 #include "world/render/render_single_component.h"
 #include "world/render/render_tags.h"
+#include "world/shared/frame_pacing_single_component.h"
 #include "world/shared/normal_input_single_component.h"
 #include "world/shared/window_single_component.h"
 
@@ -42,6 +43,12 @@ RenderFetchSystem::RenderFetchSystem(World& world)
 #endif
     bgfx::setPlatformData(platform_data);
 
+    // Calling `renderFrame` before `init` tells bgfx not to create a render thread, in which case the backend work is
+    // performed by `bgfx::frame` on the main thread.
+    if (!world.ctx_or_set<RenderSingleComponent>().is_render_thread_enabled) {
+        bgfx::renderFrame();
+    }
+
     bgfx::Init init;
     //init.type = bgfx::RendererType::OpenGL;
 
@@ -49,7 +56,8 @@ RenderFetchSystem::RenderFetchSystem(World& world)
         throw std::runtime_error("Failed to initialize a renderer!");
     }
 
-    bgfx::reset(window_single_component.width, window_single_component.height, BGFX_RESET_VSYNC);
+    m_is_vsync_enabled = world.ctx_or_set<FramePacingSingleComponent>().is_vsync_enabled;
+    bgfx::reset(window_single_component.width, window_single_component.height, m_is_vsync_enabled ? BGFX_RESET_VSYNC : BGFX_RESET_NONE);
 }
 
 RenderFetchSystem::~RenderFetchSystem() {
@@ -57,16 +65,19 @@ RenderFetchSystem::~RenderFetchSystem() {
 }
 
 void RenderFetchSystem::update(float /*elapsed_time*/) {
+    auto& frame_pacing_single_component = world.ctx<FramePacingSingleComponent>();
     auto& window_single_component = world.ctx<WindowSingleComponent>();
-    if (window_single_component.resized) {
-        bgfx::reset(window_single_component.width, window_single_component.height, BGFX_RESET_VSYNC);
+    if (window_single_component.resized || frame_pacing_single_component.is_vsync_enabled != m_is_vsync_enabled) {
+        m_is_vsync_enabled = frame_pacing_single_component.is_vsync_enabled;
+        bgfx::reset(window_single_component.width, window_single_component.height, m_is_vsync_enabled ? BGFX_RESET_VSYNC : BGFX_RESET_NONE);
     }
 
     auto& normal_input_single_component = world.ctx<NormalInputSingleComponent>();
     if (normal_input_single_component.is_pressed(Control::KEY_F10)) {
         auto& render_single_component = world.ctx<RenderSingleComponent>();
         render_single_component.show_debug_info = !render_single_component.show_debug_info;
-        bgfx::setDebug(render_single_component.show_debug_info ? BGFX_DEBUG_STATS : 0);
+        // Profiler fills per view timings used by `RenderStatisticsSystem`.
+        bgfx::setDebug(render_single_component.show_debug_info ? BGFX_DEBUG_TEXT | BGFX_DEBUG_PROFILER : 0);
     }
 }
 
@@ -0,0 +1,263 @@
+#include "core/ecs/system_descriptor.h"
+#include "core/ecs/world.h"
+#include "core/render/render_pass.h"
+#include "world/imgui/imgui_tags.h"
+#include "world/render/dynamic_resolution_single_component.h"
+#include "world/render/render_single_component.h"
+#include "world/render/render_statistics_single_component.h"
+#include "world/render/render_statistics_system.h"
+#include "world/render/texture_streaming_single_component.h"
+#include "world/shared/resource_loading_single_component.h"
+
+#include <algorithm>
+#include <bgfx/bgfx.h>
+#include <cfloat>
+#include <cstdio>
+#include <fstream>
+#include <imgui.h>
+#include <iterator>
+#include <string>
+
+namespace hg {
+
+namespace render_statistics_system_details {
+
+/** Render pass names by view identifier, must match `RenderPass` enumeration. */
+static const char* const RENDER_PASS_NAMES[] = {
+        "GEOMETRY_PASS",
+        "LIGHTING_PASS",
+        "SKYBOX_PASS",
+        "AA_PASS",
+        "HDR_PASS",
+        "OUTLINE_PASS",
+        "OUTLINE_BLUR_PASS",
+        "DEBUG_DRAW_OFFSCREEN_PASS",
+        "DEBUG_DRAW_ONSCREEN_PASS",
+        "IMGUI_PASS",
+        "PICKING_BLIT_PASS",
+};
+
+static_assert(std::size(RENDER_PASS_NAMES) == PICKING_BLIT_PASS + 1, "Render pass name table is out of date.");
+
+static const float MEGABYTE = 1024.f * 1024.f;
+
+static const float GRAPH_HEIGHT = 40.f;
+
+static std::string get_pass_name(bgfx::ViewId view) {
+    if (view < std::size(RENDER_PASS_NAMES)) {
+        return RENDER_PASS_NAMES[view];
+    }
+    return "VIEW_" + std::to_string(view);
+}
+
+static float to_milliseconds(int64_t time, int64_t frequency) {
+    return frequency > 0 ? static_cast<float>(static_cast<double>(time) * 1000.0 / static_cast<double>(frequency)) : 0.f;
+}
+
+/** Return the most recent value of the specified history. */
+static float get_last(const RenderStatisticsSingleComponent::History& history, size_t history_offset) {
+    return history[(history_offset + RenderStatisticsSingleComponent::HISTORY_SIZE - 1) % RenderStatisticsSingleComponent::HISTORY_SIZE];
+}
+
+static float get_max(const RenderStatisticsSingleComponent::History& history) {
+    float result = 0.f;
+    for (float value : history) {
+        result = std::max(result, value);
+    }
+    return result;
+}
+
+} // namespace render_statistics_system_details
+
+SYSTEM_DESCRIPTOR(
+    SYSTEM(RenderStatisticsSystem),
+    TAGS(imgui),
+    BEFORE("ImguiPassSystem", "RenderSystem"),
+    AFTER("RenderFetchSystem", "ImguiFetchSystem")
+)
+
+RenderStatisticsSystem::RenderStatisticsSystem(World& world)
+        : NormalSystem(world) {
+    world.set<RenderStatisticsSingleComponent>();
+}
+
+RenderStatisticsSystem::~RenderStatisticsSystem() {
+    world.unset<RenderStatisticsSingleComponent>();
+}
+
+void RenderStatisticsSystem::update(float /*elapsed_time*/) {
+    auto& render_single_component = world.ctx<RenderSingleComponent>();
+    if (render_single_component.show_debug_info) {
+        collect_statistics();
+        show_statistics();
+    }
+}
+
+void RenderStatisticsSystem::collect_statistics() {
+    using namespace render_statistics_system_details;
+
+    auto& render_statistics_single_component = world.ctx<RenderStatisticsSingleComponent>();
+    const size_t offset = render_statistics_single_component.history_offset;
+
+    // These are the statistics of the last frame processed by the render thread.
+    const bgfx::Stats* const stats = bgfx::getStats();
+
+    uint32_t num_primitives = 0;
+    for (uint32_t primitives : stats->numPrims) {
+        num_primitives += primitives;
+    }
+
+    render_statistics_single_component.frame_cpu_time[offset]       = to_milliseconds(stats->cpuTimeEnd - stats->cpuTimeBegin, stats->cpuTimerFreq);
+    render_statistics_single_component.frame_gpu_time[offset]       = to_milliseconds(stats->gpuTimeEnd - stats->gpuTimeBegin, stats->gpuTimerFreq);
+    render_statistics_single_component.num_draw_calls[offset]       = static_cast<float>(stats->numDraw);
+    render_statistics_single_component.num_primitives[offset]       = static_cast<float>(num_primitives);
+    render_statistics_single_component.texture_memory[offset]       = static_cast<float>(stats->textureMemoryUsed) / MEGABYTE;
+    render_statistics_single_component.render_target_memory[offset] = static_cast<float>(stats->rtMemoryUsed) / MEGABYTE;
+
+    // Passes that were not submitted this frame take no time.
+    for (auto& [view, pass_statistics] : render_statistics_single_component.passes) {
+        pass_statistics.cpu_time[offset] = 0.f;
+        pass_statistics.gpu_time[offset] = 0.f;
+    }
+
+    for (uint16_t i = 0; i < stats->numViews; i++) {
+        const bgfx::ViewStats& view_stats = stats->viewStats[i];
+
+        RenderStatisticsSingleComponent::PassStatistics& pass_statistics = render_statistics_single_component.passes[view_stats.view];
+        pass_statistics.cpu_time[offset] += to_milliseconds(view_stats.cpuTimeElapsed, stats->cpuTimerFreq);
+        pass_statistics.gpu_time[offset] += to_milliseconds(view_stats.gpuTimeElapsed, stats->gpuTimerFreq);
+    }
+
+    render_statistics_single_component.history_offset = (offset + 1) % RenderStatisticsSingleComponent::HISTORY_SIZE;
+    render_statistics_single_component.num_frames = std::min(render_statistics_single_component.num_frames + 1, RenderStatisticsSingleComponent::HISTORY_SIZE);
+}
+
+void RenderStatisticsSystem::show_statistics() {
+    using namespace render_statistics_system_details;
+
+    auto& render_statistics_single_component = world.ctx<RenderStatisticsSingleComponent>();
+    const size_t offset = render_statistics_single_component.history_offset;
+
+    auto plot = [&](const char* label, const RenderStatisticsSingleComponent::History& history, float scale_max) {
+        char overlay[32];
+        std::snprintf(overlay, sizeof(overlay), "%.3f", get_last(history, offset));
+        ImGui::PushID(label);
+        ImGui::PlotLines("", history.data(), static_cast<int>(history.size()), static_cast<int>(offset), overlay,
+                         0.f, scale_max, ImVec2(0.f, GRAPH_HEIGHT));
+        ImGui::PopID();
+    };
+
+    if (ImGui::Begin("Render Statistics", nullptr, ImGuiWindowFlags_NoFocusOnAppearing)) {
+        ImGui::Text("Frame CPU %.3f ms, GPU %.3f ms", get_last(render_statistics_single_component.frame_cpu_time, offset),
+                    get_last(render_statistics_single_component.frame_gpu_time, offset));
+        ImGui::Text("Draw calls %.0f, primitives %.0f", get_last(render_statistics_single_component.num_draw_calls, offset),
+                    get_last(render_statistics_single_component.num_primitives, offset));
+        ImGui::Text("Texture memory %.1f MB, render target memory %.1f MB", get_last(render_statistics_single_component.texture_memory, offset),
+                    get_last(render_statistics_single_component.render_target_memory, offset));
+        if (auto* dynamic_resolution_single_component = world.try_ctx<DynamicResolutionSingleComponent>(); dynamic_resolution_single_component != nullptr) {
+            ImGui::Text("Scene resolution %ux%u (%.0f%%)", dynamic_resolution_single_component->width, dynamic_resolution_single_component->height,
+                        dynamic_resolution_single_component->scale * 100.f);
+        }
+        if (auto* texture_streaming_single_component = world.try_ctx<TextureStreamingSingleComponent>(); texture_streaming_single_component != nullptr &&
+            texture_streaming_single_component->get_num_textures() > 0) {
+            ImGui::Text("Streamed textures %zu, %.1f MB of %u MB, %zu loads", texture_streaming_single_component->get_num_textures(),
+                        static_cast<float>(texture_streaming_single_component->get_memory()) / MEGABYTE, texture_streaming_single_component->budget,
+                        texture_streaming_single_component->get_num_pending_loads());
+        }
+        if (auto* resource_loading_single_component = world.try_ctx<ResourceLoadingSingleComponent>(); resource_loading_single_component != nullptr &&
+            resource_loading_single_component->get_num_pending_loads() > 0) {
+            ImGui::Text("Loading %zu resources", resource_loading_single_component->get_num_pending_loads());
+        }
+
+        if (ImGui::CollapsingHeader("Frame", ImGuiTreeNodeFlags_DefaultOpen)) {
+            const float max_time = std::max(get_max(render_statistics_single_component.frame_cpu_time), get_max(render_statistics_single_component.frame_gpu_time));
+            ImGui::TextUnformatted("CPU, ms");
+            plot("frame_cpu_time", render_statistics_single_component.frame_cpu_time, max_time);
+            ImGui::TextUnformatted("GPU, ms");
+            plot("frame_gpu_time", render_statistics_single_component.frame_gpu_time, max_time);
+            ImGui::TextUnformatted("Draw calls");
+            plot("num_draw_calls", render_statistics_single_component.num_draw_calls, FLT_MAX);
+            ImGui::TextUnformatted("Primitives");
+            plot("num_primitives", render_statistics_single_component.num_primitives, FLT_MAX);
+        }
+
+        if (ImGui::CollapsingHeader("Passes", ImGuiTreeNodeFlags_DefaultOpen)) {
+            // Same scale for all passes, so it's easy to see which one is the most expensive.
+            float max_time = 0.f;
+            for (auto& [view, pass_statistics] : render_statistics_single_component.passes) {
+                max_time = std::max(max_time, std::max(get_max(pass_statistics.cpu_time), get_max(pass_statistics.gpu_time)));
+            }
+
+            ImGui::Columns(3, "passes");
+            ImGui::TextUnformatted("Pass");
+            ImGui::NextColumn();
+            ImGui::TextUnformatted("CPU, ms");
+            ImGui::NextColumn();
+            ImGui::TextUnformatted("GPU, ms");
+            ImGui::NextColumn();
+            ImGui::Separator();
+
+            for (auto& [view, pass_statistics] : render_statistics_single_component.passes) {
+                const std::string name = get_pass_name(view);
+                ImGui::TextUnformatted(name.c_str());
+                ImGui::NextColumn();
+                plot((name + "_cpu_time").c_str(), pass_statistics.cpu_time, max_time);
+                ImGui::NextColumn();
+                plot((name + "_gpu_time").c_str(), pass_statistics.gpu_time, max_time);
+                ImGui::NextColumn();
+            }
+
+            ImGui::Columns(1);
+        }
+
+        ImGui::Separator();
+        if (ImGui::Button("Export CSV")) {
+            export_statistics();
+        }
+        if (!render_statistics_single_component.export_status.empty()) {
+            ImGui::SameLine();
+            ImGui::TextUnformatted(render_statistics_single_component.export_status.c_str());
+        }
+    }
+    ImGui::End();
+}
+
+void RenderStatisticsSystem::export_statistics() {
+    using namespace render_statistics_system_details;
+
+    auto& render_statistics_single_component = world.ctx<RenderStatisticsSingleComponent>();
+
+    std::ofstream stream(render_statistics_single_component.export_path);
+    if (!stream) {
+        render_statistics_single_component.export_status = "Failed to open \"" + render_statistics_single_component.export_path + "\".";
+        return;
+    }
+
+    stream << "frame,frame_cpu_ms,frame_gpu_ms,draw_calls,primitives,texture_memory_mb,render_target_memory_mb";
+    for (auto& [view, pass_statistics] : render_statistics_single_component.passes) {
+        const std::string name = get_pass_name(view);
+        stream << ',' << name << "_cpu_ms," << name << "_gpu_ms";
+    }
+    stream << '\n';
+
+    const size_t num_frames = render_statistics_single_component.num_frames;
+    for (size_t i = 0; i < num_frames; i++) {
+        const size_t index = (render_statistics_single_component.history_offset + RenderStatisticsSingleComponent::HISTORY_SIZE - num_frames + i) % RenderStatisticsSingleComponent::HISTORY_SIZE;
+
+        stream << i << ','
+               << render_statistics_single_component.frame_cpu_time[index] << ','
+               << render_statistics_single_component.frame_gpu_time[index] << ','
+               << render_statistics_single_component.num_draw_calls[index] << ','
+               << render_statistics_single_component.num_primitives[index] << ','
+               << render_statistics_single_component.texture_memory[index] << ','
+               << render_statistics_single_component.render_target_memory[index];
+        for (auto& [view, pass_statistics] : render_statistics_single_component.passes) {
+            stream << ',' << pass_statistics.cpu_time[index] << ',' << pass_statistics.gpu_time[index];
+        }
+        stream << '\n';
+    }
+
+    render_statistics_single_component.export_status = "Exported " + std::to_string(num_frames) + " frames to \"" + render_statistics_single_component.export_path + "\".";
+}
+
+} // namespace hg
@@ -16,7 +16,8 @@ SYSTEM_DESCRIPTOR(
 
 RenderSystem::RenderSystem(World& world)
         : NormalSystem(world) {
-    world.set<RenderSingleComponent>();
+    // Render thread option may be specified before systems are created.
+    world.ctx_or_set<RenderSingleComponent>();
 }
 
 void RenderSystem::update(float /*elapsed_time*/) {
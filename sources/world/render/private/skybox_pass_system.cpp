@@ -1,9 +1,11 @@
 #include "core/ecs/system_descriptor.h"
 #include "core/ecs/world.h"
 #include "core/render/render_pass.h"
+#include "core/resource/resource_id.h"
 #include "shaders/skybox_pass/skybox_pass.fragment.h"
 #include "shaders/skybox_pass/skybox_pass.vertex.h"
 #include "world/render/camera_single_component.h"
+#include "world/render/dynamic_resolution_single_component.h"
 #include "world/render/geometry_pass_single_component.h"
 #include "world/render/light_component.h"
 #include "world/render/quad_single_component.h"
@@ -12,7 +14,6 @@
 #include "world/render/skybox_pass_system.h"
 #include "world/render/texture_single_component.h"
 #include "world/shared/transform_component.h"
-#include "world/shared/window_single_component.h"
 
 #include <bgfx/bgfx.h>
 #include <bgfx/embedded_shader.h>
@@ -32,6 +33,9 @@ static const bgfx::EmbeddedShader SKYBOX_PASS_SHADER[] = {
 
 static const uint64_t ATTACHMENT_FLAGS = BGFX_TEXTURE_RT | BGFX_SAMPLER_MIN_ANISOTROPIC | BGFX_SAMPLER_MAG_ANISOTROPIC | BGFX_SAMPLER_MIP_POINT | BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP;
 
+// TODO: Get actual skybox from level file or something.
+static const ResourceId SKYBOX_TEXTURE("house.dds");
+
 } // namespace skybox_pass_system_details
 
 SYSTEM_DESCRIPTOR(
@@ -45,8 +49,8 @@ SkyboxPassSystem::SkyboxPassSystem(World& world)
         : NormalSystem(world) {
     using namespace skybox_pass_system_details;
 
+    auto& dynamic_resolution_single_component = world.ctx<DynamicResolutionSingleComponent>();
     auto& skybox_pass_single_component = world.set<SkyboxPassSingleComponent>();
-    auto& window_single_component = world.ctx<WindowSingleComponent>();
 
     bgfx::RendererType::Enum type = bgfx::getRendererType();
     bgfx::ShaderHandle vertex_shader_handle   = bgfx::createEmbeddedShader(SKYBOX_PASS_SHADER, type, "skybox_pass_vertex");
@@ -57,8 +61,9 @@ SkyboxPassSystem::SkyboxPassSystem(World& world)
     skybox_pass_single_component.depth_uniform           = bgfx::createUniform("s_depth", bgfx::UniformType::Sampler);
     skybox_pass_single_component.skybox_texture_uniform  = bgfx::createUniform("s_skybox", bgfx::UniformType::Sampler);
     skybox_pass_single_component.rotation_uniform        = bgfx::createUniform("u_rotation", bgfx::UniformType::Mat4);
+    skybox_pass_single_component.uv_scale_uniform        = bgfx::createUniform("u_uv_scale", bgfx::UniformType::Vec4);
 
-    reset(skybox_pass_single_component, window_single_component.width, window_single_component.height);
+    reset(skybox_pass_single_component, dynamic_resolution_single_component.texture_width, dynamic_resolution_single_component.texture_height);
 
     bgfx::setViewClear(SKYBOX_PASS, BGFX_CLEAR_COLOR, 0x000000FF, 1.f, 0);
     bgfx::setViewName(SKYBOX_PASS, "skybox_pass");
@@ -80,22 +85,27 @@ SkyboxPassSystem::~SkyboxPassSystem() {
     destroy_valid(skybox_pass_single_component.skybox_pass_program);
     destroy_valid(skybox_pass_single_component.skybox_texture_uniform);
     destroy_valid(skybox_pass_single_component.texture_uniform);
+    destroy_valid(skybox_pass_single_component.uv_scale_uniform);
 }
 
 void SkyboxPassSystem::update(float /*elapsed_time*/) {
+    using namespace skybox_pass_system_details;
+
     auto& camera_single_component = world.ctx<CameraSingleComponent>();
+    auto& dynamic_resolution_single_component = world.ctx<DynamicResolutionSingleComponent>();
     auto& geometry_pass_single_component = world.ctx<GeometryPassSingleComponent>();
     auto& lighting_pass_single_component = world.ctx<LightingPassSingleComponent>();
     auto& quad_single_component = world.ctx<QuadSingleComponent>();
     auto& skybox_pass_single_component = world.ctx<SkyboxPassSingleComponent>();
     auto& texture_single_component = world.ctx<TextureSingleComponent>();
-    auto& window_single_component = world.ctx<WindowSingleComponent>();
 
-    if (window_single_component.resized) {
-        reset(skybox_pass_single_component, window_single_component.width, window_single_component.height);
+    if (dynamic_resolution_single_component.is_texture_resized) {
+        reset(skybox_pass_single_component, dynamic_resolution_single_component.texture_width, dynamic_resolution_single_component.texture_height);
     }
 
-    const Texture& skybox_texture = texture_single_component.get("house.dds");
+    bgfx::setViewRect(SKYBOX_PASS, 0, 0, dynamic_resolution_single_component.width, dynamic_resolution_single_component.height);
+
+    const Texture& skybox_texture = texture_single_component.get(SKYBOX_TEXTURE);
     if (!skybox_texture.is_cube_map) {
         // Skybox texture is missing.
         return;
@@ -111,6 +121,7 @@ void SkyboxPassSystem::update(float /*elapsed_time*/) {
 
     const glm::mat4 rotation = glm::mat4_cast(camera_single_component.rotation);
     bgfx::setUniform(skybox_pass_single_component.rotation_uniform, &rotation);
+    bgfx::setUniform(skybox_pass_single_component.uv_scale_uniform, &dynamic_resolution_single_component.uv_scale);
 
     bgfx::setStencil(BGFX_STENCIL_TEST_NOTEQUAL | BGFX_STENCIL_FUNC_REF(1) | BGFX_STENCIL_FUNC_RMASK(1) |
                      BGFX_STENCIL_OP_FAIL_S_KEEP | BGFX_STENCIL_OP_FAIL_Z_KEEP | BGFX_STENCIL_OP_PASS_Z_KEEP,
@@ -123,6 +134,7 @@ void SkyboxPassSystem::update(float /*elapsed_time*/) {
     bgfx::setIndexBuffer(quad_single_component.index_buffer, 0, QuadSingleComponent::NUM_INDICES);
 
     bgfx::setTexture(0, skybox_pass_single_component.texture_uniform, lighting_pass_single_component.color_texture);
+    bgfx::setUniform(quad_single_component.uv_scale_uniform, &dynamic_resolution_single_component.uv_scale);
 
     bgfx::setStencil(BGFX_STENCIL_NONE, BGFX_STENCIL_NONE);
     bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_CULL_CW | BGFX_STATE_BLEND_ALPHA);
@@ -151,7 +163,6 @@ void SkyboxPassSystem::reset(SkyboxPassSingleComponent &skybox_pass_single_compo
     skybox_pass_single_component.buffer = bgfx::createFrameBuffer(static_cast<uint8_t>(std::size(attachments)), attachments, false);
 
     bgfx::setViewFrameBuffer(SKYBOX_PASS, skybox_pass_single_component.buffer);
-    bgfx::setViewRect(SKYBOX_PASS, 0, 0, width, height);
 }
 
 } // namespace hg
@@ -0,0 +1,37 @@
+#include "world/render/static_geometry_single_component.h"
+
+#include <tuple>
+
+namespace hg {
+
+StaticGeometrySingleComponent::StaticGeometrySingleComponent() = default;
+StaticGeometrySingleComponent::StaticGeometrySingleComponent(StaticGeometrySingleComponent&& another) = default;
+StaticGeometrySingleComponent& StaticGeometrySingleComponent::operator=(StaticGeometrySingleComponent&& another) = default;
+StaticGeometrySingleComponent::~StaticGeometrySingleComponent() = default;
+
+bool StaticGeometrySingleComponent::is_merged(entt::entity entity) const {
+    return is_enabled && m_entity_chunks.count(entity) != 0;
+}
+
+void StaticGeometrySingleComponent::query_frustum(const glm::mat4& view_projection, std::vector<const Chunk*>& result) const {
+    std::vector<uint32_t> chunk_identifiers;
+    m_tree.query_frustum(view_projection, chunk_identifiers);
+
+    for (const uint32_t chunk_identifier : chunk_identifiers) {
+        result.push_back(&m_chunks.at(chunk_identifier).chunk);
+    }
+}
+
+size_t StaticGeometrySingleComponent::get_num_chunks() const {
+    return m_chunks.size();
+}
+
+size_t StaticGeometrySingleComponent::get_num_merged_entities() const {
+    return m_entity_chunks.size();
+}
+
+bool StaticGeometrySingleComponent::ChunkKey::operator<(const ChunkKey& another) const {
+    return std::tie(color_roughness, normal_metal_ao, layer, x, y, z) < std::tie(another.color_roughness, another.normal_metal_ao, another.layer, another.x, another.y, another.z);
+}
+
+} // namespace hg
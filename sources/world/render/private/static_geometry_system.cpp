@@ -0,0 +1,366 @@
+#include "core/ecs/system_descriptor.h"
+#include "core/ecs/world.h"
+#include "core/resource/vertex_quantization.h"
+#include "world/editor/editor_tags.h"
+#include "world/physics/physics_static_rigid_body_component.h"
+#include "world/render/blockout_component.h"
+#include "world/render/material_component.h"
+#include "world/render/model_component.h"
+#include "world/render/render_single_component.h"
+#include "world/render/render_tags.h"
+#include "world/render/static_geometry_single_component.h"
+#include "world/render/static_geometry_system.h"
+#include "world/shared/normal_input_single_component.h"
+#include "world/shared/transform_component.h"
+
+#include <algorithm>
+#include <bgfx/bgfx.h>
+#include <cassert>
+#include <glm/common.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <limits>
+#include <utility>
+
+namespace hg {
+
+namespace static_geometry_system_details {
+
+/** Blockout normals are axis aligned, this is used to choose the texture projection plane. */
+static const float AXIS_THRESHOLD = 0.99f;
+
+static glm::mat4 get_transform(const TransformComponent& transform_component) {
+    glm::mat4 transform = glm::translate(glm::mat4(1.f), transform_component.translation);
+    transform = transform * glm::mat4_cast(transform_component.rotation);
+    return glm::scale(transform, transform_component.scale);
+}
+
+/** Must match `geometry_blockout_pass.vertex.sc`. */
+static glm::vec2 get_blockout_texcoord(const Model::BasicModelVertex& vertex, const glm::vec3& scale) {
+    if (vertex.normal_x > AXIS_THRESHOLD) {
+        return glm::vec2(vertex.u * scale.z, (vertex.v - 1.f) * scale.y);
+    } else if (vertex.normal_x < -AXIS_THRESHOLD) {
+        return glm::vec2((vertex.u - 1.f) * scale.z, (vertex.v - 1.f) * scale.y);
+    } else if (vertex.normal_y > AXIS_THRESHOLD) {
+        return glm::vec2((vertex.u - 1.f) * scale.x, (vertex.v - 1.f) * scale.z);
+    } else if (vertex.normal_y < -AXIS_THRESHOLD) {
+        return glm::vec2(vertex.u * scale.x, (vertex.v - 1.f) * scale.z);
+    } else if (vertex.normal_z > AXIS_THRESHOLD) {
+        return glm::vec2(vertex.u * scale.x, (vertex.v - 1.f) * scale.y);
+    }
+    return glm::vec2((vertex.u - 1.f) * scale.x, (vertex.v - 1.f) * scale.y);
+}
+
+static void bake_node(const Model::Node& node, const glm::mat4& transform,
+                      std::vector<Model::BasicModelVertex>& vertices, std::vector<uint32_t>& indices) {
+    glm::mat4 local_transform = glm::translate(glm::mat4(1.f), node.translation);
+    local_transform = local_transform * glm::mat4_cast(node.rotation);
+    local_transform = glm::scale(local_transform, node.scale);
+
+    const glm::mat4 world_transform = transform * local_transform;
+    const glm::vec3 scale(glm::length(glm::vec3(world_transform[0])),
+                          glm::length(glm::vec3(world_transform[1])),
+                          glm::length(glm::vec3(world_transform[2])));
+
+    if (node.mesh) {
+        for (const Model::Primitive& primitive : node.mesh->primitives) {
+            const auto first_vertex = static_cast<uint32_t>(vertices.size());
+
+            for (const Model::BasicModelVertex& vertex : primitive.vertices) {
+                const glm::vec3 position(world_transform * glm::vec4(vertex.x, vertex.y, vertex.z, 1.f));
+                const glm::vec3 normal = glm::normalize(glm::vec3(world_transform * glm::vec4(vertex.normal_x, vertex.normal_y, vertex.normal_z, 0.f)));
+                const glm::vec3 tangent = glm::normalize(glm::vec3(world_transform * glm::vec4(vertex.tangent_x, vertex.tangent_y, vertex.tangent_z, 0.f)));
+                const glm::vec2 texcoord = get_blockout_texcoord(vertex, scale);
+
+                Model::BasicModelVertex& baked_vertex = vertices.emplace_back();
+                baked_vertex.x = position.x;
+                baked_vertex.y = position.y;
+                baked_vertex.z = position.z;
+                baked_vertex.normal_x = normal.x;
+                baked_vertex.normal_y = normal.y;
+                baked_vertex.normal_z = normal.z;
+                baked_vertex.tangent_x = tangent.x;
+                baked_vertex.tangent_y = tangent.y;
+                baked_vertex.tangent_z = tangent.z;
+                baked_vertex.tangent_w = vertex.tangent_w;
+                baked_vertex.u = texcoord.x;
+                baked_vertex.v = texcoord.y;
+            }
+
+            for (const uint32_t index : primitive.indices) {
+                indices.push_back(first_vertex + index);
+            }
+        }
+    }
+
+    for (const Model::Node& child_node : node.children) {
+        bake_node(child_node, world_transform, vertices, indices);
+    }
+}
+
+} // namespace static_geometry_system_details
+
+SYSTEM_DESCRIPTOR(
+    SYSTEM(StaticGeometrySystem),
+    TAGS(render),
+    BEFORE("GeometryPassSystem", "RenderSystem"),
+    AFTER("ResourceSystem")
+)
+
+StaticGeometrySystem::StaticGeometrySystem(World& world)
+        : NormalSystem(world)
+        , m_static_geometry_observer(entt::observer(world, entt::collector.group<BlockoutComponent, PhysicsStaticRigidBodyComponent, ModelComponent, MaterialComponent, TransformComponent>()
+                                                                         .replace<ModelComponent>().where<BlockoutComponent, PhysicsStaticRigidBodyComponent, MaterialComponent, TransformComponent>()
+                                                                         .replace<MaterialComponent>().where<BlockoutComponent, PhysicsStaticRigidBodyComponent, ModelComponent, TransformComponent>()
+                                                                         .replace<TransformComponent>().where<BlockoutComponent, PhysicsStaticRigidBodyComponent, ModelComponent, MaterialComponent>())) {
+    auto& static_geometry_single_component = world.set<StaticGeometrySingleComponent>();
+
+    // In editor entities must stay separate to be selected and outlined, but merged geometry can still be previewed.
+    static_geometry_single_component.is_enabled = !world.check_tag(tags::editor);
+
+    // Level is loaded by `ResourceSystem` constructor, which is executed before this system is created.
+    world.view<BlockoutComponent, PhysicsStaticRigidBodyComponent, ModelComponent, MaterialComponent, TransformComponent>().each(
+            [&](entt::entity entity, BlockoutComponent&, PhysicsStaticRigidBodyComponent&, ModelComponent&, MaterialComponent&, TransformComponent&) {
+        m_initial_entities.push_back(entity);
+    });
+
+    world.on_destroy<BlockoutComponent>().connect<&StaticGeometrySystem::static_geometry_destroyed>(*this);
+    world.on_destroy<PhysicsStaticRigidBodyComponent>().connect<&StaticGeometrySystem::static_geometry_destroyed>(*this);
+    world.on_destroy<ModelComponent>().connect<&StaticGeometrySystem::static_geometry_destroyed>(*this);
+    world.on_destroy<MaterialComponent>().connect<&StaticGeometrySystem::static_geometry_destroyed>(*this);
+    world.on_destroy<TransformComponent>().connect<&StaticGeometrySystem::static_geometry_destroyed>(*this);
+}
+
+StaticGeometrySystem::~StaticGeometrySystem() {
+    world.on_destroy<BlockoutComponent>().disconnect<&StaticGeometrySystem::static_geometry_destroyed>(*this);
+    world.on_destroy<PhysicsStaticRigidBodyComponent>().disconnect<&StaticGeometrySystem::static_geometry_destroyed>(*this);
+    world.on_destroy<ModelComponent>().disconnect<&StaticGeometrySystem::static_geometry_destroyed>(*this);
+    world.on_destroy<MaterialComponent>().disconnect<&StaticGeometrySystem::static_geometry_destroyed>(*this);
+    world.on_destroy<TransformComponent>().disconnect<&StaticGeometrySystem::static_geometry_destroyed>(*this);
+
+    m_static_geometry_observer.disconnect();
+
+    // Chunks own GPU buffers, which must be destroyed before `RenderFetchSystem` destructor.
+    world.unset<StaticGeometrySingleComponent>();
+}
+
+void StaticGeometrySystem::update(float /*elapsed_time*/) {
+    auto& normal_input_single_component = world.ctx<NormalInputSingleComponent>();
+    auto& render_single_component = world.ctx<RenderSingleComponent>();
+    auto& static_geometry_single_component = world.ctx<StaticGeometrySingleComponent>();
+
+    if (normal_input_single_component.is_pressed(Control::KEY_F8)) {
+        static_geometry_single_component.is_enabled = !static_geometry_single_component.is_enabled;
+    }
+
+    if (render_single_component.show_debug_info) {
+        const uint16_t text_height = bgfx::getStats()->textHeight;
+        bgfx::dbgTextPrintf(0, text_height - 3, 0x0F, "Static geometry merging (F8): %s, chunks: %zu, merged entities: %zu",
+                            static_geometry_single_component.is_enabled ? "on" : "off",
+                            static_geometry_single_component.get_num_chunks(),
+                            static_geometry_single_component.get_num_merged_entities());
+    }
+
+    auto static_geometry_updated = [&](const entt::entity entity) {
+        remove_entity(static_geometry_single_component, entity);
+        add_entity(static_geometry_single_component, entity);
+    };
+
+    for (entt::entity entity : std::exchange(m_initial_entities, {})) {
+        static_geometry_updated(entity);
+    }
+
+    m_static_geometry_observer.each(static_geometry_updated);
+
+    if (static_geometry_single_component.is_enabled != m_are_chunks_built) {
+        if (static_geometry_single_component.is_enabled) {
+            for (auto& [chunk_identifier, chunk_data] : static_geometry_single_component.m_chunks) {
+                chunk_data.is_dirty = true;
+            }
+            m_has_dirty_chunks = true;
+        } else {
+            release_chunks(static_geometry_single_component);
+        }
+        m_are_chunks_built = static_geometry_single_component.is_enabled;
+    }
+
+    if (m_has_dirty_chunks) {
+        // When merging is disabled, only empty chunks are processed to be removed. The rest is built once it's enabled.
+        std::vector<uint32_t> dirty_chunks;
+        for (auto& [chunk_identifier, chunk_data] : static_geometry_single_component.m_chunks) {
+            if (chunk_data.is_dirty && (m_are_chunks_built || chunk_data.entities.empty())) {
+                dirty_chunks.push_back(chunk_identifier);
+            }
+        }
+
+        for (const uint32_t chunk_identifier : dirty_chunks) {
+            build_chunk(static_geometry_single_component, chunk_identifier);
+        }
+
+        m_has_dirty_chunks = false;
+    }
+}
+
+void StaticGeometrySystem::release_chunks(StaticGeometrySingleComponent& static_geometry_single_component) {
+    for (auto& [chunk_identifier, chunk_data] : static_geometry_single_component.m_chunks) {
+        // Buffers are destroyed together with the local primitive.
+        Model::Primitive primitive;
+        std::swap(chunk_data.chunk.primitive, primitive);
+
+        chunk_data.proxy = DynamicAABBTree::NULL_PROXY;
+        chunk_data.is_dirty = true;
+    }
+
+    static_geometry_single_component.m_tree.clear();
+}
+
+void StaticGeometrySystem::static_geometry_destroyed(const entt::entity entity, entt::registry& /*registry*/) {
+    remove_entity(world.ctx<StaticGeometrySingleComponent>(), entity);
+}
+
+void StaticGeometrySystem::add_entity(StaticGeometrySingleComponent& static_geometry_single_component, entt::entity entity) {
+    using namespace static_geometry_system_details;
+
+    if (!world.valid(entity) || !world.has<BlockoutComponent, PhysicsStaticRigidBodyComponent, ModelComponent, MaterialComponent, TransformComponent>(entity)) {
+        return;
+    }
+
+    auto& model_component = world.get<ModelComponent>(entity);
+    auto& material_component = world.get<MaterialComponent>(entity);
+    auto& transform_component = world.get<TransformComponent>(entity);
+
+    // Entities that are not loaded yet are not drawn at all.
+    if (model_component.model.children.empty() || material_component.color_roughness == nullptr || material_component.normal_metal_ao == nullptr) {
+        return;
+    }
+
+    const Model::AABB& bounds = model_component.model.bounds;
+    const glm::vec3 local_center((bounds.min_x + bounds.max_x) * 0.5f, (bounds.min_y + bounds.max_y) * 0.5f, (bounds.min_z + bounds.max_z) * 0.5f);
+    const glm::vec3 cell = glm::floor(glm::vec3(get_transform(transform_component) * glm::vec4(local_center, 1.f)) / StaticGeometrySingleComponent::CELL_SIZE);
+
+    StaticGeometrySingleComponent::ChunkKey chunk_key;
+    chunk_key.color_roughness = material_component.color_roughness;
+    chunk_key.normal_metal_ao = material_component.normal_metal_ao;
+    chunk_key.layer = material_component.layer;
+    chunk_key.x = static_cast<int32_t>(cell.x);
+    chunk_key.y = static_cast<int32_t>(cell.y);
+    chunk_key.z = static_cast<int32_t>(cell.z);
+
+    auto [chunk_identifier, is_inserted] = static_geometry_single_component.m_chunk_identifiers.emplace(chunk_key, static_geometry_single_component.m_next_chunk_identifier);
+    if (is_inserted) {
+        static_geometry_single_component.m_next_chunk_identifier++;
+    }
+
+    StaticGeometrySingleComponent::ChunkData& chunk_data = static_geometry_single_component.m_chunks[chunk_identifier->second];
+    chunk_data.chunk.color_roughness = material_component.color_roughness;
+    chunk_data.chunk.normal_metal_ao = material_component.normal_metal_ao;
+    chunk_data.chunk.layer = material_component.layer;
+    chunk_data.entities.push_back(entity);
+    chunk_data.is_dirty = true;
+
+    static_geometry_single_component.m_entity_chunks.emplace(entity, chunk_identifier->second);
+
+    m_has_dirty_chunks = true;
+}
+
+void StaticGeometrySystem::remove_entity(StaticGeometrySingleComponent& static_geometry_single_component, entt::entity entity) {
+    auto entity_chunk = static_geometry_single_component.m_entity_chunks.find(entity);
+    if (entity_chunk == static_geometry_single_component.m_entity_chunks.end()) {
+        return;
+    }
+
+    StaticGeometrySingleComponent::ChunkData& chunk_data = static_geometry_single_component.m_chunks.at(entity_chunk->second);
+
+    auto chunk_entity = std::find(chunk_data.entities.begin(), chunk_data.entities.end(), entity);
+    assert(chunk_entity != chunk_data.entities.end());
+
+    std::swap(*chunk_entity, chunk_data.entities.back());
+    chunk_data.entities.pop_back();
+    chunk_data.is_dirty = true;
+
+    static_geometry_single_component.m_entity_chunks.erase(entity_chunk);
+
+    m_has_dirty_chunks = true;
+}
+
+void StaticGeometrySystem::build_chunk(StaticGeometrySingleComponent& static_geometry_single_component, uint32_t chunk_identifier) {
+    using namespace static_geometry_system_details;
+
+    StaticGeometrySingleComponent::ChunkData& chunk_data = static_geometry_single_component.m_chunks.at(chunk_identifier);
+
+    if (chunk_data.entities.empty()) {
+        if (chunk_data.proxy != DynamicAABBTree::NULL_PROXY) {
+            static_geometry_single_component.m_tree.remove(chunk_data.proxy);
+        }
+
+        for (auto it = static_geometry_single_component.m_chunk_identifiers.begin(); it != static_geometry_single_component.m_chunk_identifiers.end(); ++it) {
+            if (it->second == chunk_identifier) {
+                static_geometry_single_component.m_chunk_identifiers.erase(it);
+                break;
+            }
+        }
+
+        static_geometry_single_component.m_chunks.erase(chunk_identifier);
+        return;
+    }
+
+    // Entities are sorted to make chunk contents independent of the editing history.
+    std::sort(chunk_data.entities.begin(), chunk_data.entities.end());
+
+    Model::Primitive primitive;
+
+    for (const entt::entity entity : chunk_data.entities) {
+        auto& model_component = world.get<ModelComponent>(entity);
+        auto& transform_component = world.get<TransformComponent>(entity);
+
+        const glm::mat4 transform = get_transform(transform_component);
+        for (const Model::Node& node : model_component.model.children) {
+            bake_node(node, transform, primitive.vertices, primitive.indices);
+        }
+    }
+
+    glm::vec3 min(std::numeric_limits<float>::max());
+    glm::vec3 max(-std::numeric_limits<float>::max());
+    for (const Model::BasicModelVertex& vertex : primitive.vertices) {
+        min = glm::min(min, glm::vec3(vertex.x, vertex.y, vertex.z));
+        max = glm::max(max, glm::vec3(vertex.x, vertex.y, vertex.z));
+    }
+
+    const std::vector<Model::CompactModelVertex> compact_vertices = quantize_vertices(primitive.vertices, primitive.position_offset, primitive.position_scale);
+    const auto vertex_memory_size = static_cast<uint32_t>(compact_vertices.size() * sizeof(Model::CompactModelVertex));
+    primitive.vertex_buffer = bgfx::createVertexBuffer(bgfx::copy(compact_vertices.data(), vertex_memory_size), Model::CompactModelVertex::DECLARATION);
+    primitive.num_vertices = compact_vertices.size();
+
+    if (primitive.num_vertices > std::numeric_limits<uint16_t>::max()) {
+        const auto index_memory_size = static_cast<uint32_t>(primitive.indices.size() * sizeof(uint32_t));
+        primitive.index_buffer = bgfx::createIndexBuffer(bgfx::copy(primitive.indices.data(), index_memory_size), BGFX_BUFFER_INDEX32);
+    } else {
+        const bgfx::Memory* memory = bgfx::alloc(static_cast<uint32_t>(primitive.indices.size() * sizeof(uint16_t)));
+
+        auto* target_data = reinterpret_cast<uint16_t*>(memory->data);
+        for (size_t i = 0; i < primitive.indices.size(); i++) {
+            target_data[i] = uint16_t(primitive.indices[i]);
+        }
+
+        primitive.index_buffer = bgfx::createIndexBuffer(memory);
+    }
+    primitive.num_indices = primitive.indices.size();
+
+    // CPU copies are not needed, picking and simplification work with the original entities.
+    primitive.vertices = {};
+    primitive.indices = {};
+
+    // Old buffers are destroyed together with the local primitive.
+    std::swap(chunk_data.chunk.primitive, primitive);
+
+    chunk_data.chunk.min = min;
+    chunk_data.chunk.max = max;
+    chunk_data.is_dirty = false;
+
+    if (chunk_data.proxy != DynamicAABBTree::NULL_PROXY) {
+        static_geometry_single_component.m_tree.update(chunk_data.proxy, min, max);
+    } else {
+        chunk_data.proxy = static_geometry_single_component.m_tree.insert(min, max, chunk_identifier);
+    }
+}
+
+} // namespace hg
@@ -1,23 +1,32 @@
 #include "world/render/texture_single_component.h"
 
-#include <ghc/filesystem.hpp>
-
 namespace hg {
 
-const Texture& TextureSingleComponent::get(const std::string& name) const {
-    const std::string normalized_name = ghc::filesystem::path(name).lexically_normal().string();
-    if (auto result = m_textures.find(normalized_name); result != m_textures.end()) {
+const Texture& TextureSingleComponent::get(ResourceId id) const {
+    if (auto result = m_textures.find(id); result != m_textures.end()) {
         return result->second;
     }
+    if (auto result = m_texture_layers.find(id); result != m_texture_layers.end()) {
+        return *result->second.texture_array;
+    }
     return m_default_texture;
 }
 
-const Texture* TextureSingleComponent::get_if(const std::string& name) const {
-    const std::string normalized_name = ghc::filesystem::path(name).lexically_normal().string();
-    if (auto result = m_textures.find(normalized_name); result != m_textures.end()) {
+const Texture* TextureSingleComponent::get_if(ResourceId id) const {
+    if (auto result = m_textures.find(id); result != m_textures.end()) {
         return &result->second;
     }
+    if (auto result = m_texture_layers.find(id); result != m_texture_layers.end()) {
+        return result->second.texture_array;
+    }
     return nullptr;
 }
 
+uint16_t TextureSingleComponent::get_layer(ResourceId id) const {
+    if (auto result = m_texture_layers.find(id); result != m_texture_layers.end()) {
+        return result->second.layer;
+    }
+    return 0;
+}
+
 } // namespace hg
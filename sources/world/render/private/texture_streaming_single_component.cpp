@@ -0,0 +1,17 @@
+#include "world/render/texture_streaming_single_component.h"
+
+namespace hg {
+
+size_t TextureStreamingSingleComponent::get_num_textures() const {
+    return m_textures.size();
+}
+
+size_t TextureStreamingSingleComponent::get_num_pending_loads() const {
+    return m_pending_loads.size();
+}
+
+size_t TextureStreamingSingleComponent::get_memory() const {
+    return m_memory;
+}
+
+} // namespace hg
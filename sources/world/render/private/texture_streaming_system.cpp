@@ -0,0 +1,292 @@
+#include "core/base/locked_output.h"
+#include "core/ecs/system_descriptor.h"
+#include "core/ecs/world.h"
+#include "world/render/blockout_component.h"
+#include "world/render/camera_single_component.h"
+#include "world/render/material_component.h"
+#include "world/render/model_component.h"
+#include "world/render/occlusion_culling_single_component.h"
+#include "world/render/render_tags.h"
+#include "world/render/static_geometry_single_component.h"
+#include "world/render/texture_streaming_single_component.h"
+#include "world/render/texture_streaming_system.h"
+#include "world/shared/frame_pacing_single_component.h"
+#include "world/shared/resource_loading_single_component.h"
+#include "world/shared/transform_component.h"
+#include "world/shared/window_single_component.h"
+
+#include <algorithm>
+#include <bgfx/bgfx.h>
+#include <cassert>
+#include <cmath>
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <iostream>
+#include <limits>
+#include <memory>
+
+namespace hg {
+
+namespace texture_streaming_system_details {
+
+static const size_t MEGABYTE = 1024 * 1024;
+
+/** Return diameter of the specified bounding sphere in screen heights. */
+static float get_screen_size(const CameraSingleComponent& camera_single_component, const glm::vec3& center, float radius) {
+    const float distance = glm::distance(center, camera_single_component.translation);
+    if (distance <= radius) {
+        // The camera is inside of the sphere, the closest surface may be arbitrarily close.
+        return std::numeric_limits<float>::max();
+    }
+    return radius / (distance * std::tan(camera_single_component.fov * 0.5f));
+}
+
+} // namespace texture_streaming_system_details
+
+SYSTEM_DESCRIPTOR(
+    SYSTEM(TextureStreamingSystem),
+    TAGS(render),
+    BEFORE("RenderSystem"),
+    AFTER("ResourceSystem", "GeometryPassSystem")
+)
+
+TextureStreamingSystem::TextureStreamingSystem(World& world)
+        : NormalSystem(world) {
+    world.ctx_or_set<TextureStreamingSingleComponent>();
+}
+
+void TextureStreamingSystem::update(float /*elapsed_time*/) {
+    auto& texture_streaming_single_component = world.ctx<TextureStreamingSingleComponent>();
+
+    // Nothing is streamed when streaming is disabled.
+    if (texture_streaming_single_component.m_textures.empty()) {
+        return;
+    }
+
+    texture_streaming_single_component.m_frame++;
+
+    request_mips(texture_streaming_single_component);
+    schedule_loads(texture_streaming_single_component);
+
+    // Idle editor must keep producing frames until all requested mips are published.
+    if (!texture_streaming_single_component.m_pending_loads.empty()) {
+        world.ctx<FramePacingSingleComponent>().wake_up();
+    }
+}
+
+void TextureStreamingSystem::finish_load(TextureStreamingSingleComponent& texture_streaming_single_component, size_t texture_index, uint8_t mip,
+                                         std::vector<uint8_t>&& data) const {
+    TextureStreamingSingleComponent::StreamedTexture& streamed_texture = texture_streaming_single_component.m_textures[texture_index];
+
+    Texture texture;
+    if (!data.empty()) {
+        texture = streamed_texture.file.create(mip, std::move(data));
+    }
+
+    if (bgfx::isValid(texture.handle)) {
+        bgfx::setName(texture.handle, streamed_texture.name.c_str());
+
+        // Previous handle is destroyed along with `texture`. bgfx keeps it alive until the end of the frame.
+        std::swap(*streamed_texture.texture, texture);
+        streamed_texture.resident_mip = mip;
+    } else {
+        LockedOutput(std::cerr) << "[RESOURCE] Failed to stream texture \"" << streamed_texture.name << "\"." << std::endl;
+
+        texture_streaming_single_component.m_memory -= streamed_texture.file.get_size(mip);
+        texture_streaming_single_component.m_memory += streamed_texture.file.get_size(streamed_texture.resident_mip);
+        streamed_texture.is_failed = true;
+    }
+
+    streamed_texture.is_loading = false;
+
+    auto& pending_loads = texture_streaming_single_component.m_pending_loads;
+    pending_loads.erase(std::find_if(pending_loads.begin(), pending_loads.end(), [&](const TextureStreamingSingleComponent::PendingLoad& pending_load) {
+        return pending_load.texture_index == texture_index;
+    }));
+}
+
+void TextureStreamingSystem::request_mips(TextureStreamingSingleComponent& texture_streaming_single_component) const {
+    using namespace texture_streaming_system_details;
+
+    auto& camera_single_component = world.ctx<CameraSingleComponent>();
+    auto& occlusion_culling_single_component = world.ctx<OcclusionCullingSingleComponent>();
+    auto& static_geometry_single_component = world.ctx<StaticGeometrySingleComponent>();
+    auto& window_single_component = world.ctx<WindowSingleComponent>();
+
+    for (TextureStreamingSingleComponent::StreamedTexture& streamed_texture : texture_streaming_single_component.m_textures) {
+        streamed_texture.requested_mip = streamed_texture.tail_mip;
+    }
+
+    const auto screen_height = static_cast<float>(window_single_component.height);
+
+    occlusion_culling_single_component.wait();
+
+    world.view<ModelComponent, MaterialComponent, TransformComponent>().each([&](entt::entity entity, ModelComponent& model_component, MaterialComponent& material_component, TransformComponent& transform_component) {
+        if (material_component.color_roughness == nullptr || material_component.normal_metal_ao == nullptr || model_component.model.children.empty() ||
+            static_geometry_single_component.is_merged(entity) || !occlusion_culling_single_component.is_visible(entity)) {
+            return;
+        }
+
+        const Model::AABB& bounds = model_component.model.bounds;
+        const glm::vec3 min(bounds.min_x, bounds.min_y, bounds.min_z);
+        const glm::vec3 max(bounds.max_x, bounds.max_y, bounds.max_z);
+
+        glm::mat4 transform = glm::translate(glm::mat4(1.f), transform_component.translation);
+        transform = transform * glm::mat4_cast(transform_component.rotation);
+        transform = glm::scale(transform, transform_component.scale);
+
+        const float scale = std::max(std::max(transform_component.scale.x, transform_component.scale.y), transform_component.scale.z);
+        const float radius = glm::length(max - min) * 0.5f * scale;
+        const glm::vec3 center(transform * glm::vec4((min + max) * 0.5f, 1.f));
+
+        // Regular models are expected to map their textures once, blockout repeats textures every world unit.
+        const float texture_repeats = world.has<BlockoutComponent>(entity) ? std::max(radius * 2.f, 1.f) : 1.f;
+        const float screen_texels = get_screen_size(camera_single_component, center, radius) * screen_height / texture_repeats;
+
+        request_mip(texture_streaming_single_component, material_component.color_roughness, screen_texels);
+        request_mip(texture_streaming_single_component, material_component.normal_metal_ao, screen_texels);
+    });
+
+    if (static_geometry_single_component.is_enabled) {
+        std::vector<const StaticGeometrySingleComponent::Chunk*> chunks;
+        static_geometry_single_component.query_frustum(camera_single_component.view_projection_matrix, chunks);
+
+        for (const StaticGeometrySingleComponent::Chunk* chunk : chunks) {
+            // Chunks contain only blockout geometry.
+            const float radius = glm::length(chunk->max - chunk->min) * 0.5f;
+            const glm::vec3 center = (chunk->min + chunk->max) * 0.5f;
+            const float screen_texels = get_screen_size(camera_single_component, center, radius) * screen_height / std::max(radius * 2.f, 1.f);
+
+            request_mip(texture_streaming_single_component, chunk->color_roughness, screen_texels);
+            request_mip(texture_streaming_single_component, chunk->normal_metal_ao, screen_texels);
+        }
+    }
+}
+
+void TextureStreamingSystem::request_mip(TextureStreamingSingleComponent& texture_streaming_single_component, const Texture* texture, float screen_texels) const {
+    auto texture_index = texture_streaming_single_component.m_texture_indices.find(texture);
+    if (texture_index == texture_streaming_single_component.m_texture_indices.end()) {
+        return;
+    }
+
+    TextureStreamingSingleComponent::StreamedTexture& streamed_texture = texture_streaming_single_component.m_textures[texture_index->second];
+    streamed_texture.last_used_frame = texture_streaming_single_component.m_frame;
+
+    // Each less detailed mip is needed when texture takes half as many pixels on the screen.
+    uint8_t mip = streamed_texture.tail_mip;
+    if (screen_texels > 0.f) {
+        const float texture_size = std::max(streamed_texture.file.width, streamed_texture.file.height);
+        const float desired_mip = std::floor(std::log2(texture_size / screen_texels));
+        mip = static_cast<uint8_t>(std::clamp(desired_mip, 0.f, static_cast<float>(streamed_texture.tail_mip)));
+    }
+
+    streamed_texture.requested_mip = std::min(streamed_texture.requested_mip, mip);
+}
+
+void TextureStreamingSystem::schedule_loads(TextureStreamingSingleComponent& texture_streaming_single_component) const {
+    using namespace texture_streaming_system_details;
+
+    const size_t budget = static_cast<size_t>(texture_streaming_single_component.budget) * MEGABYTE;
+
+    std::vector<size_t> texture_indices;
+    for (size_t i = 0; i < texture_streaming_single_component.m_textures.size(); i++) {
+        const TextureStreamingSingleComponent::StreamedTexture& streamed_texture = texture_streaming_single_component.m_textures[i];
+        if (!streamed_texture.is_loading && !streamed_texture.is_failed && streamed_texture.requested_mip < streamed_texture.resident_mip) {
+            texture_indices.push_back(i);
+        }
+    }
+
+    // The blurriest textures are loaded first.
+    std::sort(texture_indices.begin(), texture_indices.end(), [&](size_t a, size_t b) {
+        const TextureStreamingSingleComponent::StreamedTexture& texture_a = texture_streaming_single_component.m_textures[a];
+        const TextureStreamingSingleComponent::StreamedTexture& texture_b = texture_streaming_single_component.m_textures[b];
+        return texture_a.resident_mip - texture_a.requested_mip > texture_b.resident_mip - texture_b.requested_mip;
+    });
+
+    for (size_t texture_index : texture_indices) {
+        if (texture_streaming_single_component.m_pending_loads.size() >= texture_streaming_single_component.max_pending_loads) {
+            break;
+        }
+
+        const TextureStreamingSingleComponent::StreamedTexture& streamed_texture = texture_streaming_single_component.m_textures[texture_index];
+        const size_t resident_size = streamed_texture.file.get_size(streamed_texture.resident_mip);
+
+        auto fits_budget = [&](uint8_t mip) {
+            return texture_streaming_single_component.m_memory - resident_size + streamed_texture.file.get_size(mip) <= budget;
+        };
+
+        while (!fits_budget(streamed_texture.requested_mip) && schedule_eviction(texture_streaming_single_component)) {
+        }
+
+        // When the budget is exhausted, load as many mips as fit.
+        uint8_t mip = streamed_texture.requested_mip;
+        while (mip < streamed_texture.resident_mip && !fits_budget(mip)) {
+            mip++;
+        }
+
+        if (mip < streamed_texture.resident_mip && texture_streaming_single_component.m_pending_loads.size() < texture_streaming_single_component.max_pending_loads) {
+            schedule_load(texture_streaming_single_component, texture_index, mip);
+        }
+    }
+}
+
+bool TextureStreamingSystem::schedule_eviction(TextureStreamingSingleComponent& texture_streaming_single_component) const {
+    if (texture_streaming_single_component.m_pending_loads.size() >= texture_streaming_single_component.max_pending_loads) {
+        return false;
+    }
+
+    // Least recently used texture that has more mips than it needs. Textures not seen this frame need only mip tail.
+    size_t evicted_index = texture_streaming_single_component.m_textures.size();
+    for (size_t i = 0; i < texture_streaming_single_component.m_textures.size(); i++) {
+        const TextureStreamingSingleComponent::StreamedTexture& streamed_texture = texture_streaming_single_component.m_textures[i];
+        if (!streamed_texture.is_loading && !streamed_texture.is_failed && streamed_texture.requested_mip > streamed_texture.resident_mip &&
+            (evicted_index == texture_streaming_single_component.m_textures.size() ||
+             streamed_texture.last_used_frame < texture_streaming_single_component.m_textures[evicted_index].last_used_frame)) {
+            evicted_index = i;
+        }
+    }
+
+    if (evicted_index == texture_streaming_single_component.m_textures.size()) {
+        return false;
+    }
+
+    schedule_load(texture_streaming_single_component, evicted_index, texture_streaming_single_component.m_textures[evicted_index].requested_mip);
+    return true;
+}
+
+void TextureStreamingSystem::schedule_load(TextureStreamingSingleComponent& texture_streaming_single_component, size_t texture_index, uint8_t mip) const {
+    TextureStreamingSingleComponent::StreamedTexture& streamed_texture = texture_streaming_single_component.m_textures[texture_index];
+    assert(!streamed_texture.is_loading);
+
+    // Memory is accounted for right away, so the following loads see the budget that's going to be used.
+    texture_streaming_single_component.m_memory -= streamed_texture.file.get_size(streamed_texture.resident_mip);
+    texture_streaming_single_component.m_memory += streamed_texture.file.get_size(mip);
+
+    streamed_texture.is_loading = true;
+
+    TextureStreamingSingleComponent::PendingLoad& pending_load = texture_streaming_single_component.m_pending_loads.emplace_back();
+    pending_load.texture_index = texture_index;
+    pending_load.mip = mip;
+
+    // Mips are read on loader threads and published at the beginning of a frame within the upload budget.
+    auto data = std::make_shared<std::vector<uint8_t>>();
+
+    ResourceLoader::Job job;
+    job.name = streamed_texture.name;
+    job.read = [data, file = streamed_texture.file, mip]() {
+        *data = file.read(mip);
+    };
+    job.decode = [data]() {
+        return data->size();
+    };
+    job.upload = [this, texture_index, mip, data]() {
+        finish_load(world.ctx<TextureStreamingSingleComponent>(), texture_index, mip, std::move(*data));
+    };
+    job.fail = [this, texture_index, mip]() {
+        finish_load(world.ctx<TextureStreamingSingleComponent>(), texture_index, mip, {});
+    };
+
+    world.ctx<ResourceLoadingSingleComponent>().push(std::move(job));
+}
+
+} // namespace hg
@@ -4,13 +4,15 @@
 
 namespace hg {
 
-/** `QuadSingleComponent` contains vertices and indices for a 2x2 quad from -1 to +1 for both axes. */
+/** `QuadSingleComponent` contains vertices and indices for a 2x2 quad from -1 to +1 for both axes. `program` copies
+    the `u_uv_scale` part of a texture to the whole view, so `uv_scale_uniform` must be set before every submit. */
 struct QuadSingleComponent final {
     static constexpr uint32_t NUM_VERTICES = 4;
     static constexpr uint32_t NUM_INDICES  = 6;
 
     bgfx::IndexBufferHandle index_buffer   = BGFX_INVALID_HANDLE;
     bgfx::ProgramHandle program            = BGFX_INVALID_HANDLE;
+    bgfx::UniformHandle uv_scale_uniform   = BGFX_INVALID_HANDLE;
     bgfx::VertexBufferHandle vertex_buffer = BGFX_INVALID_HANDLE;
 };
 
@@ -10,6 +10,9 @@ public:
     explicit RenderFetchSystem(World& world);
     ~RenderFetchSystem() override;
     void update(float elapsed_time) override;
+
+private:
+    bool m_is_vsync_enabled;
 };
 
 } // namespace hg
@@ -6,6 +6,15 @@ namespace hg {
 struct RenderSingleComponent final {
     uint32_t current_frame = 0;
     bool show_debug_info = false;
+
+    /** When enabled, bgfx executes frame N on its own render thread while the world updates and submits frame N + 1.
+        This increases throughput at the cost of one extra frame of latency. `bgfx::frame` fences the two threads.
+        Must be set before `RenderFetchSystem` is created. */
+    bool is_render_thread_enabled = true;
+
+    /** When enabled, material textures of the same size and format are packed into texture arrays, so geometry with
+        different materials is drawn with identical texture bindings. Must be set before `ResourceSystem` is created. */
+    bool is_texture_array_enabled = false;
 };
 
 } // namespace hg
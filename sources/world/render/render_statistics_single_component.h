@@ -0,0 +1,41 @@
+#pragma once
+
+#include <bgfx/bgfx.h>
+
+#include <array>
+#include <map>
+#include <string>
+
+namespace hg {
+
+/** `RenderStatisticsSingleComponent` contains the history of frame and per render pass statistics collected from
+    `bgfx::getStats`. Histories are ring buffers, `history_offset` points to the oldest value. Times are in
+    milliseconds and memory is in megabytes. Statistics are only collected while debug info is shown. */
+struct RenderStatisticsSingleComponent final {
+    static constexpr size_t HISTORY_SIZE = 256;
+
+    using History = std::array<float, HISTORY_SIZE>;
+
+    struct PassStatistics final {
+        History cpu_time {};
+        History gpu_time {};
+    };
+
+    History frame_cpu_time {};
+    History frame_gpu_time {};
+    History num_draw_calls {};
+    History num_primitives {};
+    History texture_memory {};
+    History render_target_memory {};
+
+    /** Per render pass statistics by view identifier. */
+    std::map<bgfx::ViewId, PassStatistics> passes;
+
+    size_t history_offset = 0;
+    size_t num_frames     = 0;
+
+    std::string export_path = "render_statistics.csv";
+    std::string export_status;
+};
+
+} // namespace hg
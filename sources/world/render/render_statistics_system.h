@@ -0,0 +1,21 @@
+#pragma once
+
+#include "core/ecs/system.h"
+
+namespace hg {
+
+/** `RenderStatisticsSystem` collects per render pass GPU and CPU timings from bgfx and shows them with history graphs
+    in a window while debug info is enabled. The history can be exported to a CSV file. */
+class RenderStatisticsSystem final : public NormalSystem {
+public:
+    explicit RenderStatisticsSystem(World& world);
+    ~RenderStatisticsSystem() override;
+    void update(float elapsed_time) override;
+
+private:
+    void collect_statistics();
+    void show_statistics();
+    void export_statistics();
+};
+
+} // namespace hg
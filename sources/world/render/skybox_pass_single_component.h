@@ -14,6 +14,7 @@ struct SkyboxPassSingleComponent final {
     bgfx::UniformHandle rotation_uniform       = BGFX_INVALID_HANDLE;
     bgfx::UniformHandle skybox_texture_uniform = BGFX_INVALID_HANDLE;
     bgfx::UniformHandle texture_uniform        = BGFX_INVALID_HANDLE;
+    bgfx::UniformHandle uv_scale_uniform       = BGFX_INVALID_HANDLE;
 };
 
 } // namespace hg
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "core/math/dynamic_aabb_tree.h"
+#include "core/resource/model.h"
+
+#include <entt/entity/registry.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace hg {
+
+class StaticGeometrySystem;
+class Texture;
+
+/** `StaticGeometrySingleComponent` contains static blockout geometry merged into large chunks. Entities with
+    `BlockoutComponent` and `PhysicsStaticRigidBodyComponent` never move in game, so instead of drawing each of them
+    separately, the ones that share a material and a spatial cell are baked into a single vertex and index buffer.
+    Chunks are maintained by `StaticGeometrySystem` and drawn by `GeometryPassSystem` when merging is enabled. While
+    merging is disabled, only the assignment of entities to chunks is kept, chunk buffers are not built. */
+class StaticGeometrySingleComponent final {
+public:
+    /** `Chunk` is a piece of merged geometry. Vertices are in world space, blockout texture coordinates are baked into
+        vertices, so chunks are drawn with the regular geometry pass shader and identity transform. */
+    struct Chunk final {
+        Model::Primitive primitive;
+
+        const Texture* color_roughness = nullptr;
+        const Texture* normal_metal_ao = nullptr;
+        uint16_t layer                 = 0;
+
+        glm::vec3 min = glm::vec3(0.f);
+        glm::vec3 max = glm::vec3(0.f);
+    };
+
+    /** Size of a spatial cell in world units. Entities are assigned to cells by their bounds center. */
+    static constexpr float CELL_SIZE = 32.f;
+
+    StaticGeometrySingleComponent();
+    StaticGeometrySingleComponent(const StaticGeometrySingleComponent& another) = delete;
+    StaticGeometrySingleComponent(StaticGeometrySingleComponent&& another);
+    StaticGeometrySingleComponent& operator=(const StaticGeometrySingleComponent& another) = delete;
+    StaticGeometrySingleComponent& operator=(StaticGeometrySingleComponent&& another);
+    ~StaticGeometrySingleComponent();
+
+    /** Return true if the specified entity is drawn as a part of a chunk. Always false when merging is disabled. */
+    bool is_merged(entt::entity entity) const;
+
+    /** Append chunks that are at least partially inside of the frustum specified by `view_projection` to `result`. */
+    void query_frustum(const glm::mat4& view_projection, std::vector<const Chunk*>& result) const;
+
+    /** Return number of chunks. */
+    size_t get_num_chunks() const;
+
+    /** Return number of merged entities. */
+    size_t get_num_merged_entities() const;
+
+    /** Enabled by default when the world has no editor tag. Toggled by F8. */
+    bool is_enabled = true;
+
+private:
+    struct ChunkKey final {
+        const Texture* color_roughness;
+        const Texture* normal_metal_ao;
+        uint16_t layer;
+        int32_t x;
+        int32_t y;
+        int32_t z;
+
+        bool operator<(const ChunkKey& another) const;
+    };
+
+    struct ChunkData final {
+        Chunk chunk;
+        std::vector<entt::entity> entities;
+        uint32_t proxy = DynamicAABBTree::NULL_PROXY;
+        bool is_dirty = false;
+    };
+
+    /** Chunks are stored by identifiers, which are tree values. */
+    std::unordered_map<uint32_t, ChunkData> m_chunks;
+    std::map<ChunkKey, uint32_t> m_chunk_identifiers;
+    std::unordered_map<entt::entity, uint32_t> m_entity_chunks;
+    DynamicAABBTree m_tree;
+    uint32_t m_next_chunk_identifier = 0;
+
+    friend class StaticGeometrySystem;
+};
+
+} // namespace hg
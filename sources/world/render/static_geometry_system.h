@@ -0,0 +1,40 @@
+#pragma once
+
+#include "core/ecs/system.h"
+
+#include <entt/entity/observer.hpp>
+#include <vector>
+
+namespace hg {
+
+class StaticGeometrySingleComponent;
+
+/** `StaticGeometrySystem` keeps chunks of `StaticGeometrySingleComponent` in sync with static blockout entities.
+    Only the chunks affected by added, changed or removed entities are rebuilt, so editing a level stays interactive.
+    Transform changes must be signalled either by `replace` or by `notify`, direct writes are not observed. */
+class StaticGeometrySystem final : public NormalSystem {
+public:
+    explicit StaticGeometrySystem(World& world);
+    ~StaticGeometrySystem() override;
+    void update(float elapsed_time) override;
+
+private:
+    void static_geometry_destroyed(entt::entity entity, entt::registry& registry);
+
+    void add_entity(StaticGeometrySingleComponent& static_geometry_single_component, entt::entity entity);
+    void remove_entity(StaticGeometrySingleComponent& static_geometry_single_component, entt::entity entity);
+    void build_chunk(StaticGeometrySingleComponent& static_geometry_single_component, uint32_t chunk_identifier);
+    void release_chunks(StaticGeometrySingleComponent& static_geometry_single_component);
+
+    entt::observer m_static_geometry_observer;
+
+    /** Entities that existed before this system was created. */
+    std::vector<entt::entity> m_initial_entities;
+
+    bool m_has_dirty_chunks = false;
+
+    /** Chunks own GPU buffers only while merging is enabled. */
+    bool m_are_chunks_built = false;
+};
+
+} // namespace hg
@@ -1,25 +1,37 @@
 #pragma once
 
+#include "core/resource/resource_id.h"
 #include "core/resource/texture.h"
 
-#include <string>
+#include <list>
 #include <unordered_map>
 
 namespace hg {
 
 class ResourceSystem;
 
-/** `TextureSingleComponent` contains all available textures. */
+/** `TextureSingleComponent` contains all available textures. When texture arrays are enabled, material textures of the
+    same size and format are packed into 2D texture arrays. Such textures are returned as their texture array. */
 class TextureSingleComponent final {
 public:
-    /** Return texture with the specified name or default texture if such texture doesn't exist. */
-    const Texture& get(const std::string& name) const;
+    /** Return texture with the specified identifier or default texture if such texture doesn't exist. */
+    const Texture& get(ResourceId id) const;
 
-    /** Return texture with the specified name or nullptr if such texture doesn't exist. */
-    const Texture* get_if(const std::string& name) const;
+    /** Return texture with the specified identifier or nullptr if such texture doesn't exist. */
+    const Texture* get_if(ResourceId id) const;
+
+    /** Return layer of the texture with the specified identifier in its texture array or zero if it's not packed. */
+    uint16_t get_layer(ResourceId id) const;
 
 private:
-    std::unordered_map<std::string, Texture> m_textures;
+    struct TextureLayer final {
+        const Texture* texture_array;
+        uint16_t layer;
+    };
+
+    std::unordered_map<ResourceId, Texture> m_textures;
+    std::unordered_map<ResourceId, TextureLayer> m_texture_layers;
+    std::list<Texture> m_texture_arrays;
     Texture m_default_texture;
 
     friend class ResourceSystem;
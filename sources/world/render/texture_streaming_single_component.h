@@ -0,0 +1,90 @@
+#pragma once
+
+#include "core/resource/dds_file.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hg {
+
+class ResourceSystem;
+class Texture;
+class TextureStreamingSystem;
+
+/** `TextureStreamingSingleComponent` contains the state of material texture streaming. Initially `ResourceSystem` loads
+    only the mip tail of each material texture, which is the mips not larger than `max_tail_size`. Then
+    `TextureStreamingSystem` loads more detailed mips on `ResourceSystem` loader threads based on the on-screen size of visible
+    entities. Textures that were not seen recently lose their detailed mips when `budget` is exceeded. Streamed
+    textures keep their `Texture` instance, only the handle is replaced. Settings may be set up before
+    `ResourceSystem` is created. */
+class TextureStreamingSingleComponent final {
+public:
+    TextureStreamingSingleComponent() = default;
+    TextureStreamingSingleComponent(const TextureStreamingSingleComponent& another) = delete;
+    TextureStreamingSingleComponent(TextureStreamingSingleComponent&& another) = default;
+    TextureStreamingSingleComponent& operator=(const TextureStreamingSingleComponent& another) = delete;
+    TextureStreamingSingleComponent& operator=(TextureStreamingSingleComponent&& another) = default;
+
+    /** Return number of streamed textures. */
+    size_t get_num_textures() const;
+
+    /** Return number of mip chains that are being loaded right now. */
+    size_t get_num_pending_loads() const;
+
+    /** Return video memory used by streamed textures in bytes, including the pending loads. */
+    size_t get_memory() const;
+
+    /** When disabled, textures are loaded with all mips. Must be set before `ResourceSystem` is created. */
+    bool is_enabled = true;
+
+    /** Video memory budget for streamed textures in megabytes. Mip tails are always loaded, even over the budget. */
+    uint32_t budget = 256;
+
+    /** Maximum width and height of the mips that are loaded at startup. */
+    uint16_t max_tail_size = 64;
+
+    /** Maximum number of mip chains loaded at the same time. */
+    uint32_t max_pending_loads = 4;
+
+private:
+    struct StreamedTexture final {
+        Texture* texture = nullptr;
+        std::string name;
+        DdsFile file;
+
+        /** The least detailed mip that is ever loaded. */
+        uint8_t tail_mip = 0;
+
+        /** The most detailed mip in video memory. */
+        uint8_t resident_mip = 0;
+
+        /** The most detailed mip that is needed this frame. */
+        uint8_t requested_mip = 0;
+
+        uint32_t last_used_frame = 0;
+        bool is_loading = false;
+
+        /** Set when loading failed, such texture stays at its resident mip. */
+        bool is_failed = false;
+    };
+
+    struct PendingLoad final {
+        size_t texture_index = 0;
+        uint8_t mip = 0;
+    };
+
+    std::vector<StreamedTexture> m_textures;
+    std::unordered_map<const Texture*, size_t> m_texture_indices;
+    std::vector<PendingLoad> m_pending_loads;
+
+    /** Sum of sizes of the resident mip chains, or the ones being loaded. */
+    size_t m_memory = 0;
+
+    uint32_t m_frame = 0;
+
+    friend class ResourceSystem;
+    friend class TextureStreamingSystem;
+};
+
+} // namespace hg
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "core/ecs/system.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace hg {
+
+class Texture;
+class TextureStreamingSingleComponent;
+
+/** `TextureStreamingSystem` requests detailed mips of material textures depending on the on-screen size of visible
+    entities, loads them as `ResourceLoader` jobs and keeps streamed textures within the video memory budget. Loaded mips
+    are published by `ResourceSystem` within its upload budget. */
+class TextureStreamingSystem final : public NormalSystem {
+public:
+    explicit TextureStreamingSystem(World& world);
+    void update(float elapsed_time) override;
+
+private:
+    void finish_load(TextureStreamingSingleComponent& texture_streaming_single_component, size_t texture_index, uint8_t mip, std::vector<uint8_t>&& data) const;
+    void request_mips(TextureStreamingSingleComponent& texture_streaming_single_component) const;
+    void request_mip(TextureStreamingSingleComponent& texture_streaming_single_component, const Texture* texture, float screen_texels) const;
+    void schedule_loads(TextureStreamingSingleComponent& texture_streaming_single_component) const;
+    bool schedule_eviction(TextureStreamingSingleComponent& texture_streaming_single_component) const;
+    void schedule_load(TextureStreamingSingleComponent& texture_streaming_single_component, size_t texture_index, uint8_t mip) const;
+};
+
+} // namespace hg
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace entt {
+
+struct meta_handle;
+
+} // namespace entt
+
+namespace hg {
+
+class World;
+struct NameSingleComponent;
+
+/** Cooked level is a binary image of a level file. It consists of a header, a string table and a block per component
+    type. Each block stores indices of entities the components are assigned to and a column per scalar property of
+    the component type. Columns are generated from component reflection, so the image is valid only as long as the
+    schema hash, computed from the same reflection, matches. YAML level is the source format, cooked level is loaded
+    straight from the memory mapped file without any parsing. */
+
+/** `CookedLevelWriter` cooks a level either from components as they're inserted into a world, so the source level
+    doesn't have to be kept in memory as a whole, or straight from a world one component pool at a time. */
+class CookedLevelWriter final {
+public:
+    CookedLevelWriter();
+
+    /** Add level entities of the specified world, which are entities with `NameComponent`, to the cooked level. Each
+        editable component pool is iterated once, entities without serialized components are not added. */
+    void add_level(const World& world, bool serialize_editor_component = false);
+
+    /** Add the specified number of entities without components and return index of the first one. */
+    uint32_t add_entities(uint32_t count);
+
+    /** Add the specified editable component to the entity with the specified index. An entity must not be given two
+        components of the same type. */
+    void add_component(uint32_t entity_index, entt::meta_handle component);
+
+    /** Return image of all added entities. `source_size` and `source_time` identify the YAML file the level was read
+        from, see `is_cooked_level_up_to_date`. */
+    std::vector<uint8_t> finish(uint64_t source_size, int64_t source_time);
+
+private:
+    struct Block final {
+        std::vector<uint32_t> entities;
+        std::vector<std::vector<uint32_t>> columns;
+    };
+
+    /** Equal strings are stored once. */
+    uint32_t add_string(const std::string& string);
+
+    std::vector<Block> m_blocks;
+    std::vector<char> m_strings;
+    std::unordered_map<std::string, uint32_t> m_string_offsets;
+    uint32_t m_num_entities = 0;
+};
+
+/** Return true if the specified image is a cooked level of the current version and component schema that was cooked
+    from the source file of the specified size and modification time. */
+bool is_cooked_level_up_to_date(const uint8_t* data, size_t size, uint64_t source_size, int64_t source_time);
+
+/** Create level entities and assign their components from the specified cooked level image. Components of each type
+    are assigned in bulk. `NameComponent` is assigned only when `name_single_component` is specified. Return false if the image is corrupted, the world is not
+    modified in this case. */
+bool load_cooked_level(World& world, const uint8_t* data, size_t size, NameSingleComponent* name_single_component = nullptr);
+
+} // namespace hg
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace hg {
+
+class FramePacingSystem;
+
+/** `FramePacingSingleComponent` controls how often frames are produced. Must be set up before `FramePacingSystem` and
+    `RenderFetchSystem` are created, but may be changed at any time later. */
+class FramePacingSingleComponent final {
+public:
+    /** Number of frames rendered after the last activity before the editor goes idle. Picking read back and the render
+        thread lag a few frames behind, so they need some time to catch up. */
+    static constexpr uint32_t ACTIVE_FRAME_COUNT = 10;
+
+    /** Keep producing frames for a while. Must be called by systems that change something on the screen without user
+        input (like physics simulation or camera animation). */
+    void wake_up();
+
+    /** Return whether there was no activity for the last `ACTIVE_FRAME_COUNT` frames. */
+    bool is_idle() const;
+
+    /** Maximum number of frames per second, zero means uncapped. */
+    uint32_t target_fps = 0;
+
+    bool is_vsync_enabled = true;
+
+    /** When enabled, the editor stops producing frames when nothing changes and waits for input instead. */
+    bool is_idle_enabled = true;
+
+    /** While idle, a frame is still produced every `idle_timeout` milliseconds. */
+    uint32_t idle_timeout = 1000;
+
+private:
+    uint32_t m_active_frames = ACTIVE_FRAME_COUNT;
+    std::chrono::steady_clock::time_point m_last_frame_time;
+
+    friend class FramePacingSystem;
+};
+
+} // namespace hg
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "core/ecs/system.h"
+
+namespace hg {
+
+/** `FramePacingSystem` limits frame rate to `FramePacingSingleComponent::target_fps` and blocks until the next input
+    event when the editor is idle. */
+class FramePacingSystem final : public NormalSystem {
+public:
+    explicit FramePacingSystem(World& world);
+    void update(float elapsed_time) override;
+};
+
+} // namespace hg
@@ -0,0 +1,561 @@
+#include "core/ecs/component_manager.h"
+#include "core/ecs/world.h"
+#include "core/meta/serialization_plan.h"
+#include "world/shared/cooked_level.h"
+#include "world/shared/name_component.h"
+#include "world/shared/name_single_component.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <entt/meta/factory.hpp>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+namespace hg {
+
+namespace cooked_level_details {
+
+/** "HGLV" in little endian. */
+static const uint32_t MAGIC = 0x564C4748;
+
+/** Must be increased whenever the layout changes. Changes of component reflection are tracked by the schema hash. */
+static const uint32_t VERSION = 1;
+
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+static const uint64_t FNV_PRIME = 1099511628211ull;
+
+/** Every scalar is stored as 32-bit value. Strings are stored as offsets in the string table. */
+using Kind = SerializationPlan::Kind;
+using Property = SerializationPlan::Property;
+
+struct Header final {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t schema_hash;
+    uint64_t source_size;
+    int64_t source_time;
+    uint32_t num_entities;
+    uint32_t num_blocks;
+    uint32_t strings_offset;
+    uint32_t strings_size;
+};
+
+/** Block data consists of `num_components` entity indices followed by `num_columns` columns of `num_components`
+    values each. Columns are stored in preorder of the component's property tree. */
+struct BlockRecord final {
+    uint32_t name_offset;
+    uint32_t num_components;
+    uint32_t num_columns;
+    uint32_t data_offset;
+};
+
+static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<BlockRecord>,
+              "Cooked level records must be trivially copyable.");
+
+/** Each scalar property of the component plan, including properties of nested structures, is a column. */
+struct ComponentSchema final {
+    const SerializationPlan* plan;
+    uint32_t num_columns;
+};
+
+struct LevelSchema final {
+    std::vector<ComponentSchema> components;
+    uint64_t hash;
+};
+
+uint64_t hash(uint64_t result, const void* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        result ^= static_cast<const uint8_t*>(data)[i];
+        result *= FNV_PRIME;
+    }
+    return result;
+}
+
+uint32_t count_columns(const SerializationPlan& plan) {
+    uint32_t result = 0;
+    for (const Property& property : plan.get_properties()) {
+        result += property.kind == Kind::STRUCTURE ? count_columns(*property.plan) : 1;
+    }
+    return result;
+}
+
+uint64_t hash_plan(uint64_t result, const SerializationPlan& plan) {
+    for (const Property& property : plan.get_properties()) {
+        result = hash(result, property.name.c_str(), property.name.size() + 1);
+        result = hash(result, &property.kind, sizeof(property.kind));
+        if (property.kind == Kind::STRUCTURE) {
+            result = hash_plan(result, *property.plan);
+            result = hash(result, "}", 1);
+        }
+    }
+    return result;
+}
+
+/** Component reflection doesn't change at runtime, so the schema is built on first use. */
+const LevelSchema& get_schema() {
+    static const LevelSchema schema = []() {
+        LevelSchema result;
+
+        ComponentManager::each_editable([&](const entt::meta_type component_type) {
+            ComponentSchema& component_schema = result.components.emplace_back();
+            component_schema.plan = &SerializationPlan::get(component_type);
+            component_schema.num_columns = count_columns(*component_schema.plan);
+        });
+
+        // Registry order is unspecified, so components are sorted to make the hash and the block order stable.
+        std::sort(result.components.begin(), result.components.end(), [](const ComponentSchema& lhs, const ComponentSchema& rhs) {
+            return lhs.plan->get_name() < rhs.plan->get_name();
+        });
+
+        result.hash = hash(FNV_OFFSET_BASIS, &VERSION, sizeof(VERSION));
+        for (const ComponentSchema& component_schema : result.components) {
+            const std::string& name = component_schema.plan->get_name();
+            result.hash = hash(result.hash, name.c_str(), name.size() + 1);
+            result.hash = hash_plan(result.hash, *component_schema.plan);
+        }
+
+        return result;
+    }();
+    return schema;
+}
+
+const ComponentSchema* find_component_schema(const LevelSchema& schema, const char* name) {
+    for (const ComponentSchema& component_schema : schema.components) {
+        if (component_schema.plan->get_name() == name) {
+            return &component_schema;
+        }
+    }
+    return nullptr;
+}
+
+const ComponentSchema* find_component_schema(const LevelSchema& schema, const entt::meta_type component_type) {
+    for (const ComponentSchema& component_schema : schema.components) {
+        if (component_schema.plan->get_type() == component_type) {
+            return &component_schema;
+        }
+    }
+    return nullptr;
+}
+
+template <typename AddString>
+uint32_t encode_scalar(const Property& property, const entt::meta_handle object, AddString& add_string) {
+    const entt::meta_any value = property.data.get(object);
+    assert(value);
+
+    uint32_t result = 0;
+    switch (property.kind) {
+        case Kind::INT: {
+            const auto int_value = value.cast<int32_t>();
+            std::memcpy(&result, &int_value, sizeof(result));
+            break;
+        }
+        case Kind::UINT:
+            result = value.cast<uint32_t>();
+            break;
+        case Kind::FLOAT: {
+            const auto float_value = value.cast<float>();
+            std::memcpy(&result, &float_value, sizeof(result));
+            break;
+        }
+        case Kind::BOOL:
+            result = value.cast<bool>() ? 1 : 0;
+            break;
+        case Kind::STRING:
+            result = add_string(value.cast<std::string>());
+            break;
+        case Kind::STRUCTURE:
+            assert(false);
+            break;
+    }
+    return result;
+}
+
+template <typename AddString>
+void encode_properties(const SerializationPlan& plan, const entt::meta_handle object, AddString& add_string,
+                       std::vector<std::vector<uint32_t>>& columns, size_t& column) {
+    for (const Property& property : plan.get_properties()) {
+        if (property.kind == Kind::STRUCTURE) {
+            entt::meta_any child = property.data.get(object);
+            assert(child);
+
+            encode_properties(*property.plan, child, add_string, columns, column);
+        } else {
+            columns[column++].push_back(encode_scalar(property, object, add_string));
+        }
+    }
+}
+
+struct BlockReader final {
+    const uint8_t* columns;
+    uint32_t num_components;
+    uint32_t index;
+    const char* strings;
+};
+
+uint32_t read_value(const BlockReader& reader, size_t column) {
+    uint32_t result;
+    std::memcpy(&result, reader.columns + (column * reader.num_components + reader.index) * sizeof(uint32_t), sizeof(result));
+    return result;
+}
+
+bool decode_scalar(const Property& property, const entt::meta_handle object, uint32_t value, const char* strings) {
+    switch (property.kind) {
+        case Kind::INT: {
+            int32_t int_value;
+            std::memcpy(&int_value, &value, sizeof(int_value));
+            return property.data.set(object, int_value);
+        }
+        case Kind::UINT:
+            return property.data.set(object, value);
+        case Kind::FLOAT: {
+            float float_value;
+            std::memcpy(&float_value, &value, sizeof(float_value));
+            return property.data.set(object, float_value);
+        }
+        case Kind::BOOL:
+            return property.data.set(object, value != 0);
+        case Kind::STRING:
+            return property.data.set(object, std::string(strings + value));
+        case Kind::STRUCTURE:
+            assert(false);
+            return false;
+    }
+    return false;
+}
+
+bool decode_properties(const SerializationPlan& plan, const entt::meta_handle object, const BlockReader& reader, size_t& column) {
+    for (const Property& property : plan.get_properties()) {
+        if (property.kind == Kind::STRUCTURE) {
+            entt::meta_any child = property.data.get(object);
+            if (!child || !decode_properties(*property.plan, child, reader, column) || !property.data.set(object, child)) {
+                return false;
+            }
+        } else {
+            if (!decode_scalar(property, object, read_value(reader, column++), reader.strings)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/** Mark columns of string properties, so string offsets are validated before anything is loaded. */
+void get_string_columns(const SerializationPlan& plan, std::vector<bool>& result) {
+    for (const Property& property : plan.get_properties()) {
+        if (property.kind == Kind::STRUCTURE) {
+            get_string_columns(*property.plan, result);
+        } else {
+            result.push_back(property.kind == Kind::STRING);
+        }
+    }
+}
+
+bool read_header(const uint8_t* data, size_t size, Header& header) {
+    if (data == nullptr || size < sizeof(Header)) {
+        return false;
+    }
+
+    std::memcpy(&header, data, sizeof(Header));
+    return header.magic == MAGIC && header.version == VERSION && header.schema_hash == get_schema().hash;
+}
+
+} // namespace cooked_level_details
+
+CookedLevelWriter::CookedLevelWriter() {
+    using namespace cooked_level_details;
+
+    const LevelSchema& schema = get_schema();
+
+    m_blocks.resize(schema.components.size());
+    for (size_t i = 0; i < m_blocks.size(); i++) {
+        m_blocks[i].columns.resize(schema.components[i].num_columns);
+    }
+
+    // The table starts with an empty string, so it's never empty.
+    add_string(std::string());
+}
+
+void CookedLevelWriter::add_level(const World& world, const bool serialize_editor_component) {
+    using namespace cooked_level_details;
+
+    const LevelSchema& schema = get_schema();
+
+    // Entity indices are assigned on first serialized component, so entities without ones are not added.
+    const uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> entity_indices(world.size(), NO_INDEX);
+
+    auto add_string = [this](const std::string& string) {
+        return this->add_string(string);
+    };
+
+    for (size_t i = 0; i < schema.components.size(); i++) {
+        const ComponentSchema& component_schema = schema.components[i];
+
+        const entt::meta_type component_type = component_schema.plan->get_type();
+        if (component_type == entt::resolve<NameComponent>() && !serialize_editor_component) {
+            continue;
+        }
+
+        Block& block = m_blocks[i];
+
+        world.each_component(component_type, [&](const entt::entity entity, const entt::meta_handle component) {
+            if (!world.has<NameComponent>(entity)) {
+                return;
+            }
+
+            uint32_t& entity_index = entity_indices[entt::to_integer(World::entity(entity))];
+            if (entity_index == NO_INDEX) {
+                entity_index = m_num_entities++;
+            }
+
+            size_t column = 0;
+            encode_properties(*component_schema.plan, component, add_string, block.columns, column);
+            block.entities.push_back(entity_index);
+        });
+    }
+}
+
+uint32_t CookedLevelWriter::add_entities(const uint32_t count) {
+    const uint32_t result = m_num_entities;
+    m_num_entities += count;
+    return result;
+}
+
+void CookedLevelWriter::add_component(const uint32_t entity_index, const entt::meta_handle component) {
+    using namespace cooked_level_details;
+
+    assert(component);
+    assert(entity_index < m_num_entities);
+
+    const LevelSchema& schema = get_schema();
+
+    const ComponentSchema* component_schema = find_component_schema(schema, component.type());
+    if (component_schema == nullptr) {
+        return;
+    }
+
+    auto add_string = [this](const std::string& string) {
+        return this->add_string(string);
+    };
+
+    Block& block = m_blocks[component_schema - schema.components.data()];
+
+    size_t column = 0;
+    encode_properties(*component_schema->plan, component, add_string, block.columns, column);
+    block.entities.push_back(entity_index);
+}
+
+std::vector<uint8_t> CookedLevelWriter::finish(uint64_t source_size, int64_t source_time) {
+    using namespace cooked_level_details;
+
+    const LevelSchema& schema = get_schema();
+
+    std::vector<BlockRecord> records;
+    for (size_t i = 0; i < m_blocks.size(); i++) {
+        if (!m_blocks[i].entities.empty()) {
+            BlockRecord record {};
+            record.name_offset = add_string(schema.components[i].plan->get_name());
+            record.num_components = static_cast<uint32_t>(m_blocks[i].entities.size());
+            record.num_columns = static_cast<uint32_t>(m_blocks[i].columns.size());
+            records.push_back(record);
+        }
+    }
+
+    size_t offset = sizeof(Header) + records.size() * sizeof(BlockRecord);
+    for (BlockRecord& record : records) {
+        record.data_offset = static_cast<uint32_t>(offset);
+        offset += (1 + size_t(record.num_columns)) * record.num_components * sizeof(uint32_t);
+    }
+
+    Header header {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.schema_hash = schema.hash;
+    header.source_size = source_size;
+    header.source_time = source_time;
+    header.num_entities = m_num_entities;
+    header.num_blocks = static_cast<uint32_t>(records.size());
+    header.strings_offset = static_cast<uint32_t>(offset);
+    header.strings_size = static_cast<uint32_t>(m_strings.size());
+
+    assert(offset + m_strings.size() <= std::numeric_limits<uint32_t>::max());
+
+    std::vector<uint8_t> result(offset + m_strings.size());
+    uint8_t* output = result.data();
+
+    auto write = [&](const void* source, size_t size) {
+        if (size > 0) {
+            std::memcpy(output, source, size);
+            output += size;
+        }
+    };
+
+    write(&header, sizeof(Header));
+    write(records.data(), records.size() * sizeof(BlockRecord));
+    for (const Block& block : m_blocks) {
+        if (!block.entities.empty()) {
+            write(block.entities.data(), block.entities.size() * sizeof(uint32_t));
+            for (const std::vector<uint32_t>& column : block.columns) {
+                write(column.data(), column.size() * sizeof(uint32_t));
+            }
+        }
+    }
+    write(m_strings.data(), m_strings.size());
+
+    assert(output == result.data() + result.size());
+
+    return result;
+}
+
+uint32_t CookedLevelWriter::add_string(const std::string& string) {
+    auto [it, is_inserted] = m_string_offsets.emplace(string, static_cast<uint32_t>(m_strings.size()));
+    if (is_inserted) {
+        m_strings.insert(m_strings.end(), string.begin(), string.end());
+        m_strings.push_back('\0');
+    }
+    return it->second;
+}
+
+bool is_cooked_level_up_to_date(const uint8_t* data, size_t size, uint64_t source_size, int64_t source_time) {
+    using namespace cooked_level_details;
+
+    Header header;
+    return read_header(data, size, header) && header.source_size == source_size && header.source_time == source_time;
+}
+
+bool load_cooked_level(World& world, const uint8_t* data, size_t size, NameSingleComponent* name_single_component) {
+    using namespace cooked_level_details;
+
+    const LevelSchema& schema = get_schema();
+
+    Header header;
+    if (!read_header(data, size, header)) {
+        return false;
+    }
+
+    const uint64_t records_end = sizeof(Header) + uint64_t(header.num_blocks) * sizeof(BlockRecord);
+    if (records_end > size || uint64_t(header.strings_offset) + header.strings_size > size ||
+        header.strings_size == 0 || data[header.strings_offset + header.strings_size - 1] != '\0') {
+        return false;
+    }
+
+    const auto* strings = reinterpret_cast<const char*>(data + header.strings_offset);
+
+    std::vector<BlockRecord> records(header.num_blocks);
+    if (header.num_blocks > 0) {
+        std::memcpy(records.data(), data + sizeof(Header), records.size() * sizeof(BlockRecord));
+    }
+
+    // Everything is validated first, so a corrupted image doesn't leave a partially loaded level behind.
+    std::vector<const ComponentSchema*> component_schemas(records.size());
+    std::vector<bool> loaded_schemas(schema.components.size(), false);
+    std::vector<size_t> entity_blocks(header.num_entities, 0);
+    for (size_t i = 0; i < records.size(); i++) {
+        const BlockRecord& record = records[i];
+        if (record.name_offset >= header.strings_size || record.data_offset % sizeof(uint32_t) != 0 ||
+            record.data_offset + (1 + uint64_t(record.num_columns)) * record.num_components * sizeof(uint32_t) > size) {
+            return false;
+        }
+
+        component_schemas[i] = find_component_schema(schema, strings + record.name_offset);
+        if (component_schemas[i] == nullptr || component_schemas[i]->num_columns != record.num_columns) {
+            return false;
+        }
+
+        const size_t schema_index = component_schemas[i] - schema.components.data();
+        if (loaded_schemas[schema_index]) {
+            return false;
+        }
+        loaded_schemas[schema_index] = true;
+
+        std::vector<bool> string_columns;
+        get_string_columns(*component_schemas[i]->plan, string_columns);
+
+        for (uint32_t column = 0; column <= record.num_columns; column++) {
+            const bool is_entity_column = column == 0;
+            if (!is_entity_column && !string_columns[column - 1]) {
+                continue;
+            }
+
+            const uint32_t limit = is_entity_column ? header.num_entities : header.strings_size;
+            for (uint32_t j = 0; j < record.num_components; j++) {
+                uint32_t value;
+                std::memcpy(&value, data + record.data_offset + (uint64_t(column) * record.num_components + j) * sizeof(uint32_t), sizeof(value));
+                if (value >= limit) {
+                    return false;
+                }
+
+                // Components are assigned in bulk, so an entity must not be listed in the same block twice.
+                if (is_entity_column) {
+                    if (entity_blocks[value] == i + 1) {
+                        return false;
+                    }
+                    entity_blocks[value] = i + 1;
+                }
+            }
+        }
+    }
+
+    std::vector<entt::entity> entities(header.num_entities);
+    world.create(entities.begin(), entities.end());
+
+    for (size_t i = 0; i < records.size(); i++) {
+        const BlockRecord& record = records[i];
+        const ComponentSchema& component_schema = *component_schemas[i];
+
+        const entt::meta_type component_type = component_schema.plan->get_type();
+
+        const bool is_editor_component = component_type == entt::resolve<NameComponent>();
+        if (is_editor_component && name_single_component == nullptr) {
+            continue;
+        }
+
+        std::vector<entt::entity> block_entities(record.num_components);
+        for (uint32_t j = 0; j < record.num_components; j++) {
+            uint32_t entity_index;
+            std::memcpy(&entity_index, data + record.data_offset + j * sizeof(uint32_t), sizeof(entity_index));
+            block_entities[j] = entities[entity_index];
+        }
+
+        // The whole block is assigned at once and decoded in place, so components are neither constructed nor moved
+        // one by one.
+        world.assign_default(block_entities.data(), block_entities.data() + block_entities.size(), component_type);
+
+        BlockReader reader {};
+        reader.columns = data + record.data_offset + record.num_components * sizeof(uint32_t);
+        reader.num_components = record.num_components;
+        reader.strings = strings;
+
+        for (reader.index = 0; reader.index < record.num_components; reader.index++) {
+            const entt::entity entity = block_entities[reader.index];
+
+            entt::meta_handle component = world.get(entity, component_type);
+            assert(component);
+
+            size_t column = 0;
+            if (!decode_properties(*component_schema.plan, component, reader, column)) {
+                std::cout << "[RESOURCE] Failed to decode component \"" << component_schema.plan->get_name() << "\"." << std::endl;
+                world.remove(entity, component_type);
+                continue;
+            }
+
+            if (is_editor_component) {
+                auto& name_component = *component.data<NameComponent>();
+
+                if (name_single_component->name_to_entity.count(name_component.name) > 0) {
+                    name_component.name = name_single_component->acquire_unique_name(entity, name_component.name);
+                } else {
+                    name_single_component->name_to_entity[name_component.name] = entity;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace hg
@@ -0,0 +1,13 @@
+#include "world/shared/frame_pacing_single_component.h"
+
+namespace hg {
+
+void FramePacingSingleComponent::wake_up() {
+    m_active_frames = ACTIVE_FRAME_COUNT;
+}
+
+bool FramePacingSingleComponent::is_idle() const {
+    return m_active_frames == 0;
+}
+
+} // namespace hg
@@ -0,0 +1,46 @@
+#include "core/ecs/system_descriptor.h"
+#include "core/ecs/world.h"
+#include "world/editor/editor_tags.h"
+#include "world/render/render_tags.h"
+#include "world/shared/frame_pacing_single_component.h"
+#include "world/shared/frame_pacing_system.h"
+
+#include <SDL2/SDL_events.h>
+#include <thread>
+
+namespace hg {
+
+SYSTEM_DESCRIPTOR(
+    SYSTEM(FramePacingSystem),
+    TAGS(render),
+    BEFORE("WindowSystem")
+)
+
+FramePacingSystem::FramePacingSystem(World& world)
+        : NormalSystem(world) {
+    auto& frame_pacing_single_component = world.ctx_or_set<FramePacingSingleComponent>();
+    frame_pacing_single_component.m_last_frame_time = std::chrono::steady_clock::now();
+}
+
+void FramePacingSystem::update(float /*elapsed_time*/) {
+    auto& frame_pacing_single_component = world.ctx<FramePacingSingleComponent>();
+
+    // Only the editor has nothing to do without user input.
+    if (frame_pacing_single_component.is_idle_enabled && world.check_tag(tags::editor) && frame_pacing_single_component.is_idle()) {
+        // Null event leaves the event in the queue for `WindowSystem`, which wakes frame pacing up.
+        SDL_WaitEventTimeout(nullptr, static_cast<int>(frame_pacing_single_component.idle_timeout));
+    }
+
+    if (frame_pacing_single_component.m_active_frames > 0) {
+        frame_pacing_single_component.m_active_frames--;
+    }
+
+    if (frame_pacing_single_component.target_fps > 0) {
+        const std::chrono::duration<double> frame_duration(1.0 / frame_pacing_single_component.target_fps);
+        std::this_thread::sleep_until(frame_pacing_single_component.m_last_frame_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(frame_duration));
+    }
+
+    frame_pacing_single_component.m_last_frame_time = std::chrono::steady_clock::now();
+}
+
+} // namespace hg
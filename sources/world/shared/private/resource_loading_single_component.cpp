@@ -0,0 +1,16 @@
+#include "world/shared/resource_loading_single_component.h"
+
+#include <cassert>
+
+namespace hg {
+
+size_t ResourceLoadingSingleComponent::get_num_pending_loads() const {
+    return m_num_pending_loads;
+}
+
+void ResourceLoadingSingleComponent::push(ResourceLoader::Job&& job) {
+    assert(m_loader != nullptr);
+    m_loader->push(std::move(job));
+}
+
+} // namespace hg
@@ -1,12 +1,22 @@
+#include "core/base/locked_output.h"
+#include "core/base/memory_mapped_file.h"
 #include "core/ecs/system_descriptor.h"
 #include "core/ecs/world.h"
+#include "core/resource/cooked_model.h"
+#include "core/resource/dds_file.h"
+#include "core/resource/resource_id.h"
+#include "core/resource/resource_loader.h"
 #include "core/resource/texture.h"
 #include "world/editor/editor_preset_single_component.h"
 #include "world/render/material_component.h"
 #include "world/render/model_component.h"
 #include "world/render/model_single_component.h"
+#include "world/render/render_single_component.h"
 #include "world/render/render_tags.h"
 #include "world/render/texture_single_component.h"
+#include "world/render/texture_streaming_single_component.h"
+#include "world/shared/frame_pacing_single_component.h"
+#include "world/shared/resource_loading_single_component.h"
 #include "world/shared/resource_system.h"
 #include "world/shared/resource_utils.h"
 
@@ -15,19 +25,24 @@
 
 #include <algorithm>
 #include <bgfx/bgfx.h>
+#include <bimg/bimg.h>
 #include <bx/file.h>
+#include <cstring>
 #include <entt/meta/factory.hpp>
 #include <fmt/format.h>
-#include <future>
+#include <fstream>
 #include <ghc/filesystem.hpp>
+#include <glm/common.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/mat4x4.hpp>
 #include <iostream>
-#include <mutex>
+#include <limits>
+#include <map>
 #include <tiny_gltf.h>
+#include <tuple>
 #include <yaml-cpp/yaml.h>
 
-#define RESOURCE_WARNING assert(false); std::cout << "[RESOURCE] "
+#define RESOURCE_WARNING assert(false); LockedOutput(std::cout) << "[RESOURCE] "
 
 namespace hg {
 
@@ -39,10 +54,7 @@ bool compare_case_insensitive(const std::string& a, const std::string& b) {
     });
 }
 
-static std::mutex output_mutex;
-
-template <typename T>
-void iterate_recursive_parallel(const ghc::filesystem::path& directory, const std::string& extension, T callback) {
+std::vector<ghc::filesystem::path> find_files(const ghc::filesystem::path& directory, const std::string& extension) {
     std::vector<ghc::filesystem::path> files;
     if (ghc::filesystem::exists(directory)) {
         for (const auto& directory_entry : ghc::filesystem::recursive_directory_iterator(directory)) {
@@ -54,72 +66,215 @@ void iterate_recursive_parallel(const ghc::filesystem::path& directory, const st
     } else {
         throw std::runtime_error(fmt::format("Specified directory \"{}\" doesn't exist.", directory.string()));
     }
+    return files;
+}
 
-    std::mutex files_mutex;
-    auto process_files = [&]() {
-        while (true) {
-            ghc::filesystem::path file;
-
-            {
-                std::lock_guard<std::mutex> guard(files_mutex);
-                if (files.empty()) {
-                    return;
-                }
-                file = files.back();
-                files.pop_back();
-            }
+void destroy_model_node(Model::Node& node) {
+    for (Model::Node& child_node : node.children) {
+        destroy_model_node(child_node);
+    }
+    delete node.mesh;
+}
 
-            callback(file);
+static const uint8_t RED_TEXTURE[4] = { 0xFF, 0x00, 0x00, 0xFF };
 
-            {
-                std::lock_guard<std::mutex> guard(output_mutex);
-                std::cout << "[RESOURCE] Loaded \"" << file.string() << "\"." << std::endl;
-            }
+static const char* const COLOR_ROUGHNESS_SUFFIX = "_bcr.dds";
+static const char* const NORMAL_METAL_AO_SUFFIX = "_nmao.dds";
+
+/** Model used in place of models that don't exist or are not loaded yet. It's always loaded. */
+static const char* const BLOCKOUT_MODEL = "blockout.glb";
+static const ResourceId BLOCKOUT_MODEL_ID(BLOCKOUT_MODEL);
+
+static const size_t MEGABYTE = 1024 * 1024;
+
+/** Texture file contents along with parsed image header. Used to pack material textures into texture arrays. */
+struct TextureFile final {
+    MemoryMappedFile file;
+    bimg::ImageContainer image {};
+    bool is_parsed = false;
+};
+
+/** State shared by the stages of a texture loading job. When the texture is streamed, `data` contains only its mip
+    tail starting at `tail_mip`, otherwise the whole file is memory mapped to `mapped_file`. */
+struct TextureLoad final {
+    DdsFile file;
+    std::vector<uint8_t> data;
+    std::unique_ptr<MemoryMappedFile> mapped_file;
+    uint8_t tail_mip = 0;
+    bool is_streamed = false;
+};
+
+/** State shared by the stages of a model loading job. */
+struct ModelLoad final {
+    /** The model is decoded but not uploaded when the job is discarded, so it has no GPU buffers yet. */
+    ~ModelLoad() {
+        for (Model::Node& node : model.children) {
+            destroy_model_node(node);
         }
-    };
+    }
 
-    if (!files.empty()) {
-        const size_t available_threads = std::thread::hardware_concurrency();
-        const size_t background_threads = std::max(std::min(files.size(), available_threads), size_t(1)) - 1;
+    std::string path;
+    std::string cache_path;
+    uint64_t source_size = 0;
+    int64_t source_time = 0;
 
-        std::vector<std::future<void>> futures;
-        futures.reserve(background_threads);
+    /** Source file contents, read only when the cooked model is missing or out of date. */
+    std::vector<uint8_t> source;
 
-        for (size_t i = 0; i < background_threads; i++) {
-            futures.push_back(std::async(std::launch::async, process_files));
-        }
+    /** Cooked model image, either the memory mapped cache file or a freshly cooked model. */
+    std::shared_ptr<const void> image_owner;
+    const uint8_t* image_data = nullptr;
+    size_t image_size = 0;
 
-        try {
-            process_files();
-        }
-        catch (...) {
-            // Wait until all futures are done first.
-            for (std::future<void>& future : futures) {
-                future.wait();
+    /** Model decoded from the image, its GPU buffers are created in the upload stage. */
+    Model model;
+};
+
+bool ends_with(const std::string& string, const std::string& suffix) {
+    return string.size() >= suffix.size() && string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool is_material_texture(const std::string& texture_name) {
+    return ends_with(texture_name, COLOR_ROUGHNESS_SUFFIX) || ends_with(texture_name, NORMAL_METAL_AO_SUFFIX);
+}
+
+/** Return material name of the specified material texture. */
+std::string get_material_name(const std::string& texture_name) {
+    if (ends_with(texture_name, COLOR_ROUGHNESS_SUFFIX)) {
+        return texture_name.substr(0, texture_name.size() - std::strlen(COLOR_ROUGHNESS_SUFFIX));
+    }
+    if (ends_with(texture_name, NORMAL_METAL_AO_SUFFIX)) {
+        return texture_name.substr(0, texture_name.size() - std::strlen(NORMAL_METAL_AO_SUFFIX));
+    }
+    return texture_name;
+}
+
+bool read_file(const std::string& path, std::vector<uint8_t>& result) {
+    bool is_read = false;
+    bx::FileReader file_reader;
+    if (bx::open(&file_reader, path.c_str())) {
+        result.resize(static_cast<size_t>(bx::getSize(&file_reader)));
+        is_read = bx::read(&file_reader, result.data(), static_cast<int32_t>(result.size())) == static_cast<int32_t>(result.size());
+        bx::close(&file_reader);
+    }
+    return is_read;
+}
+
+bool parse_texture_file(TextureFile& texture_file) {
+    texture_file.is_parsed = bimg::imageParse(texture_file.image, texture_file.file.get_data(), static_cast<uint32_t>(texture_file.file.get_size())) &&
+                             !texture_file.image.m_cubeMap && texture_file.image.m_depth == 1 && texture_file.image.m_numLayers == 1;
+    return texture_file.is_parsed;
+}
+
+/** Read every page of the specified memory mapped range, so that later accesses don't wait for disk. */
+void touch_pages(const uint8_t* data, size_t size) {
+    static const size_t PAGE_SIZE = 4096;
+
+    volatile uint8_t sink = 0;
+    for (size_t offset = 0; offset < size; offset += PAGE_SIZE) {
+        sink ^= data[offset];
+    }
+}
+
+static void release_mapped_file(void* /*data*/, void* user_data) {
+    delete static_cast<MemoryMappedFile*>(user_data);
+}
+
+/** Create a texture from the whole memory mapped texture file. The mapped range is passed to bgfx without a copy and
+    the file is unmapped once bgfx doesn't need it anymore. */
+Texture create_texture(std::unique_ptr<MemoryMappedFile>&& mapped_file) {
+    MemoryMappedFile* const mapped_file_ptr = mapped_file.release();
+    const bgfx::Memory* memory = bgfx::makeRef(mapped_file_ptr->get_data(), static_cast<uint32_t>(mapped_file_ptr->get_size()), release_mapped_file, mapped_file_ptr);
+
+    Texture result;
+    bgfx::TextureInfo texture_info;
+    result.handle = bgfx::createTexture(memory, BGFX_TEXTURE_NONE, 0, &texture_info);
+    if (bgfx::isValid(result.handle)) {
+        result.width = texture_info.width;
+        result.height = texture_info.height;
+        result.is_cube_map = texture_info.cubeMap;
+    }
+    return result;
+}
+
+/** Map the whole texture file and read every page, so that the upload doesn't wait for disk. Throw on failure. */
+std::unique_ptr<MemoryMappedFile> map_texture_file(const std::string& path) {
+    auto result = std::make_unique<MemoryMappedFile>();
+    if (!result->open(path)) {
+        throw std::runtime_error("Failed to map the file.");
+    }
+    touch_pages(result->get_data(), result->get_size());
+    return result;
+}
+
+/** Create a texture array from the specified texture files. All of them must have the same format, size and number
+    of mips. Layers are in the same order as files. */
+Texture create_texture_array(const std::vector<const TextureFile*>& texture_files) {
+    assert(!texture_files.empty());
+
+    const bimg::ImageContainer& image = texture_files.front()->image;
+
+    Texture result;
+    result.handle = bgfx::createTexture2D(static_cast<uint16_t>(image.m_width), static_cast<uint16_t>(image.m_height), image.m_numMips > 1,
+                                          static_cast<uint16_t>(texture_files.size()), static_cast<bgfx::TextureFormat::Enum>(image.m_format), BGFX_TEXTURE_NONE);
+    if (bgfx::isValid(result.handle)) {
+        for (size_t layer = 0; layer < texture_files.size(); layer++) {
+            const TextureFile& texture_file = *texture_files[layer];
+            for (uint8_t lod = 0; lod < image.m_numMips; lod++) {
+                bimg::ImageMip mip;
+                if (bimg::imageGetRawData(texture_file.image, 0, lod, texture_file.file.get_data(), static_cast<uint32_t>(texture_file.file.get_size()), mip)) {
+                    bgfx::updateTexture2D(result.handle, static_cast<uint16_t>(layer), lod, 0, 0, static_cast<uint16_t>(mip.m_width), static_cast<uint16_t>(mip.m_height), bgfx::copy(mip.m_data, mip.m_size));
+                }
             }
-            throw;
         }
 
-        // Wait until all futures are done.
-        for (std::future<void>& future : futures) {
-            future.wait();
-        }
+        result.width = static_cast<uint16_t>(image.m_width);
+        result.height = static_cast<uint16_t>(image.m_height);
+        result.num_layers = static_cast<uint16_t>(texture_files.size());
+    }
+    return result;
+}
 
-        // Check whether any future had thrown an exception.
-        for (std::future<void>& future : futures) {
-            future.get();
-        }
+void destroy_model(Model& model) {
+    for (Model::Node& node : model.children) {
+        destroy_model_node(node);
     }
+    model = Model();
 }
 
-void destroy_model_node(Model::Node& node) {
-    for (Model::Node& child_node : node.children) {
-        destroy_model_node(child_node);
+bool write_file(const ghc::filesystem::path& path, const std::vector<uint8_t>& data) {
+    std::error_code error_code;
+    ghc::filesystem::create_directories(path.parent_path(), error_code);
+
+    std::ofstream stream(path.string(), std::ios::binary | std::ios::trunc);
+    if (stream.is_open()) {
+        stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        return stream.good();
     }
-    delete node.mesh;
+    return false;
 }
 
-static const uint8_t RED_TEXTURE[4] = { 0xFF, 0x00, 0x00, 0xFF };
+void read_model(ModelLoad& model_load) {
+    std::error_code error_code;
+    model_load.source_size = ghc::filesystem::file_size(model_load.path, error_code);
+    model_load.source_time = ghc::filesystem::last_write_time(model_load.path, error_code).time_since_epoch().count();
+
+    // Cooked model is uploaded straight from the mapped file, so loading it is bound by disk reads only.
+    auto mapped_file = std::make_shared<MemoryMappedFile>();
+    if (mapped_file->open(model_load.cache_path) &&
+        is_cooked_model_up_to_date(mapped_file->get_data(), mapped_file->get_size(), model_load.source_size, model_load.source_time)) {
+        touch_pages(mapped_file->get_data(), mapped_file->get_size());
+
+        model_load.image_data = mapped_file->get_data();
+        model_load.image_size = mapped_file->get_size();
+        model_load.image_owner = std::move(mapped_file);
+        return;
+    }
+
+    if (!read_file(model_load.path, model_load.source)) {
+        throw std::runtime_error("Failed to read the file.");
+    }
+}
 
 } // namespace resource_system_details
 
@@ -137,66 +292,148 @@ ResourceSystem::ResourceSystem(World& world)
         , m_model_observer(entt::observer(world, entt::collector.group<ModelComponent>()))
         , m_model_update_observer(entt::observer(world, entt::collector.replace<ModelComponent>()))
         , m_material_observer(entt::observer(world, entt::collector.group<MaterialComponent>()))
-        , m_material_update_observer(entt::observer(world, entt::collector.replace<MaterialComponent>())) {
-    load_textures();
+        , m_material_update_observer(entt::observer(world, entt::collector.replace<MaterialComponent>()))
+        , m_loader(std::make_unique<ResourceLoader>()) {
+    world.ctx_or_set<ResourceLoadingSingleComponent>().m_loader = m_loader.get();
+    world.set<TextureSingleComponent>();
+    world.set<ModelSingleComponent>();
 
     try {
-        load_models();
+        // Blockout model is a placeholder for models that are not loaded yet, so it's the only one loaded synchronously.
+        load_models({ resource_system_details::BLOCKOUT_MODEL });
+        m_loader->finish();
+
+        load_textures();
+        load_presets();
+        if (!ResourceUtils::deserialize_level(world)) {
+            throw std::runtime_error("Failed to load a level.");
+        }
 
-        try {
-            load_presets();
-            if (!ResourceUtils::deserialize_level(world)) {
-                throw std::runtime_error("Failed to load a level.");
+        // Resources referenced by the level are requested first, the rest is requested on demand in `update`.
+        std::vector<std::string> models;
+        world.view<ModelComponent>().each([&](entt::entity /*entity*/, ModelComponent& model_component) {
+            if (!model_component.path.empty()) {
+                models.push_back(model_component.path);
             }
-        }
-        catch (...) {
-            auto& model_single_component = world.ctx<ModelSingleComponent>();
-            for (auto& [material_name, material_ptr] : std::exchange(model_single_component.m_models, {})) {
-                for (Model::Node& node : material_ptr->children) {
-                    resource_system_details::destroy_model_node(node);
-                }
+        });
+
+        std::vector<std::string> materials;
+        world.view<MaterialComponent>().each([&](entt::entity /*entity*/, MaterialComponent& material_component) {
+            if (!material_component.material.empty()) {
+                materials.push_back(material_component.material);
             }
+        });
 
-            throw;
-        }
+        load_models(models);
+        load_materials(materials);
     }
     catch (...) {
-        auto& texture_single_component = world.ctx<TextureSingleComponent>();
-        texture_single_component.m_textures.clear();
+        // Jobs must not be uploaded after the resources are destroyed.
+        world.ctx<ResourceLoadingSingleComponent>().m_loader = nullptr;
+        m_loader.reset();
+
+        unload_models();
+        unload_textures();
 
         throw;
     }
 }
 
 ResourceSystem::~ResourceSystem() {
+    world.ctx<ResourceLoadingSingleComponent>().m_loader = nullptr;
+    m_loader.reset();
+
+    unload_textures();
+
     auto& texture_single_component = world.ctx<TextureSingleComponent>();
-    texture_single_component.m_textures.clear();
     texture_single_component.m_default_texture.~Texture();
     texture_single_component.m_default_texture = Texture();
 
-    auto& model_single_component = world.ctx<ModelSingleComponent>();
-    for (auto& [material_name, material_ptr] : std::exchange(model_single_component.m_models, {})) {
-        for (Model::Node& node : material_ptr->children) {
-            resource_system_details::destroy_model_node(node);
-        }
-    }
+    unload_models();
 }
 
 void ResourceSystem::update(float /*elapsed_time*/) {
+    using namespace resource_system_details;
+
     auto& model_single_component = world.ctx<ModelSingleComponent>();
+    auto& texture_single_component = world.ctx<TextureSingleComponent>();
+    auto& resource_loading_single_component = world.ctx<ResourceLoadingSingleComponent>();
+
+    // Loaded resources are published at the beginning of a frame within the upload budget.
+    m_loader->upload(static_cast<size_t>(resource_loading_single_component.upload_budget) * MEGABYTE);
+
+    // Components that reference published resources are assigned again below.
+    if (!m_published_models.empty()) {
+        world.view<ModelComponent>().each([&](entt::entity entity, ModelComponent& model_component) {
+            if (m_published_models.count(model_component.path) != 0) {
+                world.notify<ModelComponent>(entity);
+            }
+        });
+        m_published_models.clear();
+    }
+
+    if (!m_published_materials.empty()) {
+        world.view<MaterialComponent>().each([&](entt::entity entity, MaterialComponent& material_component) {
+            if (m_published_materials.count(material_component.material) != 0) {
+                world.notify<MaterialComponent>(entity);
+            }
+        });
+        m_published_materials.clear();
+    }
+
+    // Request resources referenced by new or modified components.
+    std::vector<std::string> models;
+    auto collect_model = [&](const entt::entity entity) {
+        auto& model_component = world.get<ModelComponent>(entity);
+        if (!model_component.path.empty() && model_single_component.get(ResourceId(model_component.path)) == nullptr) {
+            models.push_back(model_component.path);
+        }
+    };
+
+    std::for_each(m_model_observer.begin(), m_model_observer.end(), collect_model);
+    std::for_each(m_model_update_observer.begin(), m_model_update_observer.end(), collect_model);
+
+    std::vector<std::string> materials;
+    auto collect_material = [&](const entt::entity entity) {
+        auto& material_component = world.get<MaterialComponent>(entity);
+        if (!material_component.material.empty() && texture_single_component.get_if(ResourceId(material_component.material, COLOR_ROUGHNESS_SUFFIX)) == nullptr) {
+            materials.push_back(material_component.material);
+        }
+    };
+
+    std::for_each(m_material_observer.begin(), m_material_observer.end(), collect_material);
+    std::for_each(m_material_update_observer.begin(), m_material_update_observer.end(), collect_material);
+
+    if (!models.empty()) {
+        load_models(models);
+    }
+
+    if (!materials.empty()) {
+        load_materials(materials);
+    }
+
+    resource_loading_single_component.m_num_pending_loads = m_loader->get_num_pending_jobs();
+
+    // Idle editor must keep producing frames until everything is published.
+    if (resource_loading_single_component.m_num_pending_loads > 0) {
+        world.ctx<FramePacingSingleComponent>().wake_up();
+    }
 
     auto model_updated = [&](const entt::entity entity) {
         auto& model_component = world.get<ModelComponent>(entity);
         if (!model_component.path.empty()) {
-            const Model* original_model = model_single_component.get(model_component.path);
+            const Model* original_model = model_single_component.get(ResourceId(model_component.path));
             if (original_model != nullptr) {
                 model_component.model = *original_model;
             } else {
-                const Model* blockout_model = model_single_component.get("blockout.glb");
+                const Model* blockout_model = model_single_component.get(BLOCKOUT_MODEL_ID);
                 assert(blockout_model != nullptr);
 
                 if (blockout_model != nullptr) {
-                    model_component.path = "blockout.glb";
+                    // Models that are being loaded keep their path, so they're assigned when they're published.
+                    if (m_pending_models.count(model_component.path) == 0) {
+                        model_component.path = BLOCKOUT_MODEL;
+                    }
                     model_component.model = *blockout_model;
                 }
             }
@@ -206,16 +443,17 @@ void ResourceSystem::update(float /*elapsed_time*/) {
     m_model_observer.each(model_updated);
     m_model_update_observer.each(model_updated);
 
-    auto& texture_single_component = world.ctx<TextureSingleComponent>();
-
     auto material_updated = [&](const entt::entity entity) {
         auto& material_component = world.get<MaterialComponent>(entity);
         if (!material_component.material.empty()) {
-            material_component.color_roughness = &texture_single_component.get(material_component.material + "_bcr.dds");
-            material_component.normal_metal_ao = &texture_single_component.get(material_component.material + "_nmao.dds");
+            const ResourceId color_roughness_id(material_component.material, COLOR_ROUGHNESS_SUFFIX);
+            material_component.color_roughness = &texture_single_component.get(color_roughness_id);
+            material_component.normal_metal_ao = &texture_single_component.get(ResourceId(material_component.material, NORMAL_METAL_AO_SUFFIX));
+            material_component.layer = texture_single_component.get_layer(color_roughness_id);
         } else {
             material_component.color_roughness = nullptr;
             material_component.normal_metal_ao = nullptr;
+            material_component.layer = 0;
         }
     };
 
@@ -223,26 +461,13 @@ void ResourceSystem::update(float /*elapsed_time*/) {
     m_material_update_observer.each(material_updated);
 }
 
-void ResourceSystem::load_textures() const {
-    auto& texture_single_component = world.set<TextureSingleComponent>();
-    std::mutex texture_single_component_mutex;
+void ResourceSystem::load_textures() {
+    using namespace resource_system_details;
 
-    const ghc::filesystem::path directory = ghc::filesystem::path(ResourceUtils::get_resource_directory()) / "textures";
-    resource_system_details::iterate_recursive_parallel(directory, ".dds", [&](const ghc::filesystem::path& file) {
-        Texture texture = load_texture(file.string());
-        if (bgfx::isValid(texture.handle)) {
-            std::lock_guard<std::mutex> guard(texture_single_component_mutex);
-            const std::string texture_name = file.lexically_relative(directory).lexically_normal().string();
-            bgfx::setName(texture.handle, texture_name.c_str());
-            texture_single_component.m_textures.emplace(texture_name, std::move(texture));
-        } else {
-            std::lock_guard<std::mutex> guard(resource_system_details::output_mutex);
-            std::cerr << "[RESOURCE] Failed to load texture \"" << file.string() << "\"." << std::endl;
-        }
-    });
+    auto& texture_single_component = world.ctx<TextureSingleComponent>();
 
-    // Red square texture used as a fallback texture.
-    const bgfx::Memory* memory = bgfx::makeRef(resource_system_details::RED_TEXTURE, static_cast<uint32_t>(std::size(resource_system_details::RED_TEXTURE)));
+    // Red square texture used as a fallback texture and as a placeholder for textures that are not loaded yet.
+    const bgfx::Memory* memory = bgfx::makeRef(RED_TEXTURE, static_cast<uint32_t>(std::size(RED_TEXTURE)));
     texture_single_component.m_default_texture.handle = bgfx::createTexture2D(1, 1, false, 1, bgfx::TextureFormat::RGBA8, BGFX_TEXTURE_NONE, memory);
     texture_single_component.m_default_texture.width = 1;
     texture_single_component.m_default_texture.height = 1;
@@ -251,51 +476,346 @@ void ResourceSystem::load_textures() const {
     if (!bgfx::isValid(texture_single_component.m_default_texture.handle)) {
         throw std::runtime_error("Failed to create a fallback texture!");
     }
+
+    // Material textures are loaded only when a level or a component references them, see `load_materials`.
+    const ghc::filesystem::path directory = ghc::filesystem::path(ResourceUtils::get_resource_directory()) / "textures";
+    for (const ghc::filesystem::path& file : find_files(directory, ".dds")) {
+        const std::string texture_name = file.lexically_relative(directory).lexically_normal().string();
+        if (!is_material_texture(texture_name)) {
+            load_texture(texture_name, file.string(), false);
+        }
+    }
 }
 
-Texture ResourceSystem::load_texture(const std::string &path) const {
-    Texture result;
-    bx::FileReader file_reader;
-    if (bx::open(&file_reader, path.c_str())) {
-        const bgfx::Memory* const memory = bgfx::alloc(static_cast<uint32_t>(bx::getSize(&file_reader)));
-        if (bx::read(&file_reader, memory->data, static_cast<int32_t>(memory->size)) == static_cast<int32_t>(memory->size)) {
-            bgfx::TextureInfo texture_info;
-            result.handle = bgfx::createTexture(memory, BGFX_TEXTURE_NONE, 0, &texture_info);
-            if (bgfx::isValid(result.handle)) {
-                result.width = texture_info.width;
-                result.height = texture_info.height;
-                result.is_cube_map = texture_info.cubeMap;
+void ResourceSystem::load_texture(const std::string& texture_name, const std::string& path, bool is_streaming_enabled) {
+    using namespace resource_system_details;
+
+    // Only mip tails of streamed textures are loaded, the rest is streamed by `TextureStreamingSystem`.
+    const auto* texture_streaming_single_component = world.try_ctx<TextureStreamingSingleComponent>();
+    const uint32_t max_tail_size = texture_streaming_single_component != nullptr ? texture_streaming_single_component->max_tail_size : 0;
+
+    auto texture_load = std::make_shared<TextureLoad>();
+
+    ResourceLoader::Job job;
+    job.name = path;
+    job.read = [texture_load, path, is_streaming_enabled, max_tail_size]() {
+        if (is_streaming_enabled && texture_load->file.open(path)) {
+            DdsFile& file = texture_load->file;
+            while (uint32_t(texture_load->tail_mip) + 1 < uint32_t(file.num_mips) &&
+                   std::max(uint32_t(file.width) >> texture_load->tail_mip, uint32_t(file.height) >> texture_load->tail_mip) > max_tail_size) {
+                texture_load->tail_mip++;
+            }
+
+            texture_load->data = file.read(texture_load->tail_mip);
+            if (!texture_load->data.empty()) {
+                texture_load->is_streamed = true;
+                return;
+            }
+        }
+
+        // Textures that can't be streamed are loaded with all mips.
+        texture_load->mapped_file = map_texture_file(path);
+    };
+    job.decode = [texture_load]() {
+        if (texture_load->is_streamed) {
+            return texture_load->data.size();
+        }
+
+        // The header is parsed in place, so unsupported files are rejected before they reach bgfx.
+        bimg::ImageContainer image {};
+        if (!bimg::imageParse(image, texture_load->mapped_file->get_data(), static_cast<uint32_t>(texture_load->mapped_file->get_size()))) {
+            throw std::runtime_error("Unsupported texture file.");
+        }
+        return texture_load->mapped_file->get_size();
+    };
+    job.upload = [this, texture_load, texture_name]() {
+        if (!texture_load->is_streamed) {
+            publish_texture(texture_name, create_texture(std::move(texture_load->mapped_file)));
+            return;
+        }
+
+        const uint32_t size = texture_load->file.get_size(texture_load->tail_mip);
+
+        Texture* texture = publish_texture(texture_name, texture_load->file.create(texture_load->tail_mip, std::move(texture_load->data)));
+        if (auto* texture_streaming_single_component = world.try_ctx<TextureStreamingSingleComponent>(); texture != nullptr && texture_streaming_single_component != nullptr) {
+            TextureStreamingSingleComponent::StreamedTexture& streamed_texture = texture_streaming_single_component->m_textures.emplace_back();
+            streamed_texture.texture       = texture;
+            streamed_texture.name          = texture_name;
+            streamed_texture.tail_mip      = texture_load->tail_mip;
+            streamed_texture.resident_mip  = texture_load->tail_mip;
+            streamed_texture.requested_mip = texture_load->tail_mip;
+            streamed_texture.file          = std::move(texture_load->file);
+
+            texture_streaming_single_component->m_texture_indices.emplace(texture, texture_streaming_single_component->m_textures.size() - 1);
+            texture_streaming_single_component->m_memory += size;
+        }
+    };
+
+    m_loader->push(std::move(job));
+}
+
+void ResourceSystem::load_materials(const std::vector<std::string>& materials) {
+    using namespace resource_system_details;
+
+    const auto* render_single_component = world.try_ctx<RenderSingleComponent>();
+    const bool is_texture_array_enabled = render_single_component != nullptr && render_single_component->is_texture_array_enabled &&
+                                          (bgfx::getCaps()->supported & BGFX_CAPS_TEXTURE_2D_ARRAY) != 0;
+
+    const auto* texture_streaming_single_component = world.try_ctx<TextureStreamingSingleComponent>();
+    const bool is_texture_streaming_enabled = !is_texture_array_enabled && texture_streaming_single_component != nullptr && texture_streaming_single_component->is_enabled;
+
+    // Materials are requested once, so the ones without textures are not looked up every frame.
+    const ghc::filesystem::path directory = ghc::filesystem::path(ResourceUtils::get_resource_directory()) / "textures";
+    std::vector<std::pair<std::string, std::string>> files;
+    for (const std::string& material : materials) {
+        if (m_requested_materials.insert(material).second) {
+            for (const char* const suffix : { COLOR_ROUGHNESS_SUFFIX, NORMAL_METAL_AO_SUFFIX }) {
+                const ghc::filesystem::path file = directory / (material + suffix);
+                if (ghc::filesystem::exists(file)) {
+                    files.emplace_back(material + suffix, file.string());
+                }
             }
         }
-        bx::close(&file_reader);
     }
-    return result;
+
+    if (is_texture_array_enabled) {
+        if (!files.empty()) {
+            load_texture_arrays(std::move(files));
+        }
+    } else {
+        for (const auto& [texture_name, path] : files) {
+            load_texture(texture_name, path, is_texture_streaming_enabled);
+        }
+    }
 }
 
-void ResourceSystem::load_models() const  {
-    auto& model_single_component = world.set<ModelSingleComponent>();
-    std::mutex model_single_component_mutex;
+void ResourceSystem::load_texture_arrays(std::vector<std::pair<std::string, std::string>>&& files) {
+    using namespace resource_system_details;
+
+    // Material textures are packed after all of them are read, so they're loaded by a single job.
+    auto texture_files = std::make_shared<std::unordered_map<std::string, TextureFile>>();
+
+    ResourceLoader::Job job;
+    job.name = fmt::format("{} material textures", files.size());
+    job.read = [texture_files, files = std::move(files)]() {
+        for (const auto& [texture_name, path] : files) {
+            TextureFile texture_file;
+            if (texture_file.file.open(path)) {
+                touch_pages(texture_file.file.get_data(), texture_file.file.get_size());
+                texture_files->emplace(texture_name, std::move(texture_file));
+            } else {
+                LockedOutput(std::cerr) << "[RESOURCE] Failed to map texture \"" << path << "\"." << std::endl;
+            }
+        }
+    };
+    job.decode = [texture_files]() {
+        size_t size = 0;
+        for (auto& [texture_name, texture_file] : *texture_files) {
+            parse_texture_file(texture_file);
+            size += texture_file.file.get_size();
+        }
+        return size;
+    };
+    job.upload = [this, texture_files]() {
+        auto& texture_single_component = world.ctx<TextureSingleComponent>();
+
+        // Materials whose both textures have the same format, size and number of mips share texture arrays.
+        using MaterialKey = std::tuple<bimg::TextureFormat::Enum, uint32_t, uint32_t, uint8_t, bimg::TextureFormat::Enum, uint32_t, uint32_t, uint8_t>;
+        std::map<MaterialKey, std::vector<std::string>> material_groups;
+
+        for (const auto& [texture_name, color_roughness_file] : *texture_files) {
+            if (ends_with(texture_name, COLOR_ROUGHNESS_SUFFIX) && color_roughness_file.is_parsed) {
+                const std::string material = get_material_name(texture_name);
+                if (auto normal_metal_ao_file = texture_files->find(material + NORMAL_METAL_AO_SUFFIX); normal_metal_ao_file != texture_files->end() && normal_metal_ao_file->second.is_parsed) {
+                    const bimg::ImageContainer& color_roughness = color_roughness_file.image;
+                    const bimg::ImageContainer& normal_metal_ao = normal_metal_ao_file->second.image;
+                    const MaterialKey key(color_roughness.m_format, color_roughness.m_width, color_roughness.m_height, color_roughness.m_numMips,
+                                          normal_metal_ao.m_format, normal_metal_ao.m_width, normal_metal_ao.m_height, normal_metal_ao.m_numMips);
+                    material_groups[key].push_back(material);
+                }
+            }
+        }
+
+        const size_t max_layers = std::max(static_cast<size_t>(bgfx::getCaps()->limits.maxTextureLayers), size_t(2));
+
+        for (auto& [key, materials] : material_groups) {
+            // Texture array with a single layer is created as a regular texture.
+            if (materials.size() < 2) {
+                continue;
+            }
+
+            // Keep layers independent of file system iteration order.
+            std::sort(materials.begin(), materials.end());
+
+            for (size_t first = 0; first + 1 < materials.size(); first += max_layers) {
+                const size_t last = std::min(first + max_layers, materials.size());
+
+                std::vector<const TextureFile*> color_roughness_files;
+                std::vector<const TextureFile*> normal_metal_ao_files;
+                for (size_t i = first; i < last; i++) {
+                    color_roughness_files.push_back(&(*texture_files)[materials[i] + COLOR_ROUGHNESS_SUFFIX]);
+                    normal_metal_ao_files.push_back(&(*texture_files)[materials[i] + NORMAL_METAL_AO_SUFFIX]);
+                }
+
+                Texture& color_roughness = texture_single_component.m_texture_arrays.emplace_back(create_texture_array(color_roughness_files));
+                Texture& normal_metal_ao = texture_single_component.m_texture_arrays.emplace_back(create_texture_array(normal_metal_ao_files));
+                if (!bgfx::isValid(color_roughness.handle) || !bgfx::isValid(normal_metal_ao.handle)) {
+                    continue;
+                }
+
+                for (size_t i = first; i < last; i++) {
+                    const auto layer = static_cast<uint16_t>(i - first);
+                    texture_single_component.m_texture_layers.emplace(ResourceId(materials[i], COLOR_ROUGHNESS_SUFFIX), TextureSingleComponent::TextureLayer { &color_roughness, layer });
+                    texture_single_component.m_texture_layers.emplace(ResourceId(materials[i], NORMAL_METAL_AO_SUFFIX), TextureSingleComponent::TextureLayer { &normal_metal_ao, layer });
 
+                    texture_files->erase(materials[i] + COLOR_ROUGHNESS_SUFFIX);
+                    texture_files->erase(materials[i] + NORMAL_METAL_AO_SUFFIX);
+
+                    m_published_materials.insert(materials[i]);
+                }
+
+                LockedOutput(std::cout) << "[RESOURCE] Packed " << (last - first) << " materials into texture arrays." << std::endl;
+            }
+        }
+
+        // Material textures that were not packed are loaded as usual.
+        for (auto& [texture_name, texture_file] : *texture_files) {
+            publish_texture(texture_name, create_texture(std::make_unique<MemoryMappedFile>(std::move(texture_file.file))));
+        }
+    };
+
+    m_loader->push(std::move(job));
+}
+
+Texture* ResourceSystem::publish_texture(const std::string& texture_name, Texture&& texture) {
+    using namespace resource_system_details;
+
+    if (!bgfx::isValid(texture.handle)) {
+        LockedOutput(std::cerr) << "[RESOURCE] Failed to load texture \"" << texture_name << "\"." << std::endl;
+        return nullptr;
+    }
+
+    bgfx::setName(texture.handle, texture_name.c_str());
+
+    if (is_material_texture(texture_name)) {
+        m_published_materials.insert(get_material_name(texture_name));
+    }
+
+    auto& texture_single_component = world.ctx<TextureSingleComponent>();
+    return &texture_single_component.m_textures.emplace(ResourceId(texture_name), std::move(texture)).first->second;
+}
+
+void ResourceSystem::unload_textures() const {
+    // Pending loads must be finished before streamed textures are destroyed.
+    if (auto* texture_streaming_single_component = world.try_ctx<TextureStreamingSingleComponent>(); texture_streaming_single_component != nullptr) {
+        texture_streaming_single_component->m_pending_loads.clear();
+        texture_streaming_single_component->m_textures.clear();
+        texture_streaming_single_component->m_texture_indices.clear();
+        texture_streaming_single_component->m_memory = 0;
+    }
+
+    auto& texture_single_component = world.ctx<TextureSingleComponent>();
+    texture_single_component.m_textures.clear();
+    texture_single_component.m_texture_layers.clear();
+    texture_single_component.m_texture_arrays.clear();
+}
+
+void ResourceSystem::load_models(const std::vector<std::string>& models) {
+    using namespace resource_system_details;
+
+    // Models are requested once, so missing models are not looked up every frame.
     const ghc::filesystem::path directory = ghc::filesystem::path(ResourceUtils::get_resource_directory()) / "models";
-    resource_system_details::iterate_recursive_parallel(directory, ".glb", [&](const ghc::filesystem::path& file) {
-        std::unique_ptr<Model> model = std::make_unique<Model>();
-        const std::string name = file.lexically_relative(directory).lexically_normal().string();
+    const ghc::filesystem::path cache_directory = ghc::filesystem::path(ResourceUtils::get_resource_directory()) / "cache" / "models";
+    for (const std::string& model : models) {
+        if (!m_requested_models.insert(model).second) {
+            continue;
+        }
 
-        load_model(*model, file.string());
+        const ghc::filesystem::path file = directory / model;
+        if (!ghc::filesystem::exists(file)) {
+            continue;
+        }
 
-        std::lock_guard<std::mutex> guard(model_single_component_mutex);
-        model_single_component.m_models.emplace(name, std::move(model));
-    });
+        auto model_load = std::make_shared<ModelLoad>();
+        model_load->path = file.string();
+        model_load->cache_path = (cache_directory / (model + ".cooked")).string();
+
+        ResourceLoader::Job job;
+        job.name = model_load->path;
+        job.read = [model_load]() {
+            read_model(*model_load);
+        };
+        job.decode = [this, model_load]() {
+            if (model_load->image_data == nullptr) {
+                Model imported_model;
+                try {
+                    import_model(imported_model, model_load->source, model_load->path);
+                }
+                catch (...) {
+                    destroy_model(imported_model);
+                    throw;
+                }
+
+                auto cooked_model = std::make_shared<std::vector<uint8_t>>(cook_model(imported_model, model_load->source_size, model_load->source_time));
+                destroy_model(imported_model);
+                model_load->source = {};
+
+                if (!write_file(model_load->cache_path, *cooked_model)) {
+                    LockedOutput(std::cout) << "[RESOURCE] Failed to write cooked model \"" << model_load->cache_path << "\"." << std::endl;
+                }
+
+                model_load->image_data = cooked_model->data();
+                model_load->image_size = cooked_model->size();
+                model_load->image_owner = std::move(cooked_model);
+            }
+
+            // Validation and CPU copy extraction happen here, so the upload stage only creates GPU buffers.
+            if (!decode_cooked_model(model_load->model, model_load->image_data, model_load->image_size)) {
+                destroy_model(model_load->model);
+
+                // The cache is removed, so the model is cooked again next time.
+                std::error_code error_code;
+                ghc::filesystem::remove(model_load->cache_path, error_code);
+                throw std::runtime_error(fmt::format("Cooked model \"{}\" is corrupted.", model_load->cache_path));
+            }
+            return model_load->image_size;
+        };
+        job.upload = [this, model_load, model]() {
+            auto result = std::make_unique<Model>(std::exchange(model_load->model, Model()));
+            upload_cooked_model(*result, model_load->image_data, model_load->image_owner);
+            world.ctx<ModelSingleComponent>().m_models.emplace(ResourceId(model), std::move(result));
+
+            m_pending_models.erase(model);
+            m_published_models.insert(model);
+        };
+        job.fail = [this, model]() {
+            m_pending_models.erase(model);
+            m_published_models.insert(model);
+        };
+
+        m_pending_models.insert(model);
+        m_loader->push(std::move(job));
+    }
+}
+
+void ResourceSystem::unload_models() const {
+    auto& model_single_component = world.ctx<ModelSingleComponent>();
+    for (auto& [model_name, model_ptr] : std::exchange(model_single_component.m_models, {})) {
+        for (Model::Node& node : model_ptr->children) {
+            resource_system_details::destroy_model_node(node);
+        }
+    }
 }
 
-void ResourceSystem::load_model(Model& result, const std::string &path) const {
+void ResourceSystem::import_model(Model& result, const std::vector<uint8_t>& data, const std::string &path) const {
     try {
         tinygltf::TinyGLTF loader;
         tinygltf::Model model;
         std::string error, warning;
-        if (loader.LoadBinaryFromFile(&model, &error, &warning, path)) {
+        const std::string base_directory = ghc::filesystem::path(path).parent_path().string();
+        if (loader.LoadBinaryFromMemory(&model, &error, &warning, data.data(), static_cast<unsigned int>(data.size()), base_directory)) {
             if (!warning.empty()) {
-                std::cerr << "glTF warning: " << warning << std::endl;
+                LockedOutput(std::cerr) << "glTF warning: " << warning << std::endl;
             }
 
             const int scene_to_display = model.defaultScene > -1 ? model.defaultScene : 0;
@@ -385,7 +905,6 @@ void ResourceSystem::load_model_mesh(const glm::mat4& parent_transform, Model::M
 
 void ResourceSystem::load_model_primitive(const glm::mat4& parent_transform, Model::Primitive& result, Model::AABB& bounds, const tinygltf::Model &model, const tinygltf::Primitive& primitive) const {
     size_t num_vertices = 0;
-    const bgfx::Memory* vertex_memory = nullptr;
     Model::BasicModelVertex* vertex_data = nullptr;
 
     int32_t attributes = 0;
@@ -416,12 +935,12 @@ void ResourceSystem::load_model_primitive(const glm::mat4& parent_transform, Mod
 
         const uint8_t* const buffer_data = buffer.data.data() + accessor.byteOffset + buffer_view.byteOffset;
 
-        if (vertex_memory == nullptr) {
-            assert(num_vertices == 0 && vertex_data == nullptr);
+        if (vertex_data == nullptr) {
+            assert(num_vertices == 0);
 
             num_vertices = accessor.count;
-            vertex_memory = bgfx::alloc(static_cast<uint32_t>(num_vertices * sizeof(Model::BasicModelVertex)));
-            vertex_data = reinterpret_cast<Model::BasicModelVertex*>(vertex_memory->data);
+            result.vertices.resize(num_vertices);
+            vertex_data = result.vertices.data();
         }
 
         if (attribute == "POSITION") {
@@ -564,9 +1083,6 @@ void ResourceSystem::load_model_primitive(const glm::mat4& parent_transform, Mod
         throw std::runtime_error(fmt::format("Missing attributes: {}", missing_attributes));
     }
 
-    result.vertex_buffer = bgfx::createVertexBuffer(vertex_memory, Model::BasicModelVertex::DECLARATION);
-    result.num_vertices = num_vertices;
-
     if (primitive.indices < 0 || primitive.indices >= model.accessors.size()) {
         throw std::runtime_error("Invalid index accessor.");
     }
@@ -591,26 +1107,25 @@ void ResourceSystem::load_model_primitive(const glm::mat4& parent_transform, Mod
     }
 
     result.num_indices = accessor.count;
+    result.indices.resize(accessor.count);
 
     const uint8_t* const buffer_data = buffer.data.data() + buffer_view.byteOffset;
     if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_BYTE) {
         if ((buffer_view.byteStride == 0 || buffer_view.byteStride == sizeof(uint8_t)) &&
             buffer_view.byteLength == accessor.count) {
-            const bgfx::Memory* memory = bgfx::alloc(static_cast<uint32_t>(accessor.count * sizeof(uint16_t)));
-
-            auto* target_data = reinterpret_cast<uint16_t*>(memory->data);
             for (size_t i = 0; i < accessor.count; i++) {
-                target_data[i] = uint16_t(buffer_data[i]);
+                result.indices[i] = uint32_t(buffer_data[i]);
             }
-
-            result.index_buffer = bgfx::createIndexBuffer(memory);
         } else {
             throw std::runtime_error("Invalid BYTE index accessor.");
         }
     } else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
+        const auto* source_data = reinterpret_cast<const uint16_t*>(buffer_data);
         if ((buffer_view.byteStride == 0 || buffer_view.byteStride == sizeof(uint16_t)) &&
             buffer_view.byteLength == accessor.count * sizeof(uint16_t)) {
-            result.index_buffer = bgfx::createIndexBuffer(bgfx::copy(buffer_data, static_cast<uint32_t>(buffer_view.byteLength)));
+            for (size_t i = 0; i < accessor.count; i++) {
+                result.indices[i] = uint32_t(source_data[i]);
+            }
         } else {
             throw std::runtime_error("Invalid SHORT index accessor.");
         }
@@ -618,76 +1133,93 @@ void ResourceSystem::load_model_primitive(const glm::mat4& parent_transform, Mod
         const auto* source_data = reinterpret_cast<const uint32_t*>(buffer_data);
         if ((buffer_view.byteStride == 0 || buffer_view.byteStride == sizeof(uint32_t)) &&
             buffer_view.byteLength == accessor.count * sizeof(uint32_t)) {
-            const bgfx::Memory* memory = bgfx::alloc(static_cast<uint32_t>(accessor.count * sizeof(uint16_t)));
-
-            auto* target_data = reinterpret_cast<uint16_t*>(memory->data);
-            for (size_t i = 0; i < accessor.count; i++) {
-                target_data[i] = uint16_t(source_data[i]);
-            }
-
-            result.index_buffer = bgfx::createIndexBuffer(memory);
+            std::copy(source_data, source_data + accessor.count, result.indices.begin());
         } else {
             throw std::runtime_error("Invalid INT index accessor.");
         }
     } else {
         throw std::runtime_error("Invalid index accessor.");
     }
+
+    for (const uint32_t index : result.indices) {
+        if (index >= num_vertices) {
+            throw std::runtime_error("Index is out of bounds.");
+        }
+    }
+
+    if (result.indices.size() % 3 != 0) {
+        throw std::runtime_error("Invalid number of indices.");
+    }
+
+    result.num_vertices = num_vertices;
 }
 
-void ResourceSystem::load_presets() const {
-    if (auto* editor_preset_single_component = world.try_ctx<EditorPresetSingleComponent>(); editor_preset_single_component != nullptr) {
-        std::mutex preset_single_component_mutex;
+void ResourceSystem::load_presets() {
+    using namespace resource_system_details;
 
+    if (world.try_ctx<EditorPresetSingleComponent>() != nullptr) {
         const ghc::filesystem::path directory = ghc::filesystem::path(ResourceUtils::get_resource_directory()) / "presets";
-        resource_system_details::iterate_recursive_parallel(directory, ".yaml", [&](const ghc::filesystem::path& file) {
-            std::vector<entt::meta_any> preset;
+        for (const ghc::filesystem::path& file : find_files(directory, ".yaml")) {
             const std::string name = file.lexically_relative(directory).lexically_normal().string();
+            const std::string path = file.string();
 
-            load_preset(preset, file.string());
+            auto data = std::make_shared<std::vector<uint8_t>>();
+            auto preset = std::make_shared<std::vector<entt::meta_any>>();
 
-            std::lock_guard<std::mutex> guard(preset_single_component_mutex);
-            editor_preset_single_component->presets.emplace(name, std::move(preset));
-        });
+            ResourceLoader::Job job;
+            job.name = path;
+            job.read = [data, path]() {
+                if (!read_file(path, *data)) {
+                    throw std::runtime_error("Failed to read the file.");
+                }
+            };
+            job.decode = [this, data, preset, path]() {
+                load_preset(*preset, std::string(data->begin(), data->end()), path);
+                return size_t(0);
+            };
+            job.upload = [this, preset, name]() {
+                if (auto* editor_preset_single_component = world.try_ctx<EditorPresetSingleComponent>(); editor_preset_single_component != nullptr) {
+                    editor_preset_single_component->presets.emplace(name, std::move(*preset));
+                }
+            };
+
+            m_loader->push(std::move(job));
+        }
     }
 }
 
-void ResourceSystem::load_preset(std::vector<entt::meta_any>& result, const std::string &path) const {
-    std::ifstream stream(path);
-    if (stream.is_open()) {
-        YAML::Node node = YAML::Load(stream);
-        if (node.IsMap()) {
-            for (YAML::const_iterator component_it = node.begin(); component_it != node.end(); ++component_it) {
-                const auto component_name = component_it->first.as<std::string>("");
-                assert(!component_name.empty());
-
-                if (component_it->second.IsMap()) {
-                    const entt::meta_type component_type = entt::resolve(entt::hashed_string(component_name.c_str()));
-                    if (component_type) {
-                        if (ComponentManager::is_registered(component_type)) {
-                            if (ComponentManager::is_editable(component_type)) {
-                                entt::meta_any component = ComponentManager::construct(component_type);
-                                assert(component && "Failed to construct editable component.");
-
-                                ResourceUtils::deserialize_structure_property(component, component_it->second);
-                                result.push_back(std::move(component));
-                            } else {
-                                RESOURCE_WARNING << "Preset component \"" << component_name << "\" is not editable." << std::endl;
-                            }
+void ResourceSystem::load_preset(std::vector<entt::meta_any>& result, const std::string& contents, const std::string &path) const {
+    YAML::Node node = YAML::Load(contents);
+    if (node.IsMap()) {
+        for (YAML::const_iterator component_it = node.begin(); component_it != node.end(); ++component_it) {
+            const auto component_name = component_it->first.as<std::string>("");
+            assert(!component_name.empty());
+
+            if (component_it->second.IsMap()) {
+                const entt::meta_type component_type = entt::resolve(entt::hashed_string(component_name.c_str()));
+                if (component_type) {
+                    if (ComponentManager::is_registered(component_type)) {
+                        if (ComponentManager::is_editable(component_type)) {
+                            entt::meta_any component = ComponentManager::construct(component_type);
+                            assert(component && "Failed to construct editable component.");
+
+                            ResourceUtils::deserialize_structure_property(component, component_it->second);
+                            result.push_back(std::move(component));
                         } else {
-                            RESOURCE_WARNING << "Preset component \"" << component_name << "\" is not registered." << std::endl;
+                            RESOURCE_WARNING << "Preset component \"" << component_name << "\" is not editable." << std::endl;
                         }
                     } else {
-                        RESOURCE_WARNING << "Unknown preset component \"" << component_name << "\" is specified." << std::endl;
+                        RESOURCE_WARNING << "Preset component \"" << component_name << "\" is not registered." << std::endl;
                     }
                 } else {
-                    RESOURCE_WARNING << "Corrupted preset component \"" << component_name << "\" is specified." << std::endl;
+                    RESOURCE_WARNING << "Unknown preset component \"" << component_name << "\" is specified." << std::endl;
                 }
+            } else {
+                RESOURCE_WARNING << "Corrupted preset component \"" << component_name << "\" is specified." << std::endl;
             }
-        } else {
-            RESOURCE_WARNING << "Corrupted preset \"" << path << "\" is specified." << std::endl;
         }
     } else {
-        RESOURCE_WARNING << "Failed to open preset \"" << path << "\"." << std::endl;
+        RESOURCE_WARNING << "Corrupted preset \"" << path << "\" is specified." << std::endl;
     }
 }
 
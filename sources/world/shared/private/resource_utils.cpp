@@ -1,17 +1,30 @@
+#include "core/base/locked_output.h"
+#include "core/base/memory_mapped_file.h"
+#include "core/base/worker_pool.h"
 #include "core/ecs/world.h"
+#include "core/meta/serialization_plan.h"
+#include "world/shared/cooked_level.h"
 #include "world/shared/level_single_component.h"
 #include "world/shared/name_component.h"
 #include "world/shared/name_single_component.h"
 #include "world/shared/resource_utils.h"
 
 #include <SDL2/SDL_filesystem.h>
+#include <deque>
 #include <entt/meta/factory.hpp>
 #include <fmt/format.h>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <ghc/filesystem.hpp>
 #include <iostream>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+#include <yaml-cpp/eventhandler.h>
 #include <yaml-cpp/yaml.h>
 
-#define RESOURCE_WARNING assert(false); std::cout << "[RESOURCE] "
+#define RESOURCE_WARNING assert(false); LockedOutput(std::cout) << "[RESOURCE] "
 
 namespace hg {
 
@@ -31,6 +44,472 @@ const std::vector<entt::meta_type> REGISTERED_TYPES = {
         TYPE_STRING,
 };
 
+bool write_file(const ghc::filesystem::path& path, const std::vector<uint8_t>& data) {
+    std::error_code error_code;
+    ghc::filesystem::create_directories(path.parent_path(), error_code);
+
+    std::ofstream stream(path.string(), std::ios::binary | std::ios::trunc);
+    if (stream.is_open()) {
+        stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        return stream.good();
+    }
+    return false;
+}
+
+void serialize_scalar(const SerializationPlan::Property& property, const entt::meta_handle structure, YAML::Node& node) {
+    const entt::meta_any value = property.data.get(structure);
+    assert(value);
+
+    switch (property.kind) {
+        case SerializationPlan::Kind::INT:
+            node = value.cast<int32_t>();
+            break;
+        case SerializationPlan::Kind::UINT:
+            node = value.cast<uint32_t>();
+            break;
+        case SerializationPlan::Kind::FLOAT:
+            node = value.cast<float>();
+            break;
+        case SerializationPlan::Kind::BOOL:
+            node = value.cast<bool>();
+            break;
+        case SerializationPlan::Kind::STRING:
+            node = value.cast<std::string>();
+            break;
+        case SerializationPlan::Kind::STRUCTURE:
+            assert(false);
+            break;
+    }
+}
+
+bool deserialize_scalar(const SerializationPlan::Property& property, const entt::meta_handle structure, const YAML::Node& node) {
+    switch (property.kind) {
+        case SerializationPlan::Kind::INT:
+            return property.data.set(structure, node.as<int32_t>(0));
+        case SerializationPlan::Kind::UINT:
+            return property.data.set(structure, node.as<uint32_t>(0));
+        case SerializationPlan::Kind::FLOAT:
+            return property.data.set(structure, node.as<float>(0.f));
+        case SerializationPlan::Kind::BOOL:
+            return property.data.set(structure, node.as<bool>(false));
+        case SerializationPlan::Kind::STRING:
+            return property.data.set(structure, node.as<std::string>(""));
+        case SerializationPlan::Kind::STRUCTURE:
+            assert(false);
+            return false;
+    }
+    return false;
+}
+
+void serialize_structure(const SerializationPlan& plan, const entt::meta_handle structure, YAML::Node& node) {
+    for (const SerializationPlan::Property& property : plan.get_properties()) {
+        if (property.kind == SerializationPlan::Kind::STRUCTURE) {
+            const entt::meta_any value = property.data.get(structure);
+            assert(value);
+
+            YAML::Node child_node(YAML::NodeType::Map);
+            serialize_structure(*property.plan, value, child_node);
+            node.force_insert(property.name, child_node);
+        } else {
+            YAML::Node child_node(YAML::NodeType::Scalar);
+            serialize_scalar(property, structure, child_node);
+            node.force_insert(property.name, child_node);
+        }
+    }
+}
+
+void deserialize_structure(const SerializationPlan& plan, const entt::meta_handle structure, const YAML::Node& node) {
+    for (YAML::const_iterator property_it = node.begin(); property_it != node.end(); ++property_it) {
+        const auto property_name = property_it->first.as<std::string>("");
+        assert(!property_name.empty());
+
+        const SerializationPlan::Property* property = plan.find_property(property_name);
+        if (property == nullptr) {
+            RESOURCE_WARNING << "Unknown or ignored property \"" << property_name << "\" is specified." << std::endl;
+            continue;
+        }
+
+        if (property->kind == SerializationPlan::Kind::STRUCTURE) {
+            if (!property_it->second.IsMap()) {
+                RESOURCE_WARNING << "Property \"" << property_name << "\" type mismatch." << std::endl;
+                continue;
+            }
+
+            entt::meta_any child_structure = property->plan->get_type().construct();
+            if (!child_structure) {
+                RESOURCE_WARNING << "Structure property's \"" << property_name << "\" is not default-constructible." << std::endl;
+                continue;
+            }
+
+            deserialize_structure(*property->plan, child_structure, property_it->second);
+
+            if (!property->data.set(structure, child_structure)) {
+                RESOURCE_WARNING << "Failed to set structure property's \"" << property_name << "\"  value." << std::endl;
+            }
+        } else {
+            if (!property_it->second.IsScalar() || !deserialize_scalar(*property, structure, property_it->second)) {
+                RESOURCE_WARNING << "Failed to deserialize property \"" << property_name << "\"." << std::endl;
+            }
+        }
+    }
+}
+
+void serialize_component(const entt::meta_handle component_handle, YAML::Node& node) {
+    assert(component_handle);
+
+    const SerializationPlan& component_plan = SerializationPlan::get(component_handle.type());
+
+    YAML::Node component_node(YAML::NodeType::Map);
+    serialize_structure(component_plan, component_handle, component_node);
+    node.force_insert(component_plan.get_name(), component_node);
+}
+
+/** Editable components of level entities grouped by entity. Components of entity `i` are in range
+    `[offsets[i], offsets[i + 1])`. Entities without serialized components have empty ranges. */
+struct LevelComponents final {
+    std::vector<uint32_t> offsets;
+    std::vector<entt::meta_handle> components;
+};
+
+/** Gather components of level entities, which are entities with `NameComponent`, iterating each editable component
+    pool once instead of probing every component type of every entity. Entities keep the order of `NameComponent` view
+    and their components keep the order of `ComponentManager::each_editable`, so the result is the same as if each
+    entity was serialized with `serialize_entity`. */
+LevelComponents gather_level_components(World& world, const bool serialize_editor_component) {
+    struct Entry final {
+        uint32_t entity_index;
+        entt::meta_handle component;
+    };
+
+    const uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> entity_indices(world.size(), NO_INDEX);
+
+    uint32_t num_entities = 0;
+    for (entt::entity entity : world.view<NameComponent>()) {
+        entity_indices[entt::to_integer(World::entity(entity))] = num_entities++;
+    }
+
+    std::vector<Entry> entries;
+    std::vector<uint32_t> offsets(size_t(num_entities) + 1, 0);
+
+    ComponentManager::each_editable([&](const entt::meta_type component_type) {
+        if (component_type != entt::resolve<NameComponent>() || serialize_editor_component) {
+            world.each_component(component_type, [&](const entt::entity entity, const entt::meta_handle component_handle) {
+                const uint32_t entity_index = entity_indices[entt::to_integer(World::entity(entity))];
+                if (entity_index != NO_INDEX) {
+                    entries.push_back(Entry { entity_index, component_handle });
+                    offsets[entity_index + 1]++;
+                }
+            });
+        }
+    });
+
+    for (size_t i = 1; i < offsets.size(); i++) {
+        offsets[i] += offsets[i - 1];
+    }
+
+    // Counting sort is stable, so components of each entity stay in the order their pools were visited.
+    LevelComponents result;
+    result.components.resize(entries.size());
+
+    std::vector<uint32_t> positions(offsets.begin(), offsets.end() - 1);
+    for (const Entry& entry : entries) {
+        result.components[positions[entry.entity_index]++] = entry.component;
+    }
+
+    result.offsets = std::move(offsets);
+    return result;
+}
+
+/** Level entities are deserialized on worker threads in chunks of this size. */
+static const size_t LEVEL_CHUNK_SIZE = 256;
+
+/** Return type of the specified component if it's an editable component, warn and return invalid type otherwise. */
+entt::meta_type get_component_type(const std::string& component_name, const YAML::Node& component_node) {
+    if (!component_node.IsMap()) {
+        RESOURCE_WARNING << "Corrupted component \"" << component_name << "\" is specified." << std::endl;
+        return entt::meta_type();
+    }
+
+    // Plans of editable components are looked up by name first, which is cheaper than resolving a meta type.
+    const SerializationPlan* component_plan = SerializationPlan::find(component_name);
+    const entt::meta_type component_type = component_plan != nullptr ? component_plan->get_type() : entt::resolve(entt::hashed_string(component_name.c_str()));
+    if (!component_type) {
+        RESOURCE_WARNING << "Unknown component \"" << component_name << "\" is specified." << std::endl;
+        return entt::meta_type();
+    }
+
+    if (!ComponentManager::is_registered(component_type)) {
+        RESOURCE_WARNING << "Component \"" << component_name << "\" is not registered." << std::endl;
+        return entt::meta_type();
+    }
+
+    if (!ComponentManager::is_editable(component_type)) {
+        RESOURCE_WARNING << "Component \"" << component_name << "\" is not editable." << std::endl;
+        return entt::meta_type();
+    }
+
+    return component_type;
+}
+
+/** Only reads the specified node and plans built on registration, so it may be called from any thread. */
+entt::meta_any deserialize_component(const entt::meta_type component_type, const YAML::Node& component_node) {
+    entt::meta_any component = ComponentManager::construct(component_type);
+    assert(component && "Failed to construct editable component.");
+
+    deserialize_structure(SerializationPlan::get(component_type), component, component_node);
+    return component;
+}
+
+void register_name(NameSingleComponent& name_single_component, const entt::entity entity, NameComponent& name_component) {
+    if (name_single_component.name_to_entity.count(name_component.name) > 0) {
+        RESOURCE_WARNING << "Entity with name \"" << name_component.name << "\" already exists." << std::endl;
+        name_component.name = name_single_component.acquire_unique_name(entity, name_component.name);
+    } else {
+        name_single_component.name_to_entity[name_component.name] = entity;
+    }
+}
+
+/** Components of the same type deserialized from a level chunk. `entity_indices` are relative to the chunk. */
+struct StagedComponents final {
+    entt::meta_type component_type;
+    std::vector<uint32_t> entity_indices;
+    std::vector<entt::meta_any> components;
+};
+
+struct LevelChunk final {
+    uint32_t num_entities = 0;
+    std::vector<StagedComponents> staged_components;
+};
+
+/** Deserialize the specified entities without touching the world, so chunks are deserialized in parallel. Alias nodes
+    may be shared between chunks, but they're only read. */
+LevelChunk deserialize_level_chunk(const std::vector<YAML::Node>& entity_nodes, const bool allow_editor_component) {
+    LevelChunk result;
+
+    std::unordered_map<entt::meta_type, size_t> staged_indices;
+    std::vector<entt::meta_type> entity_component_types;
+
+    for (const YAML::Node& entity_node : entity_nodes) {
+        if (!entity_node.IsMap()) {
+            RESOURCE_WARNING << "Corrupted entity is specified." << std::endl;
+            continue;
+        }
+
+        const uint32_t entity_index = result.num_entities++;
+        entity_component_types.clear();
+
+        for (YAML::const_iterator component_it = entity_node.begin(); component_it != entity_node.end(); ++component_it) {
+            const auto component_name = component_it->first.as<std::string>("");
+            assert(!component_name.empty());
+
+            const entt::meta_type component_type = get_component_type(component_name, component_it->second);
+            if (!component_type) {
+                continue;
+            }
+
+            if (component_type == entt::resolve<NameComponent>() && !allow_editor_component) {
+                continue;
+            }
+
+            if (std::find(entity_component_types.begin(), entity_component_types.end(), component_type) != entity_component_types.end()) {
+                RESOURCE_WARNING << "Component \"" << component_name << "\" is already assigned." << std::endl;
+                continue;
+            }
+            entity_component_types.push_back(component_type);
+
+            auto [staged_it, is_inserted] = staged_indices.emplace(component_type, result.staged_components.size());
+            if (is_inserted) {
+                result.staged_components.push_back(StagedComponents { component_type, {}, {} });
+            }
+
+            StagedComponents& staged_components = result.staged_components[staged_it->second];
+            staged_components.entity_indices.push_back(entity_index);
+            staged_components.components.push_back(deserialize_component(component_type, component_it->second));
+        }
+    }
+
+    return result;
+}
+
+/** Create entities of the specified chunk and assign them staged components one component type at a time. */
+void insert_level_chunk(World& world, LevelChunk& chunk, NameSingleComponent* const name_single_component, CookedLevelWriter* const cooked_level_writer) {
+    std::vector<entt::entity> entities(chunk.num_entities);
+    world.create(entities.begin(), entities.end());
+
+    const uint32_t first_entity_index = cooked_level_writer != nullptr ? cooked_level_writer->add_entities(chunk.num_entities) : 0;
+
+    for (StagedComponents& staged_components : chunk.staged_components) {
+        const entt::meta_type component_type = staged_components.component_type;
+        const bool is_editor_component = component_type == entt::resolve<NameComponent>();
+
+        world.reserve(component_type, world.size(component_type) + staged_components.components.size());
+
+        for (size_t i = 0; i < staged_components.components.size(); i++) {
+            const uint32_t entity_index = staged_components.entity_indices[i];
+            const entt::entity entity = entities[entity_index];
+
+            entt::meta_any& component = staged_components.components[i];
+            if (is_editor_component) {
+                assert(name_single_component != nullptr);
+                register_name(*name_single_component, entity, component.cast<NameComponent>());
+            }
+
+            const entt::meta_handle component_handle = world.assign_move_or_copy(entity, component);
+            if (cooked_level_writer != nullptr) {
+                cooked_level_writer->add_component(first_entity_index + entity_index, component_handle);
+            }
+        }
+    }
+}
+
+ghc::filesystem::path get_cooked_level_path(const std::string& level_name) {
+    return ghc::filesystem::path(ResourceUtils::get_resource_directory()) / "cache" / "levels" / (level_name + ".cooked");
+}
+
+/** `LevelEventHandler` builds YAML nodes of level entities from parser events one entity at a time. Everything
+    outside of the entities sequence is skipped without building any nodes. */
+class LevelEventHandler final : public YAML::EventHandler {
+public:
+    explicit LevelEventHandler(const std::function<void(const YAML::Node&)>& callback)
+            : m_callback(callback) {
+    }
+
+    /** Return true if the root node is a map and its "entities" node is a sequence. */
+    bool is_level() const {
+        return m_is_root_map && m_has_entities;
+    }
+
+    void OnDocumentStart(const YAML::Mark& /*mark*/) override {
+    }
+
+    void OnDocumentEnd() override {
+    }
+
+    void OnNull(const YAML::Mark& /*mark*/, const YAML::anchor_t anchor) override {
+        if (m_depth == 1) {
+            on_root_child(false, std::string());
+        }
+        on_node(YAML::Node(YAML::NodeType::Null), anchor);
+    }
+
+    void OnAlias(const YAML::Mark& /*mark*/, const YAML::anchor_t anchor) override {
+        if (m_depth == 1) {
+            on_root_child(false, std::string());
+        }
+        if (auto result = m_anchors.find(anchor); result != m_anchors.end()) {
+            on_node(result->second, YAML::NullAnchor);
+        } else {
+            on_node(YAML::Node(YAML::NodeType::Null), YAML::NullAnchor);
+        }
+    }
+
+    void OnScalar(const YAML::Mark& /*mark*/, const std::string& /*tag*/, const YAML::anchor_t anchor, const std::string& value) override {
+        if (m_depth == 1) {
+            on_root_child(false, value);
+        }
+        on_node(YAML::Node(value), anchor);
+    }
+
+    void OnSequenceStart(const YAML::Mark& /*mark*/, const std::string& /*tag*/, const YAML::anchor_t anchor, YAML::EmitterStyle::value /*style*/) override {
+        on_collection_start(YAML::NodeType::Sequence, anchor);
+    }
+
+    void OnSequenceEnd() override {
+        on_collection_end();
+    }
+
+    void OnMapStart(const YAML::Mark& /*mark*/, const std::string& /*tag*/, const YAML::anchor_t anchor, YAML::EmitterStyle::value /*style*/) override {
+        on_collection_start(YAML::NodeType::Map, anchor);
+    }
+
+    void OnMapEnd() override {
+        on_collection_end();
+    }
+
+private:
+    struct Collection final {
+        YAML::Node node;
+        YAML::Node key;
+        YAML::anchor_t anchor;
+        bool has_key;
+    };
+
+    /** Track keys of the root map, so the entities sequence is recognized. */
+    void on_root_child(const bool is_sequence, const std::string& value) {
+        if (m_is_root_map) {
+            if (m_is_root_key) {
+                m_root_key = value;
+            } else if (is_sequence && m_root_key == "entities") {
+                m_is_in_entities = true;
+                m_has_entities = true;
+            }
+            m_is_root_key = !m_is_root_key;
+        }
+    }
+
+    void on_collection_start(const YAML::NodeType::value type, const YAML::anchor_t anchor) {
+        if (m_depth == 0) {
+            m_is_root_map = type == YAML::NodeType::Map;
+        } else if (m_depth == 1) {
+            on_root_child(type == YAML::NodeType::Sequence, std::string());
+        } else if (m_is_in_entities) {
+            m_collections.push_back(Collection { YAML::Node(type), YAML::Node(), anchor, false });
+        }
+        m_depth++;
+    }
+
+    void on_collection_end() {
+        m_depth--;
+        if (m_is_in_entities) {
+            if (m_depth == 1) {
+                m_is_in_entities = false;
+            } else {
+                Collection collection = std::move(m_collections.back());
+                m_collections.pop_back();
+                on_node(collection.node, collection.anchor);
+            }
+        }
+    }
+
+    /** Attach the specified complete node to its parent. Complete entities are passed to the callback and discarded. */
+    void on_node(const YAML::Node& node, const YAML::anchor_t anchor) {
+        if (!m_is_in_entities || m_depth < 2) {
+            return;
+        }
+
+        if (anchor != YAML::NullAnchor) {
+            m_anchors.emplace(anchor, node);
+        }
+
+        if (m_collections.empty()) {
+            m_callback(node);
+        } else {
+            Collection& parent = m_collections.back();
+            if (parent.node.IsSequence()) {
+                parent.node.push_back(node);
+            } else if (!parent.has_key) {
+                // Assignment of YAML nodes modifies the referenced node, so the key is rebound instead.
+                parent.key.reset(node);
+                parent.has_key = true;
+            } else {
+                parent.node.force_insert(parent.key, node);
+                parent.has_key = false;
+            }
+        }
+    }
+
+    const std::function<void(const YAML::Node&)>& m_callback;
+    std::vector<Collection> m_collections;
+    std::unordered_map<YAML::anchor_t, YAML::Node> m_anchors;
+    std::string m_root_key;
+    size_t m_depth = 0;
+    bool m_is_root_map = false;
+    bool m_is_root_key = true;
+    bool m_is_in_entities = false;
+    bool m_has_entities = false;
+};
+
 } // namespace resource_utils_details
 
 bool ResourceUtils::is_registered_type(const entt::meta_type type) {
@@ -94,87 +573,24 @@ bool ResourceUtils::deserialize_registered_property(const entt::meta_data proper
 }
 
 void ResourceUtils::serialize_structure_property(const entt::meta_handle structure, YAML::Node& node) {
+    using namespace resource_utils_details;
+
     assert(structure);
     assert(node.IsMap());
+    assert(structure.type());
+    assert(structure.type().is_class());
 
-    const entt::meta_type structure_type = structure.type();
-    assert(structure_type);
-    assert(structure_type.is_class());
-
-    structure_type.data([&](const entt::meta_data property) {
-        assert(property);
-        const entt::meta_type property_type = property.type();
-        if (property_type) {
-            const entt::meta_prop ignore_property = property_type.prop("ignore"_hs);
-            if (!ignore_property || ignore_property.value().type() != entt::resolve<bool>() || !ignore_property.value().cast<bool>()) {
-                const entt::meta_prop name_property = property.prop("name"_hs);
-                if (name_property && name_property.value().type() == entt::resolve<const char*>()) {
-                    const std::string name = name_property.value().cast<const char*>();
-                    assert(!name.empty());
-
-                    if (is_registered_type(property_type)) {
-                        YAML::Node& child_node = node[name] = YAML::Node(YAML::NodeType::Scalar);
-                        serialize_registered_property(property, structure, child_node);
-                    } else if (property_type.is_class()) {
-                        entt::meta_any value = property.get(structure);
-                        assert(value);
-
-                        YAML::Node& child_node = node[name] = YAML::Node(YAML::NodeType::Map);
-                        serialize_structure_property(value, child_node);
-                    }
-                }
-            }
-        }
-    });
+    serialize_structure(SerializationPlan::get(structure.type()), structure, node);
 }
 
 void ResourceUtils::deserialize_structure_property(const entt::meta_handle structure, const YAML::Node& node) {
+    using namespace resource_utils_details;
+
     assert(structure);
     assert(node.IsMap());
+    assert(structure.type());
 
-    const entt::meta_type structure_type = structure.type();
-    assert(structure_type);
-
-    for (YAML::const_iterator property_it = node.begin(); property_it != node.end(); ++property_it) {
-        const auto property_name = property_it->first.as<std::string>("");
-        assert(!property_name.empty());
-
-        const entt::meta_data property = structure_type.data(entt::hashed_string(property_name.c_str()));
-        if (property) {
-            const entt::meta_prop ignore_property = property.prop("ignore"_hs);
-            if (!ignore_property || ignore_property.value().type() != entt::resolve<bool>() || !ignore_property.value().cast<bool>()) {
-                const entt::meta_type property_type = property.type();
-                if (property_type) {
-                    if (is_registered_type(property_type)) {
-                        if (!deserialize_registered_property(property, structure, property_it->second)) {
-                            RESOURCE_WARNING << "Failed to deserialize property \"" << property_name << "\"." << std::endl;
-                        }
-                    } else {
-                        if (property_type.is_class() && property_it->second.IsMap()) {
-                            entt::meta_any child_structure = property_type.construct();
-                            if (child_structure) {
-                                deserialize_structure_property(child_structure, property_it->second);
-
-                                if (!property.set(structure, child_structure)) {
-                                    RESOURCE_WARNING << "Failed to set structure property's \"" << property_name << "\"  value." << std::endl;
-                                }
-                            } else {
-                                RESOURCE_WARNING << "Structure property's \"" << property_name << "\" is not default-constructible." << std::endl;
-                            }
-                        } else {
-                            RESOURCE_WARNING << "Property \"" << property_name << "\" type mismatch." << std::endl;
-                        }
-                    }
-                } else {
-                    RESOURCE_WARNING << "Unknown property's \"" << property_name << "\" type." << std::endl;
-                }
-            } else {
-                RESOURCE_WARNING << "Ignored property \"" << property_name << "\" is specified." << std::endl;
-            }
-        } else {
-            RESOURCE_WARNING << "Unknown property \"" << property_name << "\" is specified." << std::endl;
-        }
-    }
+    deserialize_structure(SerializationPlan::get(structure.type()), structure, node);
 }
 
 void ResourceUtils::serialize_entity(World& world, const entt::entity entity, YAML::Node& node, const bool serialize_editor_component) {
@@ -183,11 +599,8 @@ void ResourceUtils::serialize_entity(World& world, const entt::entity entity, YA
 
     world.each_editable_component(entity, [&](const entt::meta_handle component_handle) {
         assert(component_handle);
-        const entt::meta_type component_type = component_handle.type();
-        if (component_type != entt::resolve<NameComponent>() || serialize_editor_component) {
-            const std::string component_name = ComponentManager::get_name(component_type);
-            YAML::Node& component_node = node[component_name] = YAML::Node(YAML::NodeType::Map);
-            serialize_structure_property(component_handle, component_node);
+        if (component_handle.type() != entt::resolve<NameComponent>() || serialize_editor_component) {
+            resource_utils_details::serialize_component(component_handle, node);
         }
     });
 }
@@ -200,74 +613,54 @@ void ResourceUtils::deserialize_entity(World& world, const entt::entity entity,
         const auto component_name = component_it->first.as<std::string>("");
         assert(!component_name.empty());
 
-        if (component_it->second.IsMap()) {
-            const entt::meta_type component_type = entt::resolve(entt::hashed_string(component_name.c_str()));
-            if (component_type) {
-                if (ComponentManager::is_registered(component_type)) {
-                    if (ComponentManager::is_editable(component_type)) {
-                        if (!world.has(entity, component_type)) {
-                            const bool is_editor_component = component_type == entt::resolve<NameComponent>();
-                            const bool allow_editor_component = name_single_component != nullptr;
-                            if (!allow_editor_component && is_editor_component) {
-                                continue;
-                            }
-
-                            entt::meta_any component = ComponentManager::construct(component_type);
-                            assert(component && "Failed to construct editable component.");
-
-                            deserialize_structure_property(component, component_it->second);
-
-                            if (is_editor_component) {
-                                auto& name_component = component.cast<NameComponent>();
-
-                                if (name_single_component->name_to_entity.count(name_component.name) > 0) {
-                                    RESOURCE_WARNING << "Entity with name \"" << name_component.name << "\" already exists." << std::endl;
-                                    name_component.name = name_single_component->acquire_unique_name(entity, name_component.name);
-                                } else {
-                                    name_single_component->name_to_entity[name_component.name] = entity;
-                                }
-                            }
-
-                            world.assign_move_or_copy(entity, component);
-                        } else {
-                            RESOURCE_WARNING << "Component \"" << component_name << "\" is already assigned." << std::endl;
-                        }
-                    } else {
-                        RESOURCE_WARNING << "Component \"" << component_name << "\" is not editable." << std::endl;
-                    }
-                } else {
-                    RESOURCE_WARNING << "Component \"" << component_name << "\" is not registered." << std::endl;
-                }
-            } else {
-                RESOURCE_WARNING << "Unknown component \"" << component_name << "\" is specified." << std::endl;
-            }
-        } else {
-            RESOURCE_WARNING << "Corrupted component \"" << component_name << "\" is specified." << std::endl;
+        const entt::meta_type component_type = resource_utils_details::get_component_type(component_name, component_it->second);
+        if (!component_type) {
+            continue;
+        }
+
+        if (world.has(entity, component_type)) {
+            RESOURCE_WARNING << "Component \"" << component_name << "\" is already assigned." << std::endl;
+            continue;
+        }
+
+        const bool is_editor_component = component_type == entt::resolve<NameComponent>();
+        const bool allow_editor_component = name_single_component != nullptr;
+        if (!allow_editor_component && is_editor_component) {
+            continue;
+        }
+
+        entt::meta_any component = resource_utils_details::deserialize_component(component_type, component_it->second);
+        if (is_editor_component) {
+            resource_utils_details::register_name(*name_single_component, entity, component.cast<NameComponent>());
         }
+
+        world.assign_move_or_copy(entity, component);
     }
 }
 
 void ResourceUtils::serialize_level(World& world, YAML::Node& node, const bool serialize_editor_component) {
+    using namespace resource_utils_details;
+
     assert(node.IsSequence());
 
-    entt::view<NameComponent> entities = world.view<NameComponent>();
-    for (entt::entity entity : entities) {
-        YAML::Node child_node(YAML::NodeType::Map);
-        serialize_entity(world, entity, child_node, serialize_editor_component);
-        if (child_node.size() != 0) {
+    const LevelComponents level_components = gather_level_components(world, serialize_editor_component);
+    for (size_t i = 0; i + 1 < level_components.offsets.size(); i++) {
+        if (level_components.offsets[i] != level_components.offsets[i + 1]) {
+            YAML::Node child_node(YAML::NodeType::Map);
+            for (uint32_t j = level_components.offsets[i]; j < level_components.offsets[i + 1]; j++) {
+                serialize_component(level_components.components[j], child_node);
+            }
             node.push_back(child_node);
         }
     }
 }
 
 bool ResourceUtils::serialize_level(World& world, const bool serialize_editor_component) {
+    using namespace resource_utils_details;
+
     auto& level_single_component = world.ctx<LevelSingleComponent>();
     assert(!level_single_component.level_name.empty());
 
-    YAML::Node root_node(YAML::NodeType::Map);
-    YAML::Node& entities_node = root_node["entities"] = YAML::Node(YAML::NodeType::Sequence);
-    serialize_level(world, entities_node, serialize_editor_component);
-
     const ghc::filesystem::path level_path = ghc::filesystem::path(get_resource_directory()) / "levels" / level_single_component.level_name;
 
     std::ofstream stream(level_path.string());
@@ -276,11 +669,43 @@ bool ResourceUtils::serialize_level(World& world, const bool serialize_editor_co
         return false;
     }
 
-    if (!(stream << root_node)) {
+    // Entities are emitted one at a time, so only one entity node is kept in memory. The output is the same as if
+    // the whole level node was written at once.
+    YAML::Emitter emitter(stream);
+    emitter << YAML::BeginMap << YAML::Key << "entities" << YAML::Value << YAML::BeginSeq;
+
+    const LevelComponents level_components = gather_level_components(world, serialize_editor_component);
+    for (size_t i = 0; i + 1 < level_components.offsets.size(); i++) {
+        if (level_components.offsets[i] != level_components.offsets[i + 1]) {
+            YAML::Node entity_node(YAML::NodeType::Map);
+            for (uint32_t j = level_components.offsets[i]; j < level_components.offsets[i + 1]; j++) {
+                serialize_component(level_components.components[j], entity_node);
+            }
+            emitter << entity_node;
+        }
+    }
+
+    emitter << YAML::EndSeq << YAML::EndMap;
+
+    stream.close();
+    if (!emitter.good() || stream.fail()) {
         RESOURCE_WARNING << "Failed to write to \"" << level_path.string() << "\"." << std::endl;
         return false;
     }
 
+    // The level is cooked straight from the world, so it's not parsed back on the next load.
+    std::error_code error_code;
+    const uint64_t source_size = ghc::filesystem::file_size(level_path, error_code);
+    const int64_t source_time = ghc::filesystem::last_write_time(level_path, error_code).time_since_epoch().count();
+
+    CookedLevelWriter cooked_level_writer;
+    cooked_level_writer.add_level(world, serialize_editor_component);
+
+    const ghc::filesystem::path cooked_level_path = get_cooked_level_path(level_single_component.level_name);
+    if (!write_file(cooked_level_path, cooked_level_writer.finish(source_size, source_time))) {
+        LockedOutput(std::cout) << "[RESOURCE] Failed to write cooked level \"" << cooked_level_path.string() << "\"." << std::endl;
+    }
+
     return true;
 }
 
@@ -298,6 +723,8 @@ void ResourceUtils::deserialize_level(World& world, const YAML::Node& node, Name
 }
 
 bool ResourceUtils::deserialize_level(World& world) {
+    using namespace resource_utils_details;
+
     auto& level_single_component = world.ctx<LevelSingleComponent>();
     auto& name_single_component = world.set<NameSingleComponent>();
 
@@ -307,29 +734,110 @@ bool ResourceUtils::deserialize_level(World& world) {
         return false;
     }
 
+    std::error_code error_code;
+    const uint64_t source_size = ghc::filesystem::file_size(level_path, error_code);
+    const int64_t source_time = ghc::filesystem::last_write_time(level_path, error_code).time_since_epoch().count();
+
+    // YAML level is the source format, it's cooked into a binary level which is loaded without parsing next time.
+    const ghc::filesystem::path cooked_level_path = get_cooked_level_path(level_single_component.level_name);
+
+    MemoryMappedFile cooked_level;
+    if (cooked_level.open(cooked_level_path.string()) &&
+        is_cooked_level_up_to_date(cooked_level.get_data(), cooked_level.get_size(), source_size, source_time)) {
+        if (load_cooked_level(world, cooked_level.get_data(), cooked_level.get_size(), &name_single_component)) {
+            return true;
+        }
+        LockedOutput(std::cout) << "[RESOURCE] Cooked level \"" << cooked_level_path.string() << "\" is corrupted." << std::endl;
+    }
+    cooked_level.close();
+
     std::ifstream stream(level_path.string());
     if (!stream.is_open()) {
         RESOURCE_WARNING << "Failed to open \"" << level_path.string() << "\"." << std::endl;
         return false;
     }
 
-    const YAML::Node node = YAML::Load(stream);
-    if (!node.IsMap()) {
-        RESOURCE_WARNING << "The root node of the level must be a map." << std::endl;
+    CookedLevelWriter cooked_level_writer;
+    if (!deserialize_level(world, stream, &name_single_component, &cooked_level_writer)) {
+        RESOURCE_WARNING << "The root node of the level must be a map with \"entities\" sequence." << std::endl;
         return false;
     }
 
-    const YAML::Node entities = node["entities"];
-    if (!entities.IsSequence()) {
-        RESOURCE_WARNING << "The entities node must be a sequence." << std::endl;
-        return false;
+    if (!write_file(cooked_level_path, cooked_level_writer.finish(source_size, source_time))) {
+        LockedOutput(std::cout) << "[RESOURCE] Failed to write cooked level \"" << cooked_level_path.string() << "\"." << std::endl;
     }
 
-    deserialize_level(world, entities, &name_single_component);
-
     return true;
 }
 
+bool ResourceUtils::deserialize_level(World& world, std::istream& stream, NameSingleComponent* const name_single_component,
+                                      CookedLevelWriter* const cooked_level_writer, const std::function<void()>& on_first_entity) {
+    using namespace resource_utils_details;
+
+    // Chunks are inserted in order. Waiting for the oldest one before dispatching another one keeps at most one chunk
+    // per thread in memory. Threads are created once for the whole level rather than once per chunk.
+    const size_t max_pending_chunks = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t(1));
+    const bool allow_editor_component = name_single_component != nullptr;
+
+    WorkerPool worker_pool(max_pending_chunks);
+
+    std::deque<std::future<LevelChunk>> pending_chunks;
+    std::vector<YAML::Node> entity_nodes;
+    bool has_entities = false;
+
+    auto insert_oldest_chunk = [&]() {
+        LevelChunk chunk = pending_chunks.front().get();
+        pending_chunks.pop_front();
+
+        insert_level_chunk(world, chunk, name_single_component, cooked_level_writer);
+    };
+
+    auto dispatch_chunk = [&]() {
+        if (pending_chunks.size() == max_pending_chunks) {
+            insert_oldest_chunk();
+        }
+
+        pending_chunks.push_back(worker_pool.push([chunk_nodes = std::move(entity_nodes), allow_editor_component]() {
+            return deserialize_level_chunk(chunk_nodes, allow_editor_component);
+        }));
+        entity_nodes.clear();
+    };
+
+    const bool is_level = parse_level(stream, [&](const YAML::Node& entity_node) {
+        if (!has_entities) {
+            if (on_first_entity) {
+                on_first_entity();
+            }
+            has_entities = true;
+        }
+
+        entity_nodes.push_back(entity_node);
+        if (entity_nodes.size() == LEVEL_CHUNK_SIZE) {
+            dispatch_chunk();
+        }
+    });
+
+    if (!entity_nodes.empty()) {
+        dispatch_chunk();
+    }
+
+    while (!pending_chunks.empty()) {
+        insert_oldest_chunk();
+    }
+
+    return is_level;
+}
+
+bool ResourceUtils::parse_level(std::istream& stream, const std::function<void(const YAML::Node&)>& callback) {
+    using namespace resource_utils_details;
+
+    YAML::Parser parser(stream);
+    LevelEventHandler event_handler(callback);
+    parser.HandleNextDocument(event_handler);
+
+    return event_handler.is_level();
+}
+
 std::string ResourceUtils::get_resource_directory() {
     char* const base_path = SDL_GetBasePath();
     if (base_path == nullptr) {
@@ -1,6 +1,7 @@
 #include "core/ecs/system_descriptor.h"
 #include "core/ecs/world.h"
 #include "world/render/render_tags.h"
+#include "world/shared/frame_pacing_single_component.h"
 #include "world/shared/normal_input_single_component.h"
 #include "world/shared/window_single_component.h"
 #include "world/shared/window_system.h"
@@ -63,6 +64,7 @@ void WindowSystem::update(float /*elapsed_time*/) {
         SDL_SetWindowSize(window_single_component.window, window_single_component.width, window_single_component.height);
     }
 
+    auto& frame_pacing_single_component = world.ctx<FramePacingSingleComponent>();
     auto& normal_input_single_component = world.ctx<NormalInputSingleComponent>();
 
     std::copy(std::begin(normal_input_single_component.m_mouse_buttons), std::end(normal_input_single_component.m_mouse_buttons), std::begin(normal_input_single_component.m_previous_mouse_buttons));
@@ -75,6 +77,8 @@ void WindowSystem::update(float /*elapsed_time*/) {
 
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
+        frame_pacing_single_component.wake_up();
+
         switch (event.type) {
             case SDL_QUIT:
                 world.unset<RunningWorldSingleComponent>();
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "core/resource/resource_loader.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hg {
+
+class ResourceSystem;
+
+/** `ResourceLoadingSingleComponent` controls how `ResourceSystem` publishes resources loaded in background threads.
+    May be set up before `ResourceSystem` is created and changed at any time later. */
+class ResourceLoadingSingleComponent final {
+public:
+    /** Return number of resources that are requested, but not published yet. */
+    size_t get_num_pending_loads() const;
+
+    /** Push a job to the loader of `ResourceSystem`, so other systems load their resources on the same persistent
+        threads. Its upload stage is executed by `ResourceSystem` within `upload_budget`. Must be called only while
+        `ResourceSystem` exists. */
+    void push(ResourceLoader::Job&& job);
+
+    /** Megabytes of resource data passed to bgfx per frame. At least one resource is published per frame, so resources
+        larger than the budget are published alone. */
+    uint32_t upload_budget = 32;
+
+private:
+    size_t m_num_pending_loads = 0;
+    ResourceLoader* m_loader = nullptr;
+
+    friend class ResourceSystem;
+};
+
+} // namespace hg
@@ -2,10 +2,14 @@
 
 #include "core/ecs/system.h"
 #include "core/resource/model.h"
+#include "core/resource/texture.h"
 
 #include <entt/entity/observer.hpp>
+#include <memory>
 #include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace tinygltf {
 
@@ -23,7 +27,12 @@ class meta_any;
 
 namespace hg {
 
-/** `ResourceSystem` loads all the resources asynchronously. */
+class ResourceLoader;
+
+/** `ResourceSystem` loads resources in background threads using `ResourceLoader` and publishes them at the beginning of
+    a frame within the upload budget of `ResourceLoadingSingleComponent`. Models and material textures referenced by
+    the level are requested on construction, the ones referenced by components created later are requested on demand.
+    Until a resource is loaded, components use the blockout model and the default texture. */
 class ResourceSystem final : public NormalSystem {
 public:
     explicit ResourceSystem(World& world);
@@ -31,22 +40,40 @@ public:
     void update(float elapsed_time) override;
 
 private:
-    void load_textures() const;
-    Texture load_texture(const std::string &path) const;
+    void load_textures();
+    void load_texture(const std::string& texture_name, const std::string& path, bool is_streaming_enabled);
+    void load_materials(const std::vector<std::string>& materials);
+    void load_texture_arrays(std::vector<std::pair<std::string, std::string>>&& files);
+    Texture* publish_texture(const std::string& texture_name, Texture&& texture);
+    void unload_textures() const;
 
-    void load_models() const;
-    void load_model(Model& result, const std::string &path) const;
+    void load_models(const std::vector<std::string>& models);
+    void unload_models() const;
+    void import_model(Model& result, const std::vector<uint8_t>& data, const std::string &path) const;
     void load_model_node(const glm::mat4& parent_transform, Model::Node& result, Model::AABB& bounds, const tinygltf::Model &model, const tinygltf::Node &node) const;
     void load_model_mesh(const glm::mat4& parent_transform, Model::Mesh& result, Model::AABB& bounds, const tinygltf::Model &model, const tinygltf::Node &node) const;
     void load_model_primitive(const glm::mat4& parent_transform, Model::Primitive& result, Model::AABB& bounds, const tinygltf::Model &model, const tinygltf::Primitive& primitive) const;
 
-    void load_presets() const;
-    void load_preset(std::vector<entt::meta_any>& result, const std::string &path) const;
+    void load_presets();
+    void load_preset(std::vector<entt::meta_any>& result, const std::string& contents, const std::string &path) const;
 
     entt::observer m_model_observer;
     entt::observer m_model_update_observer;
     entt::observer m_material_observer;
     entt::observer m_material_update_observer;
+
+    std::unique_ptr<ResourceLoader> m_loader;
+
+    /** Names of models and materials that were requested, whether they were found or not. */
+    std::unordered_set<std::string> m_requested_models;
+    std::unordered_set<std::string> m_requested_materials;
+
+    /** Names of models that are being loaded. */
+    std::unordered_set<std::string> m_pending_models;
+
+    /** Names of models and materials published by the loader this frame, including the ones that failed to load. */
+    std::unordered_set<std::string> m_published_models;
+    std::unordered_set<std::string> m_published_materials;
 };
 
 } // namespace hg
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <entt/fwd.hpp>
+#include <functional>
+#include <iosfwd>
+#include <string>
 
 namespace YAML {
 
@@ -16,6 +19,7 @@ struct meta_handle;
 
 namespace hg {
 
+class CookedLevelWriter;
 class World;
 struct NameSingleComponent;
 
@@ -57,6 +61,19 @@ public:
     /** Deserialize world from the file specified in `LevelSingleComponent`. */
     static bool deserialize_level(World& world);
 
+    /** Deserialize world from the specified YAML stream. The calling thread parses entities and splits them into
+        chunks, worker threads deserialize the chunks into per component type staging vectors and the calling thread
+        inserts staged components into the world in bulk, in the order entities are listed. `on_first_entity` is called
+        right before the first entity is created. Inserted components are added to `cooked_level_writer` when it's
+        specified. Return false if the root node is not a map or it doesn't have "entities" sequence. */
+    static bool deserialize_level(World& world, std::istream& stream, NameSingleComponent* name_single_component = nullptr,
+                                  CookedLevelWriter* cooked_level_writer = nullptr, const std::function<void()>& on_first_entity = nullptr);
+
+    /** Parse the level from the specified YAML stream one entity at a time. `callback` is called with every node of
+        the entities sequence, which is discarded right after, so the whole level is never kept in memory. Return false
+        if the root node is not a map or it doesn't have "entities" sequence. */
+    static bool parse_level(std::istream& stream, const std::function<void(const YAML::Node&)>& callback);
+
     /** Return resource directory path. */
     static std::string get_resource_directory();
 };
@@ -17,17 +17,24 @@
 #include "world/physics/physics_shape_system.h"
 #include "world/physics/physics_simulate_system.h"
 #include "world/render/aa_pass_system.h"
+#include "world/render/aabb_tree_system.h"
 #include "world/render/camera_system.h"
 #include "world/render/debug_draw_pass_system.h"
+#include "world/render/dynamic_resolution_system.h"
 #include "world/render/geometry_pass_system.h"
 #include "world/render/hdr_pass_system.h"
 #include "world/render/lighting_pass_system.h"
+#include "world/render/occlusion_culling_system.h"
 #include "world/render/outline_pass_system.h"
 #include "world/render/picking_pass_system.h"
 #include "world/render/quad_system.h"
 #include "world/render/render_fetch_system.h"
+#include "world/render/render_statistics_system.h"
 #include "world/render/render_system.h"
 #include "world/render/skybox_pass_system.h"
+#include "world/render/static_geometry_system.h"
+#include "world/render/texture_streaming_system.h"
+#include "world/shared/frame_pacing_system.h"
 #include "world/shared/resource_system.h"
 #include "world/shared/window_system.h"
 
@@ -36,9 +43,11 @@
 namespace hg {
 
 void register_systems() {
+    REGISTER_SYSTEM(AABBTreeSystem);
     REGISTER_SYSTEM(AAPassSystem);
     REGISTER_SYSTEM(CameraSystem);
     REGISTER_SYSTEM(DebugDrawPassSystem);
+    REGISTER_SYSTEM(DynamicResolutionSystem);
     REGISTER_SYSTEM(EditorCameraSystem);
     REGISTER_SYSTEM(EditorFileSystem);
     REGISTER_SYSTEM(EditorGizmoSystem);
@@ -48,11 +57,13 @@ void register_systems() {
     REGISTER_SYSTEM(EditorPresetSystem);
     REGISTER_SYSTEM(EditorPropertyEditorSystem);
     REGISTER_SYSTEM(EditorSelectionSystem);
+    REGISTER_SYSTEM(FramePacingSystem);
     REGISTER_SYSTEM(GeometryPassSystem);
     REGISTER_SYSTEM(HDRPassSystem);
     REGISTER_SYSTEM(ImguiFetchSystem);
     REGISTER_SYSTEM(ImguiPassSystem);
     REGISTER_SYSTEM(LightingPassSystem);
+    REGISTER_SYSTEM(OcclusionCullingSystem);
     REGISTER_SYSTEM(OutlinePassSystem);
     REGISTER_SYSTEM(PhysicsCharacterControllerSystem);
     REGISTER_SYSTEM(PhysicsFetchSystem);
@@ -63,9 +74,12 @@ void register_systems() {
     REGISTER_SYSTEM(PickingPassSystem);
     REGISTER_SYSTEM(QuadSystem);
     REGISTER_SYSTEM(RenderFetchSystem);
+    REGISTER_SYSTEM(RenderStatisticsSystem);
     REGISTER_SYSTEM(RenderSystem);
     REGISTER_SYSTEM(ResourceSystem);
     REGISTER_SYSTEM(SkyboxPassSystem);
+    REGISTER_SYSTEM(StaticGeometrySystem);
+    REGISTER_SYSTEM(TextureStreamingSystem);
     REGISTER_SYSTEM(WindowSystem);
 
     SystemManager::commit();